@@ -336,6 +336,16 @@ void RenderInterface_GL2::ReleaseTexture(Rml::TextureHandle texture_handle)
 	glDeleteTextures(1, (GLuint*)&texture_handle);
 }
 
+bool RenderInterface_GL2::UpdateTexture(Rml::TextureHandle texture_handle, Rml::Span<const Rml::byte> source, Rml::Rectanglei region)
+{
+	RMLUI_ASSERT(source.data() && source.size() == size_t(region.Width() * region.Height() * 4));
+
+	glBindTexture(GL_TEXTURE_2D, (GLuint)texture_handle);
+	glTexSubImage2D(GL_TEXTURE_2D, 0, region.Left(), region.Top(), region.Width(), region.Height(), GL_RGBA, GL_UNSIGNED_BYTE, source.data());
+
+	return true;
+}
+
 void RenderInterface_GL2::SetTransform(const Rml::Matrix4f* transform)
 {
 	transform_enabled = (transform != nullptr);
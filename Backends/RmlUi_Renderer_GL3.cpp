@@ -206,6 +206,24 @@ void main() {
 }
 )";
 
+// Renders text from signed distance fields, the glyph outline is located at the '_edge' value of the texture alpha.
+static const char* shader_frag_sdf_text = RMLUI_SHADER_HEADER R"(
+uniform sampler2D _tex;
+uniform float _edge;
+uniform float _softness;
+
+in vec2 fragTexCoord;
+in vec4 fragColor;
+out vec4 finalColor;
+
+void main() {
+	float distance = texture(_tex, fragTexCoord).a;
+	float width = max(_softness, fwidth(distance));
+	float alpha = clamp((distance - _edge) / width + 0.5, 0.0, 1.0);
+	finalColor = fragColor * alpha;
+}
+)";
+
 static const char* shader_vert_passthrough = RMLUI_SHADER_HEADER R"(
 in vec2 inPosition;
 in vec2 inTexCoord0;
@@ -316,6 +334,7 @@ enum class ProgramId {
 	Texture,
 	Gradient,
 	Creation,
+	SdfText,
 	Passthrough,
 	ColorMatrix,
 	BlendMask,
@@ -334,6 +353,7 @@ enum class FragShaderId {
 	Texture,
 	Gradient,
 	Creation,
+	SdfText,
 	Passthrough,
 	ColorMatrix,
 	BlendMask,
@@ -360,6 +380,8 @@ enum class UniformId {
 	NumStops,
 	Value,
 	Dimensions,
+	Edge,
+	Softness,
 	Count,
 };
 
@@ -367,7 +389,7 @@ namespace Gfx {
 
 static const char* const program_uniform_names[(size_t)UniformId::Count] = {"_translate", "_transform", "_tex", "_color", "_color_matrix",
 	"_texelOffset", "_texCoordMin", "_texCoordMax", "_texMask", "_weights[0]", "_func", "_p", "_v", "_stop_colors[0]", "_stop_positions[0]",
-	"_num_stops", "_value", "_dimensions"};
+	"_num_stops", "_value", "_dimensions", "_edge", "_softness"};
 
 enum class VertexAttribute { Position, Color0, TexCoord0, Count };
 static const char* const vertex_attribute_names[(size_t)VertexAttribute::Count] = {"inPosition", "inColor0", "inTexCoord0"};
@@ -400,6 +422,7 @@ static const FragShaderDefinition frag_shader_definitions[] = {
 	{FragShaderId::Texture,     "texture",      shader_frag_texture},
 	{FragShaderId::Gradient,    "gradient",     shader_frag_gradient},
 	{FragShaderId::Creation,    "creation",     shader_frag_creation},
+	{FragShaderId::SdfText,     "sdf_text",     shader_frag_sdf_text},
 	{FragShaderId::Passthrough, "passthrough",  shader_frag_passthrough},
 	{FragShaderId::ColorMatrix, "color_matrix", shader_frag_color_matrix},
 	{FragShaderId::BlendMask,   "blend_mask",   shader_frag_blend_mask},
@@ -411,6 +434,7 @@ static const ProgramDefinition program_definitions[] = {
 	{ProgramId::Texture,     "texture",      VertShaderId::Main,        FragShaderId::Texture},
 	{ProgramId::Gradient,    "gradient",     VertShaderId::Main,        FragShaderId::Gradient},
 	{ProgramId::Creation,    "creation",     VertShaderId::Main,        FragShaderId::Creation},
+	{ProgramId::SdfText,     "sdf_text",     VertShaderId::Main,        FragShaderId::SdfText},
 	{ProgramId::Passthrough, "passthrough",  VertShaderId::Passthrough, FragShaderId::Passthrough},
 	{ProgramId::ColorMatrix, "color_matrix", VertShaderId::Passthrough, FragShaderId::ColorMatrix},
 	{ProgramId::BlendMask,   "blend_mask",   VertShaderId::Passthrough, FragShaderId::BlendMask},
@@ -1493,6 +1517,17 @@ void RenderInterface_GL3::ReleaseTexture(Rml::TextureHandle texture_handle)
 	glDeleteTextures(1, (GLuint*)&texture_handle);
 }
 
+bool RenderInterface_GL3::UpdateTexture(Rml::TextureHandle texture_handle, Rml::Span<const Rml::byte> source_data, Rml::Rectanglei region)
+{
+	RMLUI_ASSERT(source_data.data() && source_data.size() == size_t(region.Width() * region.Height() * 4));
+
+	glBindTexture(GL_TEXTURE_2D, (GLuint)texture_handle);
+	glTexSubImage2D(GL_TEXTURE_2D, 0, region.Left(), region.Top(), region.Width(), region.Height(), GL_RGBA, GL_UNSIGNED_BYTE, source_data.data());
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	return true;
+}
+
 void RenderInterface_GL3::SetTransform(const Rml::Matrix4f* new_transform)
 {
 	transform = (new_transform ? (projection * (*new_transform)) : projection);
@@ -1634,7 +1669,7 @@ void RenderInterface_GL3::ReleaseFilter(Rml::CompiledFilterHandle filter)
 	delete reinterpret_cast<CompiledFilter*>(filter);
 }
 
-enum class CompiledShaderType { Invalid = 0, Gradient, Creation };
+enum class CompiledShaderType { Invalid = 0, Gradient, Creation, SdfText };
 struct CompiledShader {
 	CompiledShaderType type;
 
@@ -1647,6 +1682,10 @@ struct CompiledShader {
 
 	// Shader
 	Rml::Vector2f dimensions;
+
+	// Distance field text
+	float edge;
+	float softness;
 };
 
 Rml::CompiledShaderHandle RenderInterface_GL3::CompileShader(const Rml::String& name, const Rml::Dictionary& parameters)
@@ -1707,6 +1746,12 @@ Rml::CompiledShaderHandle RenderInterface_GL3::CompileShader(const Rml::String&
 			shader.dimensions = Rml::Get(parameters, "dimensions", Rml::Vector2f(0.f));
 		}
 	}
+	else if (name == "sdf-text")
+	{
+		shader.type = CompiledShaderType::SdfText;
+		shader.edge = Rml::Get(parameters, "edge", 0.5f);
+		shader.softness = Rml::Get(parameters, "softness", 0.f);
+	}
 
 	if (shader.type != CompiledShaderType::Invalid)
 		return reinterpret_cast<Rml::CompiledShaderHandle>(new CompiledShader(std::move(shader)));
@@ -1716,7 +1761,7 @@ Rml::CompiledShaderHandle RenderInterface_GL3::CompileShader(const Rml::String&
 }
 
 void RenderInterface_GL3::RenderShader(Rml::CompiledShaderHandle shader_handle, Rml::CompiledGeometryHandle geometry_handle,
-	Rml::Vector2f translation, Rml::TextureHandle /*texture*/)
+	Rml::Vector2f translation, Rml::TextureHandle texture)
 {
 	RMLUI_ASSERT(shader_handle && geometry_handle);
 	const CompiledShader& shader = *reinterpret_cast<CompiledShader*>(shader_handle);
@@ -1758,6 +1803,20 @@ void RenderInterface_GL3::RenderShader(Rml::CompiledShaderHandle shader_handle,
 		glBindVertexArray(0);
 	}
 	break;
+	case CompiledShaderType::SdfText:
+	{
+		UseProgram(ProgramId::SdfText);
+		glUniform1f(GetUniformLocation(UniformId::Edge), shader.edge);
+		glUniform1f(GetUniformLocation(UniformId::Softness), shader.softness);
+		glBindTexture(GL_TEXTURE_2D, (GLuint)texture);
+
+		SubmitTransformUniform(translation);
+		glBindVertexArray(geometry.vao);
+		glDrawElements(GL_TRIANGLES, geometry.draw_count, GL_UNSIGNED_INT, (const GLvoid*)0);
+		glBindVertexArray(0);
+		glBindTexture(GL_TEXTURE_2D, 0);
+	}
+	break;
 	case CompiledShaderType::Invalid:
 	{
 		Rml::Log::Message(Rml::Log::LT_WARNING, "Unhandled render shader %d.", (int)type);
@@ -58,6 +58,15 @@ public:
 
 	operator Texture() const;
 
+	/// Releases the generated texture, so that it is generated again from its callback the next time it is used.
+	/// @note Existing references to this texture remain valid, and will render the regenerated texture.
+	void Regenerate();
+	/// Updates a region of the generated texture, or regenerates the texture if partial updates are not supported by the render interface.
+	/// @param[in] source Texture data of the region in 8-bit RGBA (premultiplied) format, with tightly packed rows.
+	/// @param[in] region The region of the texture to update.
+	/// @note The callback must generate the updated contents if the texture is generated again later.
+	void Update(Span<const byte> source, Rectanglei region);
+
 	void Release();
 
 private:
@@ -108,6 +117,13 @@ public:
 
 	Texture GetTexture(RenderManager& render_manager) const;
 
+	/// Releases all textures generated from the callback, so that they are generated again the next time they are used.
+	/// @note Existing references to the textures remain valid, and will render the regenerated textures.
+	void Regenerate();
+	/// Updates a region of all textures generated from the callback.
+	/// @see CallbackTexture::Update
+	void Update(Span<const byte> source, Rectanglei region);
+
 private:
 	CallbackTextureFunction callback;
 	mutable SmallUnorderedMap<RenderManager*, CallbackTexture> textures;
@@ -121,6 +121,26 @@ public:
 	/// @param[in] enable True to enable mouse cursor handling, false to disable.
 	void EnableMouseCursor(bool enable);
 
+	/// Enable or disable retained rendering for this context.
+	/// When enabled, the render commands of each stacking context are recorded, and replayed on subsequent frames until any element
+	/// within it changes. This avoids traversing and re-evaluating unchanged elements during rendering.
+	/// @param[in] enable True to enable retained rendering, false to render all elements from scratch every frame.
+	/// @note Custom elements whose output in OnRender() changes on its own must call Element::DirtyRender() when that happens.
+	void EnableRetainedRendering(bool enable);
+	/// Returns true if retained rendering is enabled for this context.
+	bool IsRetainedRenderingEnabled() const;
+
+	/// Enable or disable parallel style resolution for this context.
+	/// When enabled, the elements whose style definitions need to be updated are matched against their style sheet ahead of the update, with
+	/// the work distributed using SystemInterface::ExecuteParallel(). This is only beneficial when the system interface runs the tasks
+	/// concurrently, and when large parts of the documents need to be restyled at once.
+	/// @param[in] enable True to enable parallel style resolution, false to match each element during its update.
+	/// @note Only selector matching runs in parallel. Looking up the definitions and computing the property values of the elements still
+	/// happens serially during the update.
+	void EnableParallelStyleResolution(bool enable);
+	/// Returns true if parallel style resolution is enabled for this context.
+	bool IsParallelStyleResolutionEnabled() const;
+
 	/// Activate or deactivate a media theme. Themes can be used in RCSS media queries.
 	/// @param theme_name[in] The name of the theme to (de)activate.
 	/// @param activate True to activate the given theme, false to deactivate.
@@ -349,6 +369,10 @@ private:
 
 	// Enables cursor handling.
 	bool enable_cursor;
+	// Enables recording and replaying of render commands.
+	bool enable_retained_rendering = false;
+	// Enables matching of element definitions ahead of the update, distributed over the system interface's parallel tasks.
+	bool enable_parallel_style_resolution = false;
 	String cursor_name;
 	// Document attached to cursor (e.g. while dragging).
 	ElementPtr cursor_proxy;
@@ -182,6 +182,39 @@ RMLUICORE_API void ReleaseCompiledGeometry(RenderInterface* render_interface = n
 /// Releases unused font textures and rendered glyphs to free up memory, and regenerates actively used fonts.
 /// @note Invalidates all existing FontFaceHandles returned from the font engine.
 RMLUICORE_API void ReleaseFontResources();
+/// Enables or disables rendering text from signed distance fields in the default font engine.
+/// @note When enabled, the glyphs of each font face are rendered once, and shared by all font sizes. This requires the render interface to
+/// support the 'sdf-text' shader, which receives the parameters 'edge' and 'softness' as floats. The shader should render the vertex color
+/// multiplied by the coverage derived from the texture's alpha channel, which encodes the distance to the glyph outline. The outline is located
+/// at the 'edge' value, and the coverage should fade out over the 'softness' value centered on it, at least covering one pixel.
+/// @note Falls back to rendering bitmap glyphs when the default render interface, or the render interface of any context, can not compile the
+/// 'sdf-text' shader. The shader is internal to the text elements and the text decorator, meshes generated directly through the font engine
+/// interface can not be rendered in this mode.
+/// @note Also releases font resources, which invalidates all existing FontFaceHandles returned from the font engine.
+RMLUICORE_API void SetDistanceFieldTextRendering(bool enable);
+/// Enables or disables generating glyphs in parallel in the default font engine, which rasterizes glyphs and applies font effects to them in
+/// parallel tasks distributed with SystemInterface::ExecuteParallel. Disabled by default.
+/// @note When enabled, FontEffect::GenerateGlyphTexture may be called concurrently on the same font effect, and must thus be thread-safe.
+RMLUICORE_API void SetParallelGlyphGeneration(bool enable);
+/// Loads font glyphs baked ahead of time into the default font engine, which are then used instead of rasterizing the glyphs and generating
+/// their font effects. The font faces of the baked glyphs must still be loaded, glyphs missing from the baked data are generated as usual.
+/// @param[in] file_path The path to the baked glyphs, as produced by BakeFontGlyphs.
+/// @return True if the baked glyphs were loaded successfully, false otherwise.
+/// @note Also releases font resources, which invalidates all existing FontFaceHandles returned from the font engine.
+RMLUICORE_API bool LoadBakedFontGlyphs(const String& file_path);
+/// Loads baked font glyphs from memory into the default font engine, the data is copied.
+/// @param[in] data The baked glyphs, as produced by BakeFontGlyphs.
+/// @return True if the baked glyphs were loaded successfully, false otherwise.
+/// @note Also releases font resources, which invalidates all existing FontFaceHandles returned from the font engine.
+RMLUICORE_API bool LoadBakedFontGlyphs(Span<const byte> data);
+/// Releases all baked font glyphs loaded into the default font engine.
+/// @note Also releases font resources, which invalidates all existing FontFaceHandles returned from the font engine.
+RMLUICORE_API void ReleaseBakedFontGlyphs();
+/// Bakes the glyphs and font effect textures of all font sizes currently in use by the default font engine, to be loaded with
+/// LoadBakedFontGlyphs on a later run. Glyphs rendered from signed distance fields are not baked.
+/// @param[out] out_data The baked glyphs, appended to any existing data.
+/// @return True if the glyphs were baked, false if the default font engine is not in use.
+RMLUICORE_API bool BakeFontGlyphs(Vector<byte>& out_data);
 /// Releases render managers that are not used by any contexts.
 /// @note Any resources referring to the render manager in user space must be cleared first, including callback textures and compiled geometry.
 /// @note Also releases font resources, which invalidates all existing FontFaceHandles returned from the font engine.
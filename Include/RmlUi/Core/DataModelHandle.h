@@ -48,6 +48,25 @@ public:
 	void DirtyVariable(const String& variable_name);
 	void DirtyAllVariables();
 
+	// Dirty only part of a variable, so that just the views depending on the given address are updated.
+	// Eg. 'DirtyVariable("players", 317, "score")' updates views of 'players[317].score', and views of the whole 'players'.
+	void DirtyVariable(const DataAddress& address);
+	template <typename... Path>
+	void DirtyVariable(const String& variable_name, Path&&... path)
+	{
+		DirtyVariable(DataAddress{DataAddressEntry(variable_name), DataAddressEntry(std::forward<Path>(path))...});
+	}
+
+	// Enable automatic change detection, as an alternative to dirtying variables manually. During updates, the values used
+	// by data views are compared against snapshots of their previous values, and any changed addresses are dirtied. Scalars
+	// are compared by value and arrays by their size. At most 'max_checks_per_update' values are compared during each
+	// update, and a new pass over all values is started no more than once every 'min_interval' seconds.
+	// Only the addresses known when the views are created are compared. Expressions with dynamic indices, such as
+	// 'players[index].score', only depend on their root variable, thus for arrays only changes to their size are detected.
+	// Other changes to such variables must still be dirtied manually. Dirtied values are not detected as changed again.
+	void EnableChangeDetection(int max_checks_per_update = 1000, double min_interval = 0.0);
+	void DisableChangeDetection();
+
 	explicit operator bool() { return model; }
 
 private:
@@ -60,6 +60,8 @@ public:
 	DataVariableType Type();
 
 private:
+	friend class DataModel;
+
 	VariableDefinition* definition = nullptr;
 	void* ptr = nullptr;
 };
@@ -81,6 +83,10 @@ public:
 	virtual int Size(void* ptr);
 	virtual DataVariable Child(void* ptr, const DataAddressEntry& address);
 
+	// Returns the definition of the struct member with the given name, or nullptr if this is not a struct definition. Struct
+	// members are located at the same pointer as their struct, which allows them to be resolved once for repeated access.
+	virtual VariableDefinition* GetStructMember(const String& name);
+
 protected:
 	VariableDefinition(DataVariableType type) : type(type) {}
 
@@ -146,6 +152,7 @@ public:
 	StructDefinition();
 
 	DataVariable Child(void* ptr, const DataAddressEntry& address) override;
+	VariableDefinition* GetStructMember(const String& name) override;
 
 	void AddMember(const String& name, UniquePtr<VariableDefinition> member);
 
@@ -45,9 +45,12 @@
 
 namespace Rml {
 
+class AncestorFilter;
 class Context;
 class DataModel;
+class DataViewFor;
 class Decorator;
+class DefinitionPrefetch;
 class ElementInstancer;
 class EventDispatcher;
 class EventListener;
@@ -56,6 +59,7 @@ class ElementDefinition;
 class ElementDocument;
 class ElementScroll;
 class ElementStyle;
+class LayoutCache;
 class LayoutEngine;
 class ContainerBox;
 class InlineLevelBox;
@@ -68,6 +72,7 @@ class StyleSheetContainer;
 class TransformState;
 struct ElementMeta;
 struct StackingContextChild;
+enum class InvalidationScope : uint8_t;
 
 /**
     A generic element in the DOM tree.
@@ -601,6 +606,10 @@ public:
 	const TransformState* GetTransformState() const noexcept;
 	/// Returns the data model of this element.
 	DataModel* GetDataModel() const;
+	/// Marks the rendered output of this element as changed, see Context::EnableRetainedRendering().
+	/// @note Changes to properties, layout, and the element hierarchy are detected automatically. This only needs to be called by custom
+	/// elements whose output in OnRender() changes without such changes.
+	void DirtyRender();
 	//@}
 
 	/// Sets the instancer to use for releasing this element.
@@ -674,6 +683,8 @@ protected:
 	enum class DirtyNodes { Self, SelfAndSiblings };
 	// Dirty the element style definition, including all descendants of the specified nodes.
 	void DirtyDefinition(DirtyNodes dirty_nodes);
+	// Dirty the style definition of only those elements within the given scope, relative to this element.
+	void DirtyDefinition(InvalidationScope scope);
 
 	void SetOwnerDocument(ElementDocument* document);
 
@@ -699,9 +710,19 @@ private:
 
 	void UpdateDefinition();
 
+	// Forces a re-layout of our contents, our own box is only affected to the extent that it depends on its contents.
+	void DirtyContentLayout();
+	// Clears the cached layout results of this element and its ancestors, all of which may depend on our layout.
+	void DirtyLayoutCache();
+
 	void DirtyTransformState(bool perspective_dirty, bool transform_dirty);
 	void UpdateTransformState();
 
+	// Returns true if the recorded render commands of this stacking context can be replayed in the current render pass.
+	bool IsRenderRecordingValid(uint32_t record_stamp) const;
+	// Starts a new render pass, changes made after this call will invalidate recordings made during earlier passes.
+	static void BeginRenderPass();
+
 	void OnDpRatioChangeRecursive();
 	void DirtyFontFaceRecursive();
 
@@ -741,7 +762,8 @@ private:
 	bool absolute_offset_dirty;
 	bool rounded_main_padding_size_dirty : 1;
 
-	bool dirty_definition : 1; // Implies dirty child definitions as well.
+	bool dirty_definition : 1;     // Implies dirty child definitions as well.
+	bool dirty_own_definition : 1; // Does not imply any child definitions.
 	bool dirty_child_definitions : 1;
 
 	bool dirty_animation : 1;
@@ -802,6 +824,10 @@ private:
 	float baseline;
 	float z_index;
 
+	// The render passes during which this element, or any of its descendants, were last changed. Used for retained rendering.
+	uint32_t render_change_stamp;
+	uint32_t render_subtree_change_stamp;
+
 	ElementList stacking_context;
 
 	UniquePtr<TransformState> transform_state;
@@ -810,11 +836,15 @@ private:
 
 	ElementMeta* meta;
 
+	friend class Rml::AncestorFilter;
 	friend class Rml::Context;
+	friend class Rml::DataViewFor;
+	friend class Rml::DefinitionPrefetch;
 	friend class Rml::ElementStyle;
 	friend class Rml::ContainerBox;
 	friend class Rml::InlineLevelBox;
 	friend class Rml::ReplacedBox;
+	friend class Rml::LayoutCache;
 	friend class Rml::LayoutEngine;
 	friend class Rml::ElementScroll;
 	friend RMLUICORE_API void Rml::ReleaseFontResources();
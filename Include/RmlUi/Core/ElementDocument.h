@@ -166,6 +166,8 @@ private:
 	void DirtyLayout() override;
 	/// Returns true if the document has been marked as needing a re-layout.
 	bool IsLayoutDirty() override;
+	/// Sets the dirty flag on the nearest layout boundary containing the given element, or on the whole document if there is none.
+	void DirtyLayoutBoundary(Element* element);
 
 	/// Notify the document that media query-related properties have changed and that style sheets need to be re-evaluated.
 	void DirtyMediaQueries();
@@ -194,7 +196,11 @@ private:
 	bool layout_dirty;
 	bool position_dirty;
 
+	// Layout boundaries which need to be formatted, when the document as a whole does not need a re-layout.
+	Vector<ObserverPtr<Element>> dirty_layout_boundaries;
+
 	friend class Rml::Context;
+	friend class Rml::Element;
 	friend class Rml::Factory;
 };
 
@@ -88,6 +88,8 @@ protected:
 private:
 	// Prepares the font effects this element uses for its font.
 	bool UpdateFontEffects();
+	// Returns the font effects this element uses for its font.
+	const FontEffectList& GetFontEffects();
 
 	// Used to store the position and length of each line we have geometry for.
 	struct Line {
@@ -95,9 +97,21 @@ private:
 		String text;
 		Vector2f position;
 		int width;
+		// The meshes generated for this line alone, kept so that the line does not need to be generated again when other lines change.
+		TexturedMeshList meshes;
+		Vector<const CompiledShader*> mesh_shaders;
+		// Protects the glyphs used by the meshes from being evicted by the font engine.
+		Vector<SharedPtr<const void>> glyph_pins;
+		bool meshes_generated = false;
 	};
 
-	// Clears and regenerates all of the text's geometry.
+	// Takes the meshes of the identical line from the previous layout, if any, to avoid generating the line again.
+	void ReuseLineMeshes(Line& line);
+	// Rewrites the vertex colours of the line meshes to the current colour and opacity.
+	// @return False if the vertex colours can not be unambiguously rewritten, in which case the meshes must be generated again.
+	bool RecolourLineMeshes();
+
+	// Generates any lines missing their meshes, and rebuilds the text's geometry from the meshes of all lines.
 	void GenerateGeometry(RenderManager& render_manager, FontFaceHandle font_face_handle);
 	// Generates any geometry necessary for rendering decoration (underline, strike-through, etc).
 	void GenerateDecoration(Mesh& mesh, FontFaceHandle font_face_handle);
@@ -106,10 +120,13 @@ private:
 
 	using LineList = Vector<Line>;
 	LineList lines;
+	// The lines from before they were last cleared, whose meshes may be reused by new lines.
+	LineList previous_lines;
 
 	struct TexturedGeometry {
 		Geometry geometry;
 		Texture texture;
+		const CompiledShader* shader = nullptr;
 	};
 	Vector<TexturedGeometry> geometry;
 
@@ -119,9 +136,15 @@ private:
 	ColourbPremultiplied colour;
 	float opacity;
 
+	// The colour and opacity the line meshes were generated with.
+	ColourbPremultiplied line_meshes_colour;
+	float line_meshes_opacity;
+
 	int font_handle_version;
 
 	bool geometry_dirty : 1;
+	// True when the meshes of all lines must be generated again, such as after a change to the font or its effects.
+	bool line_meshes_dirty : 1;
 
 	bool dirty_layout_on_change : 1;
 
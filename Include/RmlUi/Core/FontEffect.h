@@ -42,6 +42,16 @@ public:
 	// Behind or in front of the main text.
 	enum class Layer { Back, Front };
 
+	// Describes the effect when glyphs are rendered from signed distance fields, all values in pixels.
+	struct DistanceFieldParameters {
+		// Distance to grow the glyph outline by.
+		float dilation = 0;
+		// Distance over which the effect fades out, centered on the (dilated) glyph outline.
+		float softness = 0;
+		// Offset of the effect from its glyph.
+		Vector2f offset;
+	};
+
 	FontEffect();
 	virtual ~FontEffect();
 
@@ -66,6 +76,13 @@ public:
 	/// @param[in] glyph The glyph the effect is being asked to generate an effect texture for.
 	virtual void GenerateGlyphTexture(byte* destination_data, Vector2i destination_dimensions, int destination_stride, const FontGlyph& glyph) const;
 
+	/// Requests the effect to describe itself for rendering from the signed distance fields of the glyphs, used instead of generating a texture
+	/// when the font engine renders glyphs from distance fields.
+	/// @param[out] parameters The parameters describing the effect.
+	/// @return False if the effect cannot be rendered from distance fields, in which case the effect is not rendered. The default implementation
+	/// returns false.
+	virtual bool GetDistanceFieldParameters(DistanceFieldParameters& parameters) const;
+
 	/// Sets the colour of the effect's geometry.
 	void SetColour(Colourb colour);
 	/// Returns the effect's colour.
@@ -104,6 +104,13 @@ public:
 	    @name Optional functions for advanced rendering features.
 	 */
 
+	/// Called by RmlUi when it wants to update a region of a texture previously generated from a sequence of pixels in memory.
+	/// @param[in] texture The texture handle to update, as returned by GenerateTexture().
+	/// @param[in] source The raw texture data of the region, in the same format as for GenerateTexture(), with tightly packed rows.
+	/// @param[in] region The region of the texture to update, in pixels.
+	/// @return True if the texture was updated. Otherwise, the texture is released and generated again in full.
+	virtual bool UpdateTexture(TextureHandle texture, Span<const byte> source, Rectanglei region);
+
 	/// Called by RmlUi when it wants to enable or disable the clip mask.
 	/// @param[in] enable True to enable the clip mask, false to disable it.
 	virtual void EnableClipMask(bool enable);
@@ -43,6 +43,7 @@ class CompiledShader;
 class TextureDatabase;
 class Texture;
 class RenderManagerAccess;
+class RenderCommandList;
 
 struct ClipMaskGeometry {
 	ClipMaskOperation operation;
@@ -113,6 +114,11 @@ public:
 
 	CompiledFilter SaveLayerAsMaskImage();
 
+	// Enables merging of consecutive geometry with the same texture and render state into single draw calls. When enabled, any
+	// rendering submitted directly to the render interface, bypassing the render manager, may be reordered relative to such geometry.
+	void EnableGeometryBatching(bool enable);
+	bool IsGeometryBatchingEnabled() const;
+
 private:
 	void ApplyClipMask(const ClipMaskGeometryList& clip_elements);
 
@@ -120,6 +126,26 @@ private:
 	CompiledGeometryHandle GetCompiledGeometryHandle(StableVectorIndex index);
 
 	void Render(const Geometry& geometry, Vector2f translation, Texture texture, const CompiledShader& shader);
+	void RenderGeometry(StableVectorIndex geometry_index, Vector2f translation, Texture texture, CompiledShaderHandle shader);
+
+	// Start recording all subsequent render commands into the given list, until the matching call to EndRecording.
+	// Recordings can be nested, in which case the inner list is replayed as part of the outer list.
+	void BeginRecording(RenderCommandList& list);
+	void EndRecording();
+	// Replays a previously recorded list. Returns false, without submitting any commands, if the list can no longer be replayed.
+	bool ReplayRecording(RenderCommandList& list);
+
+	RenderCommandList* GetActiveRecording();
+	void DiscardActiveRecording();
+	bool ValidateRecordingResources(RenderCommandList& list) const;
+	void ExecuteRecording(const RenderCommandList& list);
+
+	// Submits any geometry waiting to be batched, must be called before any other command is submitted to the render interface.
+	void FlushGeometryBatch();
+	void ReleaseGeometryBatches(bool release_all);
+
+	int GetLayerIndex(LayerHandle layer) const;
+	uint32_t GetTextureGeneration(Texture texture) const;
 
 	void GetTextureSourceList(StringList& source_list) const;
 	const Mesh& GetMesh(const Geometry& geometry) const;
@@ -128,6 +154,9 @@ private:
 	void ReleaseAllTextures();
 	void ReleaseAllCompiledGeometry();
 
+	void RegenerateTexture(const CallbackTexture& texture);
+	void UpdateTexture(const CallbackTexture& texture, Span<const byte> source, Rectanglei region);
+
 	void ReleaseResource(const CallbackTexture& texture);
 	Mesh ReleaseResource(const Geometry& geometry);
 	void ReleaseResource(const CompiledFilter& filter);
@@ -136,6 +165,19 @@ private:
 	struct GeometryData {
 		Mesh mesh;
 		CompiledGeometryHandle handle = {};
+		uint32_t generation = 0;
+	};
+
+	struct GeometryBatchEntry {
+		StableVectorIndex geometry;
+		uint32_t generation;
+		Vector2f offset;
+	};
+	struct GeometryBatch {
+		Vector<GeometryBatchEntry> entries;
+		TextureHandle texture = {};
+		CompiledGeometryHandle handle = {};
+		uint32_t last_used_pass = 0;
 	};
 
 	RenderInterface* render_interface = nullptr;
@@ -151,6 +193,22 @@ private:
 
 	Vector<LayerHandle> render_stack;
 
+	uint32_t geometry_generation = 0;
+	// Incremented whenever a resource which may be referenced by a recording is released or modified.
+	uint32_t resource_release_count = 0;
+
+	Vector<RenderCommandList*> recording_stack;
+	int recording_suspended = 0;
+
+	bool enable_geometry_batching = false;
+	// Consecutive geometry waiting to be submitted as a single batch, offset relative to the first entry's translation.
+	Vector<GeometryBatchEntry> pending_batch;
+	Vector2f pending_batch_translation;
+	TextureHandle pending_batch_texture = {};
+	// Merged and compiled batches from recent render passes, keyed by a hash of their entries and texture.
+	UnorderedMap<size_t, GeometryBatch> geometry_batches;
+	uint32_t render_pass_count = 0;
+
 	friend class RenderManagerAccess;
 };
 
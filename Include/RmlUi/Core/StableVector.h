@@ -95,6 +95,9 @@ public:
 		return elements[size_t(index)];
 	}
 
+	// Returns the slot at the given index, or nullptr if out of range. The slot may be free, in which case it holds a value-initialized element.
+	const T* get_slot(StableVectorIndex index) const { return size_t(index) < elements.size() ? &elements[size_t(index)] : nullptr; }
+
 	// Iterate over every item in the vector, skipping free slots. Complexity: O(n*log(n)) in number of free slots.
 	template <typename Func>
 	void for_each(Func&& func)
@@ -36,6 +36,7 @@
 
 namespace Rml {
 
+class DefinitionPrefetch;
 class Element;
 class ElementDefinition;
 class StyleSheetNode;
@@ -83,6 +84,14 @@ public:
 
 	/// Returns the compiled element definition for a given element and its hierarchy.
 	SharedPtr<const ElementDefinition> GetElementDefinition(const Element* element) const;
+	/// Returns true if the definition of the given element can be shared with any sibling of the same tag, id, classes, and pseudo classes.
+	bool IsElementDefinitionShareable(const Element* element) const;
+
+	/// Returns the elements whose definition may change when the given id, class, pseudo class, or attribute changes on an element.
+	InvalidationScope GetIdInvalidationScope(const String& id) const;
+	InvalidationScope GetClassInvalidationScope(const String& class_name) const;
+	InvalidationScope GetPseudoClassInvalidationScope(const String& pseudo_class) const;
+	InvalidationScope GetAttributeInvalidationScope(const String& attribute) const;
 
 	/// Returns a list of instanced decorators from the declarations. The instances are cached for faster future retrieval.
 	const DecoratorPtrList& InstanceDecorators(RenderManager& render_manager, const DecoratorDeclarationList& declaration_list,
@@ -91,6 +100,12 @@ public:
 private:
 	StyleSheet();
 
+	// Finds the nodes applicable to the given element, sorted by specificity. Only reads from the element hierarchy and the style sheet, thus
+	// it may be called concurrently for different elements as long as the hierarchy is not modified.
+	void GetApplicableNodes(const Element* element, StyleSheetIndex::NodeList& applicable_nodes) const;
+	// Returns the cached element definition for the given applicable nodes, creating it if necessary.
+	SharedPtr<const ElementDefinition> GetElementDefinition(const StyleSheetIndex::NodeList& applicable_nodes) const;
+
 	// Root level node, attributes from special nodes like "body" get added to this node
 	UniquePtr<StyleSheetNode> root;
 
@@ -121,6 +136,7 @@ private:
 	using DecoratorCache = UnorderedMap<String, Vector<SharedPtr<const Decorator>>>;
 	mutable DecoratorCache decorator_cache;
 
+	friend Rml::DefinitionPrefetch;
 	friend Rml::StyleSheetParser;
 	friend Rml::StyleSheetContainer;
 };
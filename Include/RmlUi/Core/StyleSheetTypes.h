@@ -96,6 +96,25 @@ struct MediaBlock {
 };
 using MediaBlockList = Vector<MediaBlock>;
 
+/**
+   Determines which elements may need their definition updated when a name used by selectors, such as a class, changes on an element.
+ */
+enum class InvalidationScope : uint8_t {
+	None = 0,
+	Self = 1 << 0,
+	Children = 1 << 1,
+	Descendants = 1 << 2, // Includes children.
+	Siblings = 1 << 3,    // Includes the descendants of siblings.
+};
+inline InvalidationScope operator|(InvalidationScope lhs, InvalidationScope rhs)
+{
+	return InvalidationScope(uint8_t(lhs) | uint8_t(rhs));
+}
+inline InvalidationScope operator&(InvalidationScope lhs, InvalidationScope rhs)
+{
+	return InvalidationScope(uint8_t(lhs) & uint8_t(rhs));
+}
+
 /**
    StyleSheetIndex contains a cached index of all styled nodes for quick lookup when finding applicable style nodes for the current state of a given
    element.
@@ -107,6 +126,16 @@ struct StyleSheetIndex {
 	// The following objects are given in prioritized order. Any nodes in the first object will not be contained in the next one and so on.
 	NodeIndex ids, classes, tags;
 	NodeList other;
+
+	// Keys of the above indices containing any node which depends on more than the tag, id, classes, and pseudo classes of the element itself
+	// and its ancestors. That is, nodes with attribute or structural selectors, or sibling combinators. Element definitions can only be shared
+	// between siblings when none of their candidate nodes are among these.
+	UnorderedSet<size_t> unshareable_ids, unshareable_classes, unshareable_tags;
+	bool unshareable_other = false;
+
+	// Maps names used by any selector to the elements whose definition may change when the name changes on an element.
+	using InvalidationIndex = UnorderedMap<size_t, InvalidationScope>;
+	InvalidationIndex invalidation_ids, invalidation_classes, invalidation_pseudo_classes, invalidation_attributes;
 };
 } // namespace Rml
 
@@ -91,6 +91,17 @@ public:
 
 	/// Deactivate keyboard (for touchscreen devices).
 	virtual void DeactivateKeyboard();
+
+	/// Execute a number of independent tasks, and return once all of them have completed.
+	/// The default implementation runs the tasks in order on the calling thread. Override this to distribute the tasks over a thread pool.
+	/// @param[in] count The number of tasks to execute.
+	/// @param[in] task The task to execute, called once for each index in the range [0, count). Calls may be made concurrently and in any order.
+	/// @note The tasks never call back into the library in ways that modify its state, however, they must not be run concurrently with other
+	/// library calls.
+	/// @note The library uses this for selector matching during style resolution, see Context::EnableParallelStyleResolution(), and for
+	/// glyph generation in the default font engine. In style resolution, only the matching of elements against their style sheet runs in these
+	/// tasks, the resulting definitions are applied and the property values computed serially during the update.
+	virtual void ExecuteParallel(int count, const Function<void(int)>& task);
 };
 
 } // namespace Rml
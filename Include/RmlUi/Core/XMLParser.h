@@ -92,7 +92,7 @@ public:
 	/// Access the current parse frame.
 	const ParseFrame* GetParseFrame() const;
 
-	/// Returns the source URL of this parse.
+	/// Returns the source URL of this parse, or an empty URL when the handlers are called without parsing a stream.
 	const URL& GetSourceURL() const;
 
 protected:
@@ -0,0 +1,133 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include <RmlUi/Core.h>
+#include <stdio.h>
+#include <string.h>
+
+/*
+    Bakes the glyphs used by a set of documents into a file, which can be loaded at startup with Rml::LoadBakedFontGlyphs to avoid rasterizing
+    the glyphs and generating their font effects.
+
+    The documents are laid out and rendered without any window, thus only glyphs reachable from their initial state are baked. Glyphs missing
+    from the baked file are still generated as usual at runtime.
+*/
+
+// Renders nothing, the glyphs are baked from the font engine's own texture data.
+class RenderInterfaceNone : public Rml::RenderInterface {
+public:
+	Rml::CompiledGeometryHandle CompileGeometry(Rml::Span<const Rml::Vertex> /*vertices*/, Rml::Span<const int> /*indices*/) override { return 1; }
+	void RenderGeometry(Rml::CompiledGeometryHandle /*geometry*/, Rml::Vector2f /*translation*/, Rml::TextureHandle /*texture*/) override {}
+	void ReleaseGeometry(Rml::CompiledGeometryHandle /*geometry*/) override {}
+
+	Rml::TextureHandle LoadTexture(Rml::Vector2i& texture_dimensions, const Rml::String& /*source*/) override
+	{
+		texture_dimensions = Rml::Vector2i(1, 1);
+		return 1;
+	}
+	Rml::TextureHandle GenerateTexture(Rml::Span<const Rml::byte> /*source*/, Rml::Vector2i /*source_dimensions*/) override { return 1; }
+	void ReleaseTexture(Rml::TextureHandle /*texture*/) override {}
+
+	void EnableScissorRegion(bool /*enable*/) override {}
+	void SetScissorRegion(Rml::Rectanglei /*region*/) override {}
+};
+
+static bool EndsWith(const char* string, const char* suffix)
+{
+	const size_t length = strlen(string);
+	const size_t suffix_length = strlen(suffix);
+	return length >= suffix_length && strcmp(string + length - suffix_length, suffix) == 0;
+}
+
+int main(int argc, char** argv)
+{
+	if (argc < 3)
+	{
+		printf("Usage: %s <output file> <font files and documents...>\n", argv[0]);
+		printf("Loads the font files (.ttf, .otf, ...), renders the documents (.rml), and bakes the glyphs they use to the output file.\n");
+		return 1;
+	}
+
+	const int window_width = 1920;
+	const int window_height = 1080;
+
+	RenderInterfaceNone render_interface;
+	Rml::SetRenderInterface(&render_interface);
+
+	if (!Rml::Initialise())
+		return 1;
+
+	Rml::Context* context = Rml::CreateContext("main", Rml::Vector2i(window_width, window_height));
+	if (!context)
+	{
+		Rml::Shutdown();
+		return 1;
+	}
+
+	// Fonts should be loaded before any documents are loaded.
+	for (int i = 2; i < argc; i++)
+	{
+		if (!EndsWith(argv[i], ".rml"))
+			Rml::LoadFontFace(argv[i]);
+	}
+
+	for (int i = 2; i < argc; i++)
+	{
+		if (!EndsWith(argv[i], ".rml"))
+			continue;
+
+		if (Rml::ElementDocument* document = context->LoadDocument(argv[i]))
+			document->Show();
+		else
+			printf("Failed to load document '%s'.\n", argv[i]);
+	}
+
+	// Generate the text of all documents, which generates the glyphs and font effects used by them.
+	context->Update();
+	context->Render();
+
+	Rml::Vector<Rml::byte> baked_data;
+	bool result = Rml::BakeFontGlyphs(baked_data);
+
+	if (result)
+	{
+		FILE* file = fopen(argv[1], "wb");
+		result = (file && fwrite(baked_data.data(), 1, baked_data.size(), file) == baked_data.size());
+		if (file)
+			result &= (fclose(file) == 0);
+	}
+
+	if (result)
+		printf("Baked %zu bytes of font glyphs to '%s'.\n", baked_data.size(), argv[1]);
+	else
+		printf("Failed to bake font glyphs to '%s'.\n", argv[1]);
+
+	Rml::Shutdown();
+
+	return result ? 0 : 1;
+}
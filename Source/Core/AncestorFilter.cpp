@@ -0,0 +1,109 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "AncestorFilter.h"
+#include "../../Include/RmlUi/Core/Element.h"
+#include "ElementMeta.h"
+
+namespace Rml {
+
+void AncestorFilter::Add(const String& name)
+{
+	// Use two bits per name, taken from separate parts of the hash, to reduce the rate of false positives.
+	const size_t hash = Hash<String>()(name);
+	SetBit(hash % num_bits);
+	SetBit((hash >> 16) % num_bits);
+}
+
+void AncestorFilter::Add(const AncestorFilter& other)
+{
+	for (int i = 0; i < num_words; i++)
+		words[i] |= other.words[i];
+}
+
+bool AncestorFilter::MayContain(const AncestorFilter& other) const
+{
+	for (int i = 0; i < num_words; i++)
+	{
+		if ((words[i] & other.words[i]) != other.words[i])
+			return false;
+	}
+	return true;
+}
+
+bool AncestorFilter::IsEmpty() const
+{
+	for (int i = 0; i < num_words; i++)
+	{
+		if (words[i] != 0)
+			return false;
+	}
+	return true;
+}
+
+const AncestorFilter& AncestorFilter::Get(const Element* element)
+{
+	ElementMeta& meta = *element->meta;
+	if (meta.ancestor_filter_dirty)
+	{
+		meta.ancestor_filter = AncestorFilter();
+		if (const Element* parent = element->GetParentNode())
+		{
+			meta.ancestor_filter.Add(Get(parent));
+			meta.ancestor_filter.Add(parent->GetTagName());
+			if (!parent->GetId().empty())
+				meta.ancestor_filter.Add(parent->GetId());
+			for (const String& class_name : parent->meta->style.GetClassNameList())
+				meta.ancestor_filter.Add(class_name);
+		}
+		meta.ancestor_filter_dirty = false;
+	}
+	return meta.ancestor_filter;
+}
+
+void AncestorFilter::Dirty(Element* element, bool include_self)
+{
+	// A dirty filter implies that the filters of all descendants are dirty too, thus we can stop at any element which is already dirty.
+	if (include_self)
+	{
+		if (element->meta->ancestor_filter_dirty)
+			return;
+		element->meta->ancestor_filter_dirty = true;
+	}
+
+	const int num_children = element->GetNumChildren(true);
+	for (int i = 0; i < num_children; i++)
+		Dirty(element->GetChild(i), true);
+}
+
+void AncestorFilter::SetBit(size_t bit)
+{
+	words[bit / 64] |= (uint64_t(1) << (bit % 64));
+}
+
+} // namespace Rml
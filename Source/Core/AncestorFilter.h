@@ -0,0 +1,72 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef RMLUI_CORE_ANCESTORFILTER_H
+#define RMLUI_CORE_ANCESTORFILTER_H
+
+#include "../../Include/RmlUi/Core/Types.h"
+
+namespace Rml {
+
+class Element;
+
+/**
+    A Bloom filter of the tag, id, and class names of all the ancestors of an element.
+
+    Used during selector matching to quickly reject selectors which require ancestors that are not present, without walking the element
+    hierarchy. The filter may report false positives, but never false negatives.
+ */
+class AncestorFilter {
+public:
+	/// Adds the given tag, id, or class name to the filter.
+	void Add(const String& name);
+	/// Adds all the names in the other filter to this one.
+	void Add(const AncestorFilter& other);
+
+	/// Returns true if all the names in the other filter may be present in this one, false if at least one of them is definitely not present.
+	bool MayContain(const AncestorFilter& other) const;
+
+	bool IsEmpty() const;
+
+	/// Returns the filter of all the ancestors of the given element, updating it if necessary.
+	static const AncestorFilter& Get(const Element* element);
+	/// Marks the filters of all descendants of the given element as out of date, such as after its tag or class names change or it is moved.
+	/// @param[in] include_self True to also mark the element's own filter.
+	static void Dirty(Element* element, bool include_self);
+
+private:
+	static constexpr int num_words = 4;
+	static constexpr int num_bits = num_words * 64;
+
+	void SetBit(size_t bit);
+
+	uint64_t words[num_words] = {};
+};
+
+} // namespace Rml
+#endif
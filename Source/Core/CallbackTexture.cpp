@@ -32,6 +32,18 @@
 
 namespace Rml {
 
+void CallbackTexture::Regenerate()
+{
+	if (resource_handle != StableVectorIndex::Invalid)
+		RenderManagerAccess::RegenerateTexture(render_manager, *this);
+}
+
+void CallbackTexture::Update(Span<const byte> source, Rectanglei region)
+{
+	if (resource_handle != StableVectorIndex::Invalid)
+		RenderManagerAccess::UpdateTexture(render_manager, *this, source, region);
+}
+
 void CallbackTexture::Release()
 {
 	if (resource_handle != StableVectorIndex::Invalid)
@@ -78,6 +90,7 @@ void CallbackTextureInterface::SaveLayerAsTexture() const
 		return;
 	}
 
+	RenderManagerAccess::FlushGeometryBatch(&render_manager);
 	texture_handle = render_interface.SaveLayerAsTexture();
 	if (texture_handle)
 		dimensions = region.Size();
@@ -109,4 +122,16 @@ Texture CallbackTextureSource::GetTexture(RenderManager& render_manager) const
 	return Texture(texture);
 }
 
+void CallbackTextureSource::Regenerate()
+{
+	for (auto& render_manager_texture : textures)
+		render_manager_texture.second.Regenerate();
+}
+
+void CallbackTextureSource::Update(Span<const byte> source, Rectanglei region)
+{
+	for (auto& render_manager_texture : textures)
+		render_manager_texture.second.Update(source, region);
+}
+
 } // namespace Rml
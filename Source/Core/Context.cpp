@@ -40,6 +40,7 @@
 #include "../../Include/RmlUi/Core/StreamMemory.h"
 #include "../../Include/RmlUi/Core/SystemInterface.h"
 #include "DataModel.h"
+#include "DefinitionPrefetch.h"
 #include "EventDispatcher.h"
 #include "PluginRegistry.h"
 #include "ScrollController.h"
@@ -221,8 +222,15 @@ bool Context::Update()
 	root->dirty_definition = false;
 	root->dirty_child_definitions = false;
 
+	if (enable_parallel_style_resolution)
+		DefinitionPrefetch::Prefetch(root.get());
+
 	root->Update(density_independent_pixel_ratio, Vector2f(dimensions));
 
+	// Don't let any unused prefetched definitions carry over to the next update.
+	if (enable_parallel_style_resolution)
+		DefinitionPrefetch::Invalidate();
+
 	for (int i = 0; i < root->GetNumChildren(); ++i)
 	{
 		if (auto doc = root->GetChild(i)->GetOwnerDocument())
@@ -244,6 +252,8 @@ bool Context::Render()
 
 	render_manager->PrepareRender(dimensions);
 
+	Element::BeginRenderPass();
+
 	root->Render();
 
 	// Render the cursor proxy so that any attached drag clone will be rendered below the cursor.
@@ -416,6 +426,26 @@ void Context::EnableMouseCursor(bool enable)
 	enable_cursor = enable;
 }
 
+void Context::EnableRetainedRendering(bool enable)
+{
+	enable_retained_rendering = enable;
+}
+
+bool Context::IsRetainedRenderingEnabled() const
+{
+	return enable_retained_rendering;
+}
+
+void Context::EnableParallelStyleResolution(bool enable)
+{
+	enable_parallel_style_resolution = enable;
+}
+
+bool Context::IsParallelStyleResolutionEnabled() const
+{
+	return enable_parallel_style_resolution;
+}
+
 void Context::ActivateTheme(const String& theme_name, bool activate)
 {
 	bool theme_changed = false;
@@ -28,6 +28,7 @@
 
 #include "../../Include/RmlUi/Core/ConvolutionFilter.h"
 #include "../../Include/RmlUi/Core/Profiling.h"
+#include <algorithm>
 #include <float.h>
 #include <string.h>
 
@@ -80,38 +81,61 @@ void ConvolutionFilter::Run(byte* destination, const Vector2i destination_dimens
 
 	const Vector2i kernel_radius = (kernel_size - Vector2i(1)) / 2;
 
+	// Convert the source opacity to floats up-front, so that the inner loops operate on contiguous floats only.
+	Vector<float> source_opacity(size_t(source_dimensions.x * source_dimensions.y));
+	for (int i = 0; i < source_dimensions.x * source_dimensions.y; i++)
+		source_opacity[i] = float(source[i * source_bytes_per_pixel + source_alpha_offset]);
+
+	Vector<float> row_opacity(size_t(destination_dimensions.x));
+
 	for (int y = 0; y < destination_dimensions.y; ++y)
 	{
-		for (int x = 0; x < destination_dimensions.x; ++x)
+		std::fill(row_opacity.begin(), row_opacity.end(), 0.f);
+
+		// Apply each kernel value to the whole destination row at once. The inner loops have no branches and are easily vectorized by the
+		// compiler. Separable kernels with a single row or column reduce to a single pass along the row.
+		for (int kernel_y = 0; kernel_y < kernel_size.y; ++kernel_y)
 		{
-			float opacity = 0.f;
+			const int source_y = y - source_offset.y - kernel_radius.y + kernel_y;
+			if (source_y < 0 || source_y >= source_dimensions.y)
+				continue;
+
+			const float* source_row = source_opacity.data() + source_y * source_dimensions.x;
 
-			for (int kernel_y = 0; kernel_y < kernel_size.y; ++kernel_y)
+			for (int kernel_x = 0; kernel_x < kernel_size.x; ++kernel_x)
 			{
-				const int source_y = y - source_offset.y - kernel_radius.y + kernel_y;
+				// Zero-valued kernel entries do not contribute to either operation.
+				const float weight = kernel[kernel_y * kernel_size.x + kernel_x];
+				if (weight == 0.f)
+					continue;
+
+				// Restrict the destination range to the pixels that sample inside the source.
+				const int shift = kernel_x - source_offset.x - kernel_radius.x;
+				const int x_begin = Math::Max(0, -shift);
+				const int x_end = Math::Min(destination_dimensions.x, source_dimensions.x - shift);
 
-				for (int kernel_x = 0; kernel_x < kernel_size.x; ++kernel_x)
+				float* row = row_opacity.data();
+
+				switch (operation)
 				{
-					const int source_x = x - source_offset.x - kernel_radius.x + kernel_x;
-					if (source_y >= 0 && source_y < source_dimensions.y && source_x >= 0 && source_x < source_dimensions.x)
+				case FilterOperation::Sum:
+					for (int x = x_begin; x < x_end; ++x)
+						row[x] += source_row[x + shift] * weight;
+					break;
+				case FilterOperation::Dilation:
+					for (int x = x_begin; x < x_end; ++x)
 					{
-						const int source_index = (source_y * source_dimensions.x + source_x) * source_bytes_per_pixel + source_alpha_offset;
-						const float pixel_opacity = float(source[source_index]) * kernel[kernel_y * kernel_size.x + kernel_x];
-
-						switch (operation)
-						{
-						case FilterOperation::Sum: opacity += pixel_opacity; break;
-						case FilterOperation::Dilation: opacity = Math::Max(opacity, pixel_opacity); break;
-						}
+						const float value = source_row[x + shift] * weight;
+						row[x] = (value > row[x] ? value : row[x]);
 					}
+					break;
 				}
 			}
-
-			opacity = Math::Min(255.f, opacity);
-
-			const int destination_index = y * destination_stride + x * destination_bytes_per_pixel + destination_alpha_offset;
-			destination[destination_index] = byte(opacity);
 		}
+
+		byte* destination_row = destination + y * destination_stride + destination_alpha_offset;
+		for (int x = 0; x < destination_dimensions.x; ++x)
+			destination_row[x * destination_bytes_per_pixel] = byte(Math::Min(255.f, row_opacity[x]));
 	}
 }
 
@@ -51,9 +51,11 @@
 #include "StyleSheetFactory.h"
 #include "StyleSheetParser.h"
 #include "TemplateCache.h"
+#include "TextWidthCache.h"
 
 #ifdef RMLUI_FONT_ENGINE_FREETYPE
 	#include "FontEngineDefault/FontEngineInterfaceDefault.h"
+	#include "FontEngineDefault/FontProvider.h"
 #endif
 
 #ifdef RMLUI_LOTTIE_PLUGIN
@@ -158,6 +160,7 @@ bool Initialise()
 		core_data->render_managers[render_interface] = MakeUnique<RenderManager>(render_interface);
 
 	font_interface->Initialize();
+	TextWidthCache::Initialize();
 
 	StyleSheetSpecification::Initialise();
 	StyleSheetParser::Initialise();
@@ -199,6 +202,7 @@ void Shutdown()
 	StyleSheetParser::Shutdown();
 	StyleSheetSpecification::Shutdown();
 
+	TextWidthCache::Shutdown();
 	font_interface->Shutdown();
 
 	core_data->render_managers.clear();
@@ -304,7 +308,13 @@ Context* CreateContext(const String& name, const Vector2i dimensions, RenderInte
 	// Each unique render interface gets its own render manager.
 	auto& render_manager = core_data->render_managers[render_interface_for_context];
 	if (!render_manager)
+	{
 		render_manager = MakeUnique<RenderManager>(render_interface_for_context);
+#ifdef RMLUI_FONT_ENGINE_FREETYPE
+		if (core_data->default_font_interface && FontProvider::VerifyDistanceFieldSupport(render_interface_for_context))
+			ReleaseFontResources();
+#endif
+	}
 
 	ContextPtr new_context = Factory::InstanceContext(name, render_manager.get(), text_input_handler_for_context);
 	if (!new_context)
@@ -358,11 +368,14 @@ int GetNumContexts()
 
 bool LoadFontFace(const String& file_path, bool fallback_face, Style::FontWeight weight, int face_index)
 {
+	// New faces may provide glyphs for characters which were previously missing, thereby changing the width of strings measured earlier.
+	TextWidthCache::Clear();
 	return font_interface->LoadFontFace(file_path, face_index, fallback_face, weight);
 }
 
 bool LoadFontFace(Span<const byte> data, const String& family, Style::FontStyle style, Style::FontWeight weight, bool fallback_face, int face_index)
 {
+	TextWidthCache::Clear();
 	return font_interface->LoadFontFace(data, face_index, family, style, weight, fallback_face);
 }
 
@@ -446,11 +459,103 @@ void ReleaseFontResources()
 		name_context.second->GetRootElement()->DirtyFontFaceRecursive();
 
 	font_interface->ReleaseFontResources();
+	TextWidthCache::Clear();
 
 	for (const auto& name_context : core_data->contexts)
 		name_context.second->Update();
 }
 
+void SetDistanceFieldTextRendering(bool enable)
+{
+#ifdef RMLUI_FONT_ENGINE_FREETYPE
+	if (FontProvider::SetDistanceFieldRendering(enable) && initialised)
+	{
+		if (core_data->default_font_interface)
+		{
+			for (const auto& render_manager : core_data->render_managers)
+				FontProvider::VerifyDistanceFieldSupport(render_manager.first);
+		}
+		ReleaseFontResources();
+	}
+#else
+	(void)enable;
+	Log::Message(Log::LT_WARNING, "Distance field text rendering requires the default font engine.");
+#endif
+}
+
+void SetParallelGlyphGeneration(bool enable)
+{
+#ifdef RMLUI_FONT_ENGINE_FREETYPE
+	FontProvider::SetParallelGlyphGeneration(enable);
+#else
+	(void)enable;
+	Log::Message(Log::LT_WARNING, "Parallel glyph generation requires the default font engine.");
+#endif
+}
+
+#ifdef RMLUI_FONT_ENGINE_FREETYPE
+static bool UsesDefaultFontEngine()
+{
+	if (initialised && core_data->default_font_interface)
+		return true;
+
+	Log::Message(Log::LT_WARNING, "Baked font glyphs require the default font engine to be initialized.");
+	return false;
+}
+#endif
+
+bool LoadBakedFontGlyphs(const String& file_path)
+{
+#ifdef RMLUI_FONT_ENGINE_FREETYPE
+	if (!UsesDefaultFontEngine() || !FontProvider::LoadBakedGlyphs(file_path))
+		return false;
+	ReleaseFontResources();
+	return true;
+#else
+	(void)file_path;
+	Log::Message(Log::LT_WARNING, "Baked font glyphs require the default font engine.");
+	return false;
+#endif
+}
+
+bool LoadBakedFontGlyphs(Span<const byte> data)
+{
+#ifdef RMLUI_FONT_ENGINE_FREETYPE
+	if (!UsesDefaultFontEngine() || !FontProvider::LoadBakedGlyphs(data))
+		return false;
+	ReleaseFontResources();
+	return true;
+#else
+	(void)data;
+	Log::Message(Log::LT_WARNING, "Baked font glyphs require the default font engine.");
+	return false;
+#endif
+}
+
+void ReleaseBakedFontGlyphs()
+{
+#ifdef RMLUI_FONT_ENGINE_FREETYPE
+	if (!UsesDefaultFontEngine())
+		return;
+	FontProvider::ReleaseBakedGlyphs();
+	ReleaseFontResources();
+#endif
+}
+
+bool BakeFontGlyphs(Vector<byte>& out_data)
+{
+#ifdef RMLUI_FONT_ENGINE_FREETYPE
+	if (!UsesDefaultFontEngine())
+		return false;
+	FontProvider::BakeGlyphs(out_data);
+	return true;
+#else
+	(void)out_data;
+	Log::Message(Log::LT_WARNING, "Baked font glyphs require the default font engine.");
+	return false;
+#endif
+}
+
 void ReleaseRenderManagers()
 {
 	auto& contexts = core_data->contexts;
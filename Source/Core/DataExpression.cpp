@@ -42,6 +42,16 @@ namespace Rml {
 
 class DataParser;
 
+static void LogExpressionError(const String& expression, size_t index, const String& message)
+{
+	Log::Message(Log::LT_WARNING, "Error in data expression at %zu. %s", index, message.c_str());
+	Log::Message(Log::LT_WARNING, "  \"%s\"", expression.c_str());
+
+	const size_t cursor_offset = index + 3;
+	const String cursor_string = String(cursor_offset, ' ') + '^';
+	Log::Message(Log::LT_WARNING, "%s", cursor_string.c_str());
+}
+
 /*
     The abstract machine for RmlUi data expressions.
 
@@ -67,6 +77,7 @@ enum class Instruction {
 	Push            = 'P',     //      S+ = R
 	Pop             = 'o',     //   <R/L> = S-  (D determines R/L)
 	Literal         = 'D',     //       R = D
+	MoveToL         = 'M',     //       L = R
 	Variable        = 'V',     //       R = DataModel.GetVariable(D)  (D is an index into the variable address list)
 	Add             = '+',     //       R = L + R
 	Subtract        = '-',     //       R = L - R
@@ -114,9 +125,7 @@ namespace Parse {
 
 class DataParser {
 public:
-	DataParser(String expression, DataExpressionInterface expression_interface) :
-		expression(std::move(expression)), expression_interface(expression_interface)
-	{}
+	DataParser(String expression) : expression(std::move(expression)) {}
 
 	char Look()
 	{
@@ -156,12 +165,7 @@ public:
 	void Error(const String& message)
 	{
 		parse_error = true;
-		Log::Message(Log::LT_WARNING, "Error in data expression at %zu. %s", index, message.c_str());
-		Log::Message(Log::LT_WARNING, "  \"%s\"", expression.c_str());
-
-		const size_t cursor_offset = size_t(index) + 3;
-		const String cursor_string = String(cursor_offset, ' ') + '^';
-		Log::Message(Log::LT_WARNING, "%s", cursor_string.c_str());
+		LogExpressionError(expression, index, message);
 	}
 	void Expected(const String& expected_symbols)
 	{
@@ -176,7 +180,8 @@ public:
 	bool Parse(bool is_assignment_expression)
 	{
 		program.clear();
-		variable_addresses.clear();
+		variables.clear();
+		jump_target_barrier = 0;
 		index = 0;
 		reached_end = false;
 		parse_error = false;
@@ -204,15 +209,13 @@ public:
 		return !parse_error;
 	}
 
-	Program ReleaseProgram()
+	SharedPtr<const DataExpressionProgram> ReleaseProgram()
 	{
 		RMLUI_ASSERT(!parse_error);
-		return std::move(program);
-	}
-	AddressList ReleaseAddresses()
-	{
-		RMLUI_ASSERT(!parse_error);
-		return std::move(variable_addresses);
+		auto result = MakeShared<DataExpressionProgram>();
+		result->program = std::move(program);
+		result->variables = std::move(variables);
+		return result;
 	}
 
 	void Emit(Instruction instruction, Variant data = Variant())
@@ -222,6 +225,9 @@ public:
 				instruction != Instruction::Assign,
 			"Use Push(), Pop(), Function(), Variable(), and Assign() procedures for stack manipulation and variable instructions.");
 
+		if (FoldConstants(instruction))
+			return;
+
 		program.push_back(InstructionData{instruction, std::move(data)});
 	}
 	void Push()
@@ -237,6 +243,17 @@ public:
 			return;
 		}
 		program_stack_size -= 1;
+
+		// When only a literal or variable was evaluated since the push, move the pushed value directly into the left register
+		// instead of going through the stack. That is, replace [Push, X, Pop L] by [MoveToL, X].
+		const size_t size = program.size();
+		if (destination == Register::L && size >= 2 && program[size - 2].instruction == Instruction::Push &&
+			(program[size - 1].instruction == Instruction::Literal || program[size - 1].instruction == Instruction::Variable))
+		{
+			program[size - 2].instruction = Instruction::MoveToL;
+			return;
+		}
+
 		program.push_back(InstructionData{Instruction::Pop, Variant(int(destination))});
 	}
 	void Function(Instruction instruction, int num_arguments, String&& name)
@@ -256,7 +273,13 @@ public:
 	void Variable(const String& data_address) { VariableGetSet(data_address, false); }
 	void Assign(const String& data_address) { VariableGetSet(data_address, true); }
 	size_t InstructionIndex() const { return program.size(); }
-	void PatchInstruction(size_t index, InstructionData data) { program[index] = data; }
+	void PatchInstruction(size_t index, InstructionData data)
+	{
+		// Instructions before any jump target can no longer be folded into the instructions following it.
+		if (data.instruction == Instruction::Jump || data.instruction == Instruction::JumpIfZero)
+			jump_target_barrier = Math::Max(jump_target_barrier, data.data.Get<size_t>(0));
+		program[index] = data;
+	}
 
 	ProgramState GetProgramState() { return ProgramState{program.size(), program_stack_size}; }
 
@@ -267,43 +290,31 @@ public:
 		program_stack_size = state.stack_size;
 	}
 
-	bool AddVariableAddress(const String& name)
-	{
-		DataAddress address = expression_interface.ParseAddress(name);
-		if (address.empty())
-		{
-			return false;
-		}
-
-		variable_addresses.push_back(std::move(address));
-		return true;
-	}
+	// Adds the variable as a dependency of the expression, without referring to it in the program.
+	void AddVariableDependency(const String& name) { variables.push_back(DataExpressionProgram::Variable{name, index, false}); }
 
 private:
+	// Evaluates the instruction immediately if all its operands are literals, replacing them by the resulting literal.
+	bool FoldConstants(Instruction instruction);
+
 	void VariableGetSet(const String& name, bool is_assignment)
 	{
-		DataAddress address = expression_interface.ParseAddress(name);
-		if (address.empty())
-		{
-			Error(CreateString("Could not find data variable with name '%s'.", name.c_str()));
-			return;
-		}
-		int index = int(variable_addresses.size());
-		variable_addresses.push_back(std::move(address));
-		program.push_back(InstructionData{is_assignment ? Instruction::Assign : Instruction::Variable, Variant(int(index))});
+		const int variable_index = int(variables.size());
+		variables.push_back(DataExpressionProgram::Variable{name, index, true});
+		program.push_back(InstructionData{is_assignment ? Instruction::Assign : Instruction::Variable, Variant(variable_index)});
 	}
 
 	const String expression;
-	DataExpressionInterface expression_interface;
 
 	size_t index = 0;
 	bool reached_end = false;
 	bool parse_error = true;
 	int program_stack_size = 0;
+	size_t jump_target_barrier = 0;
 
 	Program program;
 
-	AddressList variable_addresses;
+	Vector<DataExpressionProgram::Variable> variables;
 };
 
 namespace Parse {
@@ -722,7 +733,7 @@ namespace Parse {
 			else
 			{
 				// add the root of a variable expression as dependency into the address list
-				parser.AddVariableAddress(name);
+				parser.AddVariableDependency(name);
 
 				parser.Emit(Instruction::DynamicVariable, Variant());
 			}
@@ -922,8 +933,8 @@ static String DumpProgram(const Program& program)
 
 class DataInterpreter {
 public:
-	DataInterpreter(const Program& program, const AddressList& addresses, DataExpressionInterface expression_interface) :
-		program(program), addresses(addresses), expression_interface(expression_interface)
+	DataInterpreter(const Program& program, const AddressList& addresses, const AccessorList& accessors, DataExpressionInterface expression_interface) :
+		program(program), addresses(addresses), accessors(accessors), expression_interface(expression_interface)
 	{}
 
 	bool Error(const String& message) const
@@ -970,11 +981,41 @@ private:
 
 	const Program& program;
 	const AddressList& addresses;
+	const AccessorList& accessors;
 	DataExpressionInterface expression_interface;
 
+	// Applies the operation directly to integer operands, or to double operands where either side may be an integer or float. Other operand
+	// types are converted to doubles. Arithmetic operations convert their operands to doubles themselves, so that integers behave as doubles
+	// everywhere.
+	template <typename Operation>
+	static Variant NumericOperation(const Variant& left, const Variant& right, Operation operation)
+	{
+		const Variant::Type left_type = left.GetType();
+		const Variant::Type right_type = right.GetType();
+		if (left_type == Variant::INT && right_type == Variant::INT)
+			return Variant(operation(left.GetReference<int>(), right.GetReference<int>()));
+
+		auto IsNumber = [](Variant::Type type) { return type == Variant::INT || type == Variant::FLOAT || type == Variant::DOUBLE; };
+		if (IsNumber(left_type) && IsNumber(right_type))
+		{
+			auto ToDouble = [](const Variant& v) {
+				switch (v.GetType())
+				{
+				case Variant::INT: return double(v.GetReference<int>());
+				case Variant::FLOAT: return double(v.GetReference<float>());
+				default: return v.GetReference<double>();
+				}
+			};
+			return Variant(operation(ToDouble(left), ToDouble(right)));
+		}
+
+		return Variant(operation(left.Get<double>(), right.Get<double>()));
+	}
+
 	bool Execute(const Instruction instruction, const Variant& data, size_t& next_instruction)
 	{
 		auto AnyString = [](const Variant& v1, const Variant& v2) { return v1.GetType() == Variant::STRING || v2.GetType() == Variant::STRING; };
+		auto BothStrings = [](const Variant& v1, const Variant& v2) { return v1.GetType() == Variant::STRING && v2.GetType() == Variant::STRING; };
 
 		switch (instruction)
 		{
@@ -993,8 +1034,8 @@ private:
 			switch (reg)
 			{
 				// clang-format off
-			case Register::R:  R = stack.back(); stack.pop_back(); break;
-			case Register::L:  L = stack.back(); stack.pop_back(); break;
+			case Register::R:  R = std::move(stack.back()); stack.pop_back(); break;
+			case Register::L:  L = std::move(stack.back()); stack.pop_back(); break;
 				// clang-format on
 			default: return Error(CreateString("Invalid register %d.", int(reg)));
 			}
@@ -1005,6 +1046,12 @@ private:
 			R = data;
 		}
 		break;
+		case Instruction::MoveToL:
+		{
+			L = std::move(R);
+			R.Clear();
+		}
+		break;
 		case Instruction::DynamicVariable:
 		{
 			auto str = R.Get<String>();
@@ -1017,46 +1064,52 @@ private:
 		case Instruction::Variable:
 		{
 			size_t variable_index = size_t(data.Get<int>(-1));
-			if (variable_index < addresses.size())
-				R = expression_interface.GetValue(addresses[variable_index]);
+			if (variable_index < addresses.size() && variable_index < accessors.size())
+				R = expression_interface.GetValue(accessors[variable_index], addresses[variable_index]);
 			else
 				return Error("Variable address not found.");
 		}
 		break;
 		case Instruction::Add:
 		{
-			if (AnyString(L, R))
+			if (BothStrings(L, R))
+				R = Variant(L.GetReference<String>() + R.GetReference<String>());
+			else if (AnyString(L, R))
 				R = Variant(L.Get<String>() + R.Get<String>());
 			else
-				R = Variant(L.Get<double>() + R.Get<double>());
+				R = NumericOperation(L, R, [](auto l, auto r) { return double(l) + double(r); });
 		}
 		break;
 			// clang-format off
-		case Instruction::Subtract:  R = Variant(L.Get<double>() - R.Get<double>());  break;
-		case Instruction::Multiply:  R = Variant(L.Get<double>() * R.Get<double>());  break;
-		case Instruction::Divide:    R = Variant(L.Get<double>() / R.Get<double>());  break;
-		case Instruction::Not:       R = Variant(!R.Get<bool>());                     break;
-		case Instruction::And:       R = Variant(L.Get<bool>() && R.Get<bool>());     break;
-		case Instruction::Or:        R = Variant(L.Get<bool>() || R.Get<bool>());     break;
-		case Instruction::Less:      R = Variant(L.Get<double>() < R.Get<double>());  break;
-		case Instruction::LessEq:    R = Variant(L.Get<double>() <= R.Get<double>()); break;
-		case Instruction::Greater:   R = Variant(L.Get<double>() > R.Get<double>());  break;
-		case Instruction::GreaterEq: R = Variant(L.Get<double>() >= R.Get<double>()); break;
+		case Instruction::Subtract:  R = NumericOperation(L, R, [](auto l, auto r) { return double(l) - double(r); }); break;
+		case Instruction::Multiply:  R = NumericOperation(L, R, [](auto l, auto r) { return double(l) * double(r); }); break;
+		case Instruction::Divide:    R = NumericOperation(L, R, [](auto l, auto r) { return double(l) / double(r); }); break;
+		case Instruction::Not:       R = Variant(!R.Get<bool>());                                                      break;
+		case Instruction::And:       R = Variant(L.Get<bool>() && R.Get<bool>());                                      break;
+		case Instruction::Or:        R = Variant(L.Get<bool>() || R.Get<bool>());                                      break;
+		case Instruction::Less:      R = NumericOperation(L, R, [](auto l, auto r) { return l < r; });                 break;
+		case Instruction::LessEq:    R = NumericOperation(L, R, [](auto l, auto r) { return l <= r; });                break;
+		case Instruction::Greater:   R = NumericOperation(L, R, [](auto l, auto r) { return l > r; });                 break;
+		case Instruction::GreaterEq: R = NumericOperation(L, R, [](auto l, auto r) { return l >= r; });                break;
 			// clang-format on
 		case Instruction::Equal:
 		{
-			if (AnyString(L, R))
+			if (BothStrings(L, R))
+				R = Variant(L.GetReference<String>() == R.GetReference<String>());
+			else if (AnyString(L, R))
 				R = Variant(L.Get<String>() == R.Get<String>());
 			else
-				R = Variant(L.Get<double>() == R.Get<double>());
+				R = NumericOperation(L, R, [](auto l, auto r) { return l == r; });
 		}
 		break;
 		case Instruction::NotEqual:
 		{
-			if (AnyString(L, R))
+			if (BothStrings(L, R))
+				R = Variant(L.GetReference<String>() != R.GetReference<String>());
+			else if (AnyString(L, R))
 				R = Variant(L.Get<String>() != R.Get<String>());
 			else
-				R = Variant(L.Get<double>() != R.Get<double>());
+				R = NumericOperation(L, R, [](auto l, auto r) { return l != r; });
 		}
 		break;
 		case Instruction::NumArguments:
@@ -1093,9 +1146,9 @@ private:
 		case Instruction::Assign:
 		{
 			size_t variable_index = size_t(data.Get<int>(-1));
-			if (variable_index < addresses.size())
+			if (variable_index < addresses.size() && variable_index < accessors.size())
 			{
-				if (!expression_interface.SetValue(addresses[variable_index], R))
+				if (!expression_interface.SetValue(accessors[variable_index], addresses[variable_index], R))
 					return Error("Could not assign to variable.");
 			}
 			else
@@ -1143,25 +1196,96 @@ private:
 	}
 };
 
+bool DataParser::FoldConstants(const Instruction instruction)
+{
+	size_t num_operands = 0;
+	switch (instruction)
+	{
+	case Instruction::Not: num_operands = 1; break;
+	case Instruction::Add:
+	case Instruction::Subtract:
+	case Instruction::Multiply:
+	case Instruction::Divide:
+	case Instruction::And:
+	case Instruction::Or:
+	case Instruction::Less:
+	case Instruction::LessEq:
+	case Instruction::Greater:
+	case Instruction::GreaterEq:
+	case Instruction::Equal:
+	case Instruction::NotEqual: num_operands = 2; break;
+	default: return false;
+	}
+
+	// Binary operations on literals are emitted as [Literal, MoveToL, Literal], and unary operations as [Literal].
+	const size_t num_instructions = (num_operands == 2 ? 3 : 1);
+	if (program.size() < num_instructions)
+		return false;
+
+	const size_t first = program.size() - num_instructions;
+	if (first < jump_target_barrier)
+		return false;
+	if (program[first].instruction != Instruction::Literal)
+		return false;
+	if (num_operands == 2 && (program[first + 1].instruction != Instruction::MoveToL || program[first + 2].instruction != Instruction::Literal))
+		return false;
+
+	Program constant_program(program.begin() + first, program.end());
+	constant_program.push_back(InstructionData{instruction, Variant()});
+
+	const AddressList no_addresses;
+	const AccessorList no_accessors;
+	DataInterpreter interpreter(constant_program, no_addresses, no_accessors, DataExpressionInterface());
+	if (!interpreter.Run())
+		return false;
+
+	program.resize(first);
+	program.push_back(InstructionData{Instruction::Literal, interpreter.Result()});
+	return true;
+}
+
 DataExpression::DataExpression(String expression) : expression(std::move(expression)) {}
 
 DataExpression::~DataExpression() {}
 
 bool DataExpression::Parse(const DataExpressionInterface& expression_interface, bool is_assignment_expression)
 {
-	DataParser parser(expression, expression_interface);
-	if (!parser.Parse(is_assignment_expression))
-		return false;
+	program = expression_interface.GetProgram(expression, is_assignment_expression);
+	if (!program)
+	{
+		DataParser parser(expression);
+		if (!parser.Parse(is_assignment_expression))
+			return false;
 
-	program = parser.ReleaseProgram();
-	addresses = parser.ReleaseAddresses();
+		program = parser.ReleaseProgram();
+		expression_interface.AddProgram(expression, is_assignment_expression, program);
+	}
 
-	return true;
+	// The program is shared, but its variables are resolved in the scope of the current element.
+	bool result = true;
+	addresses.clear();
+	addresses.reserve(program->variables.size());
+	accessors.clear();
+	accessors.reserve(program->variables.size());
+	for (const DataExpressionProgram::Variable& variable : program->variables)
+	{
+		DataAddress address = expression_interface.ParseAddress(variable.name);
+		if (address.empty() && variable.is_referenced)
+		{
+			LogExpressionError(expression, variable.index, CreateString("Could not find data variable with name '%s'.", variable.name.c_str()));
+			result = false;
+		}
+		accessors.push_back(expression_interface.CompileAddress(address));
+		addresses.push_back(std::move(address));
+	}
+
+	return result;
 }
 
 bool DataExpression::Run(const DataExpressionInterface& expression_interface, Variant& out_value)
 {
-	DataInterpreter interpreter(program, addresses, expression_interface);
+	RMLUI_ASSERT(program);
+	DataInterpreter interpreter(program->program, addresses, accessors, expression_interface);
 
 	if (!interpreter.Run())
 		return false;
@@ -1186,6 +1310,17 @@ DataExpressionInterface::DataExpressionInterface(DataModel* data_model, Element*
 	data_model(data_model), element(element), event(event)
 {}
 
+SharedPtr<const DataExpressionProgram> DataExpressionInterface::GetProgram(const String& expression, bool is_assignment_expression) const
+{
+	return data_model ? data_model->GetExpressionProgram(expression, is_assignment_expression) : nullptr;
+}
+
+void DataExpressionInterface::AddProgram(const String& expression, bool is_assignment_expression, SharedPtr<const DataExpressionProgram> program) const
+{
+	if (data_model)
+		data_model->AddExpressionProgram(expression, is_assignment_expression, std::move(program));
+}
+
 DataAddress DataExpressionInterface::ParseAddress(const String& address_str) const
 {
 	if (address_str.size() >= 4 && address_str[0] == 'e' && address_str[1] == 'v' && address_str[2] == '.')
@@ -1193,6 +1328,15 @@ DataAddress DataExpressionInterface::ParseAddress(const String& address_str) con
 
 	return data_model ? data_model->ResolveAddress(address_str, element) : DataAddress();
 }
+DataAccessor DataExpressionInterface::CompileAddress(const DataAddress& address) const
+{
+	// Event parameters are looked up by name when accessed, leave their accessor empty.
+	if (!data_model || (address.size() == 2 && address.front().name == "ev"))
+		return DataAccessor();
+
+	return data_model->CompileAddress(address);
+}
+
 Variant DataExpressionInterface::GetValue(const DataAddress& address) const
 {
 	Variant result;
@@ -1210,6 +1354,21 @@ Variant DataExpressionInterface::GetValue(const DataAddress& address) const
 	return result;
 }
 
+Variant DataExpressionInterface::GetValue(const DataAccessor& accessor, const DataAddress& address) const
+{
+	if (!accessor.root)
+		return GetValue(address);
+
+	Variant result;
+	DataVariable variable = data_model->GetVariable(accessor);
+	if (!variable || !variable.Get(result))
+	{
+		// Take the slow path for reporting the error.
+		data_model->GetVariableInto(address, result);
+	}
+	return result;
+}
+
 bool DataExpressionInterface::SetValue(const DataAddress& address, const Variant& value) const
 {
 	bool result = false;
@@ -1219,11 +1378,25 @@ bool DataExpressionInterface::SetValue(const DataAddress& address, const Variant
 			result = variable.Set(value);
 
 		if (result)
-			data_model->DirtyVariable(address.front().name);
+			data_model->DirtyVariable(address);
 	}
 	return result;
 }
 
+bool DataExpressionInterface::SetValue(const DataAccessor& accessor, const DataAddress& address, const Variant& value) const
+{
+	if (!accessor.root)
+		return SetValue(address, value);
+
+	bool result = false;
+	if (DataVariable variable = data_model->GetVariable(accessor))
+		result = variable.Set(value);
+
+	if (result)
+		data_model->DirtyVariable(address);
+	return result;
+}
+
 bool DataExpressionInterface::CallTransform(const String& name, const VariantList& arguments, Variant& out_result)
 {
 	return data_model ? data_model->CallTransform(name, arguments, out_result) : false;
@@ -30,6 +30,7 @@
 #define RMLUI_CORE_DATAEXPRESSION_H
 
 #include "../../Include/RmlUi/Core/DataTypes.h"
+#include "../../Include/RmlUi/Core/DataVariable.h"
 #include "../../Include/RmlUi/Core/Header.h"
 #include "../../Include/RmlUi/Core/Types.h"
 
@@ -41,14 +42,50 @@ struct InstructionData;
 using Program = Vector<InstructionData>;
 using AddressList = Vector<DataAddress>;
 
+// A parsed data expression. Variables are referred to by name, so that the program can be shared by all elements using the
+// same expression, while the variable addresses are resolved separately in the scope of each element.
+struct DataExpressionProgram {
+	struct Variable {
+		String name;
+		// Position in the expression, for error messages.
+		size_t index;
+		// False if the variable is only a dependency of the expression, which is not referred to by the program itself.
+		bool is_referenced;
+	};
+
+	Program program;
+	Vector<Variable> variables;
+};
+
+// A data address compiled for repeated access. The top-level variable and any struct members along the address are resolved
+// once, while array elements and pointers are followed on every access. Thus, the accessor stays valid as the data changes.
+struct DataAccessor {
+	struct Step {
+		DataAddressEntry entry;
+		// When the parent variable is of this struct definition, the child is the given member at the parent's pointer.
+		VariableDefinition* struct_definition;
+		VariableDefinition* member_definition;
+	};
+
+	DataVariable root;
+	Vector<Step> steps;
+};
+using AccessorList = Vector<DataAccessor>;
+
 class DataExpressionInterface {
 public:
 	DataExpressionInterface() = default;
 	DataExpressionInterface(DataModel* data_model, Element* element, Event* event = nullptr);
 
+	SharedPtr<const DataExpressionProgram> GetProgram(const String& expression, bool is_assignment_expression) const;
+	void AddProgram(const String& expression, bool is_assignment_expression, SharedPtr<const DataExpressionProgram> program) const;
+
 	DataAddress ParseAddress(const String& address_str) const;
+	DataAccessor CompileAddress(const DataAddress& address) const;
 	Variant GetValue(const DataAddress& address) const;
+	Variant GetValue(const DataAccessor& accessor, const DataAddress& address) const;
 	bool SetValue(const DataAddress& address, const Variant& value) const;
+	bool SetValue(const DataAccessor& accessor, const DataAddress& address, const Variant& value) const;
 	bool CallTransform(const String& name, const VariantList& arguments, Variant& out_result);
 	bool EventCallback(const String& name, const VariantList& arguments);
 
@@ -69,12 +106,14 @@ public:
 
 	// Available after Parse()
 	StringList GetVariableNameList() const;
+	const AddressList& GetVariableAddressList() const { return addresses; }
 
 private:
 	String expression;
 
-	Program program;
+	SharedPtr<const DataExpressionProgram> program;
 	AddressList addresses;
+	AccessorList accessors;
 };
 
 } // namespace Rml
@@ -28,9 +28,13 @@
 
 #include "DataModel.h"
 #include "../../Include/RmlUi/Core/DataTypeRegister.h"
+#include "../../Include/RmlUi/Core/Core.h"
 #include "../../Include/RmlUi/Core/Element.h"
+#include "../../Include/RmlUi/Core/SystemInterface.h"
 #include "DataController.h"
+#include "DataExpression.h"
 #include "DataView.h"
+#include <algorithm>
 
 namespace Rml {
 
@@ -207,6 +211,17 @@ bool DataModel::BindEventCallback(const String& name, DataEventFunc event_func)
 	return true;
 }
 
+String DataModel::BindInternalVariable(Element* element, DataVariable variable)
+{
+	RMLUI_ASSERT(element && variable);
+
+	// Internal variables use a prefix which is not allowed in user variable names.
+	String name = "#" + ToString(num_internal_variables_bound++);
+	variables.emplace(name, variable);
+	internal_variables[element].push_back(name);
+	return name;
+}
+
 bool DataModel::InsertAlias(Element* element, const String& alias_name, DataAddress replace_with_address)
 {
 	if (replace_with_address.empty() || replace_with_address.front().name.empty())
@@ -346,17 +361,119 @@ bool DataModel::GetVariableInto(const DataAddress& address, Variant& out_value)
 	return result;
 }
 
+DataAccessor DataModel::CompileAddress(const DataAddress& address) const
+{
+	DataAccessor accessor;
+	if (address.empty())
+		return accessor;
+
+	auto it = variables.find(address.front().name);
+	if (it == variables.end())
+	{
+		// Literals are constant, thus they can be resolved completely.
+		accessor.root = GetVariable(address);
+		return accessor;
+	}
+
+	accessor.root = it->second;
+	accessor.steps.reserve(address.size() - 1);
+
+	DataVariable variable = accessor.root;
+	for (size_t i = 1; i < address.size(); i++)
+	{
+		const DataAddressEntry& entry = address[i];
+		DataAccessor::Step step = {entry, nullptr, nullptr};
+
+		if (variable && entry.index < 0)
+		{
+			if (VariableDefinition* member_definition = variable.definition->GetStructMember(entry.name))
+			{
+				step.struct_definition = variable.definition;
+				step.member_definition = member_definition;
+			}
+		}
+
+		// Stop resolving ahead at indices which are currently out of bounds, the array may be filled before the accessor is used.
+		if (variable && entry.index >= 0 && (variable.Type() != DataVariableType::Array || entry.index >= variable.Size()))
+			variable = DataVariable();
+
+		if (variable)
+			variable = variable.Child(entry);
+		accessor.steps.push_back(std::move(step));
+	}
+
+	return accessor;
+}
+
+DataVariable DataModel::GetVariable(const DataAccessor& accessor) const
+{
+	DataVariable variable = accessor.root;
+	for (const DataAccessor::Step& step : accessor.steps)
+	{
+		if (!variable)
+			break;
+
+		if (step.struct_definition && variable.definition == step.struct_definition)
+			variable = DataVariable(step.member_definition, variable.ptr);
+		else
+			variable = variable.Child(step.entry);
+	}
+	return variable;
+}
+
 void DataModel::DirtyVariable(const String& variable_name)
 {
-	RMLUI_ASSERTMSG(LegalVariableName(variable_name) == nullptr, "Illegal variable name provided. Only top-level variables can be dirtied.");
+	RMLUI_ASSERTMSG(LegalVariableName(variable_name) == nullptr || variable_name[0] == '#',
+		"Illegal variable name provided. Only top-level variables can be dirtied.");
 	RMLUI_ASSERTMSG(variables.count(variable_name) == 1, "In DirtyVariable: Variable name not found among added variables.");
 	dirty_variables.emplace(variable_name);
 }
 
+void DataModel::DirtyVariable(const DataAddress& address)
+{
+	RMLUI_ASSERT(!address.empty());
+	if (address.size() == 1)
+	{
+		DirtyVariable(address.front().name);
+		return;
+	}
+
+	RMLUI_ASSERTMSG(variables.count(address.front().name) == 1, "In DirtyVariable: Variable name not found among added variables.");
+	dirty_addresses.push_back(address);
+}
+
 bool DataModel::IsVariableDirty(const String& variable_name) const
 {
-	RMLUI_ASSERTMSG(LegalVariableName(variable_name) == nullptr, "Illegal variable name provided. Only top-level variables can be dirtied.");
-	return dirty_variables.count(variable_name) == 1;
+	RMLUI_ASSERTMSG(LegalVariableName(variable_name) == nullptr || variable_name[0] == '#',
+		"Illegal variable name provided. Only top-level variables can be dirtied.");
+	if (dirty_variables.count(variable_name) == 1)
+		return true;
+	return std::any_of(dirty_addresses.begin(), dirty_addresses.end(),
+		[&](const DataAddress& address) { return address.front().name == variable_name; });
+}
+
+bool DataModel::GetDirtyAddresses(const DataAddress& address, Vector<DataAddress>& out_dirty_addresses) const
+{
+	RMLUI_ASSERT(!address.empty());
+	if (dirty_variables.count(address.front().name) == 1)
+		return true;
+
+	for (const DataAddress& dirty_address : dirty_addresses)
+	{
+		const size_t common_size = std::min(address.size(), dirty_address.size());
+		bool is_common = true;
+		for (size_t i = 0; i < common_size && is_common; i++)
+			is_common = (address[i].index == dirty_address[i].index && address[i].name == dirty_address[i].name);
+
+		if (!is_common)
+			continue;
+		if (dirty_address.size() <= address.size())
+			return true;
+
+		out_dirty_addresses.push_back(dirty_address);
+	}
+
+	return false;
 }
 
 void DataModel::DirtyAllVariables()
@@ -368,6 +485,60 @@ void DataModel::DirtyAllVariables()
 	}
 }
 
+void DataModel::EnableChangeDetection(int max_checks_per_update, double min_interval)
+{
+	RMLUI_ASSERT(max_checks_per_update > 0);
+	change_detection = true;
+	change_detection_max_checks = max_checks_per_update;
+	change_detection_interval = min_interval;
+	views->EnableChangeDetection(*this);
+}
+
+void DataModel::DisableChangeDetection()
+{
+	change_detection = false;
+	change_detection_pass_active = false;
+	views->DisableChangeDetection();
+}
+
+DataVariable DataModel::FindVariable(const DataAddress& address) const
+{
+	auto it = variables.find(address.front().name);
+	if (it == variables.end())
+		return DataVariable();
+
+	DataVariable variable = it->second;
+	for (size_t i = 1; i < address.size(); i++)
+	{
+		// Array elements may have been removed since the address was resolved.
+		const DataAddressEntry& entry = address[i];
+		if (entry.index >= 0 && (variable.Type() != DataVariableType::Array || entry.index >= variable.Size()))
+			return DataVariable();
+
+		variable = variable.Child(entry);
+		if (!variable)
+			return DataVariable();
+	}
+
+	return variable;
+}
+
+Variant DataModel::GetSnapshotValue(const DataAddress& address) const
+{
+	DataVariable variable = FindVariable(address);
+	if (!variable)
+		return Variant();
+
+	Variant result;
+	switch (variable.Type())
+	{
+	case DataVariableType::Scalar: variable.Get(result); break;
+	case DataVariableType::Array: result = variable.Size(); break;
+	case DataVariableType::Struct: break;
+	}
+	return result;
+}
+
 bool DataModel::CallTransform(const String& name, const VariantList& arguments, Variant& out_result) const
 {
 	if (const auto transform_register = data_type_register->GetTransformFuncRegister())
@@ -375,6 +546,21 @@ bool DataModel::CallTransform(const String& name, const VariantList& arguments,
 	return false;
 }
 
+SharedPtr<const DataExpressionProgram> DataModel::GetExpressionProgram(const String& expression, bool is_assignment_expression) const
+{
+	const ExpressionPrograms& programs = (is_assignment_expression ? assignment_expression_programs : expression_programs);
+	auto it = programs.find(expression);
+	if (it != programs.end())
+		return it->second;
+	return nullptr;
+}
+
+void DataModel::AddExpressionProgram(const String& expression, bool is_assignment_expression, SharedPtr<const DataExpressionProgram> program)
+{
+	ExpressionPrograms& programs = (is_assignment_expression ? assignment_expression_programs : expression_programs);
+	programs[expression] = std::move(program);
+}
+
 void DataModel::AttachModelRootElement(Element* element)
 {
 	attached_elements.insert(element);
@@ -388,6 +574,18 @@ ElementList DataModel::GetAttachedModelRootElements() const
 void DataModel::OnElementRemove(Element* element)
 {
 	EraseAliases(element);
+
+	auto it_internal = internal_variables.find(element);
+	if (it_internal != internal_variables.end())
+	{
+		for (const String& name : it_internal->second)
+		{
+			variables.erase(name);
+			views->OnVariableErase(name);
+		}
+		internal_variables.erase(it_internal);
+	}
+
 	views->OnElementRemove(element);
 	controllers->OnElementRemove(element);
 	attached_elements.erase(element);
@@ -395,12 +593,37 @@ void DataModel::OnElementRemove(Element* element)
 
 bool DataModel::Update(bool clear_dirty_variables)
 {
-	const bool result = views->Update(*this, dirty_variables);
+	if (change_detection)
+	{
+		// Each pass over the snapshots may be spread across several updates, new passes are started no more often than the interval.
+		if (!change_detection_pass_active)
+		{
+			const double time = GetSystemInterface()->GetElapsedTime();
+			if (time >= change_detection_next_pass)
+			{
+				change_detection_pass_active = true;
+				change_detection_next_pass = time + change_detection_interval;
+			}
+		}
+
+		if (change_detection_pass_active && views->DetectChanges(*this, change_detection_max_checks))
+			change_detection_pass_active = false;
+	}
+
+	const bool result = views->Update(*this, dirty_variables, dirty_addresses);
 
 	if (clear_dirty_variables)
+	{
 		dirty_variables.clear();
+		dirty_addresses.clear();
+	}
 
 	return result;
 }
 
+size_t DataModel::GetNumViewAddressNodes() const
+{
+	return views->GetNumAddressNodes();
+}
+
 } // namespace Rml
@@ -42,6 +42,8 @@ class DataControllers;
 class DataVariable;
 class Element;
 class FuncDefinition;
+struct DataAccessor;
+struct DataExpressionProgram;
 
 class DataModel : NonCopyMoveable {
 public:
@@ -56,6 +58,11 @@ public:
 
 	bool BindEventCallback(const String& name, DataEventFunc event_func);
 
+	// Binds a variable under a generated name which cannot collide with any user variables, and returns the name. Used by
+	// data views which need to expose their own state to the elements they generate. The variable is unbound when the
+	// given element is removed from the data model.
+	String BindInternalVariable(Element* element, DataVariable variable);
+
 	bool InsertAlias(Element* element, const String& alias_name, DataAddress replace_with_address);
 	bool EraseAliases(Element* element);
 	void CopyAliases(Element* source_element, Element* target_element);
@@ -64,14 +71,37 @@ public:
 	const DataEventFunc* GetEventCallback(const String& name);
 
 	DataVariable GetVariable(const DataAddress& address) const;
+	// Returns the variable at the given address, or an empty variable if it no longer exists. Unlike GetVariable(), no warnings are emitted.
+	DataVariable FindVariable(const DataAddress& address) const;
 	bool GetVariableInto(const DataAddress& address, Variant& out_value) const;
 
+	// Compiles the address for repeated access, the accessor evaluates to the same variable as the address.
+	DataAccessor CompileAddress(const DataAddress& address) const;
+	DataVariable GetVariable(const DataAccessor& accessor) const;
+
 	void DirtyVariable(const String& variable_name);
+	void DirtyVariable(const DataAddress& address);
+	// Returns true if the variable, or any part of it, is dirty.
 	bool IsVariableDirty(const String& variable_name) const;
+	// Returns true if the given address is dirty as a whole, either by itself or through any of its parents. Otherwise, appends any
+	// dirty addresses which extend the given address.
+	bool GetDirtyAddresses(const DataAddress& address, Vector<DataAddress>& out_dirty_addresses) const;
 	void DirtyAllVariables();
 
+	// Automatically dirties the addresses used by data views whose values change, see DataModelHandle::EnableChangeDetection().
+	void EnableChangeDetection(int max_checks_per_update, double min_interval);
+	void DisableChangeDetection();
+
+	// Returns a copy of the value at the given address for change detection, scalars by value and arrays by their size.
+	// Unlike GetVariable(), no warnings are emitted for addresses which no longer exist.
+	Variant GetSnapshotValue(const DataAddress& address) const;
+
 	bool CallTransform(const String& name, const VariantList& arguments, Variant& out_result) const;
 
+	// Parsed data expressions are shared by all views and controllers of the model using the same expression string.
+	SharedPtr<const DataExpressionProgram> GetExpressionProgram(const String& expression, bool is_assignment_expression) const;
+	void AddExpressionProgram(const String& expression, bool is_assignment_expression, SharedPtr<const DataExpressionProgram> program);
+
 	// Elements declaring 'data-model' need to be attached.
 	void AttachModelRootElement(Element* element);
 	ElementList GetAttachedModelRootElements() const;
@@ -80,6 +110,9 @@ public:
 
 	bool Update(bool clear_dirty_variables);
 
+	// Returns the number of nodes in the tree of addresses the data views of this model depend on.
+	size_t GetNumViewAddressNodes() const;
+
 	inline DataTypeRegister* GetDataTypeRegister() const { return data_type_register; }
 
 private:
@@ -88,6 +121,7 @@ private:
 
 	UnorderedMap<String, DataVariable> variables;
 	DirtyVariables dirty_variables;
+	Vector<DataAddress> dirty_addresses;
 
 	UnorderedMap<String, UniquePtr<FuncDefinition>> function_variable_definitions;
 	UnorderedMap<String, DataEventFunc> event_callbacks;
@@ -98,6 +132,19 @@ private:
 	DataTypeRegister* data_type_register;
 
 	SmallUnorderedSet<Element*> attached_elements;
+
+	UnorderedMap<Element*, StringList> internal_variables;
+	int num_internal_variables_bound = 0;
+
+	bool change_detection = false;
+	bool change_detection_pass_active = false;
+	int change_detection_max_checks = 0;
+	double change_detection_interval = 0.0;
+	double change_detection_next_pass = 0.0;
+
+	using ExpressionPrograms = UnorderedMap<String, SharedPtr<const DataExpressionProgram>>;
+	ExpressionPrograms expression_programs;
+	ExpressionPrograms assignment_expression_programs;
 };
 
 } // namespace Rml
@@ -43,11 +43,26 @@ void DataModelHandle::DirtyVariable(const String& variable_name)
 	model->DirtyVariable(variable_name);
 }
 
+void DataModelHandle::DirtyVariable(const DataAddress& address)
+{
+	model->DirtyVariable(address);
+}
+
 void DataModelHandle::DirtyAllVariables()
 {
 	model->DirtyAllVariables();
 }
 
+void DataModelHandle::EnableChangeDetection(int max_checks_per_update, double min_interval)
+{
+	model->EnableChangeDetection(max_checks_per_update, min_interval);
+}
+
+void DataModelHandle::DisableChangeDetection()
+{
+	model->DisableChangeDetection();
+}
+
 DataModelConstructor::DataModelConstructor() : model(nullptr), type_register(nullptr) {}
 
 DataModelConstructor::DataModelConstructor(DataModel* model) : model(model), type_register(model->GetDataTypeRegister())
@@ -75,6 +75,10 @@ DataVariable VariableDefinition::Child(void* /*ptr*/, const DataAddressEntry& /*
 	Log::Message(Log::LT_WARNING, "Tried to get the child of a scalar type.");
 	return DataVariable();
 }
+VariableDefinition* VariableDefinition::GetStructMember(const String& /*name*/)
+{
+	return nullptr;
+}
 
 class LiteralIntDefinition final : public VariableDefinition {
 public:
@@ -116,6 +120,12 @@ DataVariable StructDefinition::Child(void* ptr, const DataAddressEntry& address)
 	return DataVariable(next_definition, ptr);
 }
 
+VariableDefinition* StructDefinition::GetStructMember(const String& name)
+{
+	auto it = members.find(name);
+	return it != members.end() ? it->second.get() : nullptr;
+}
+
 void StructDefinition::AddMember(const String& name, UniquePtr<VariableDefinition> member)
 {
 	RMLUI_ASSERT(member);
@@ -28,6 +28,7 @@
 
 #include "DataView.h"
 #include "../../Include/RmlUi/Core/Element.h"
+#include "DataModel.h"
 #include <algorithm>
 
 namespace Rml {
@@ -52,6 +53,14 @@ bool DataView::IsValid() const
 	return static_cast<bool>(attached_element);
 }
 
+Vector<DataAddress> DataView::GetVariableAddressList() const
+{
+	Vector<DataAddress> result;
+	for (String& name : GetVariableNameList())
+		result.push_back(DataAddress{DataAddressEntry(std::move(name))});
+	return result;
+}
+
 DataView::DataView(Element* element, int bias) : attached_element(element->GetObserverPtr()), sort_order(bias + 1000)
 {
 	RMLUI_ASSERT(bias >= -1000 && bias <= 999);
@@ -87,17 +96,22 @@ void DataViews::OnElementRemove(Element* element)
 	}
 }
 
-bool DataViews::Update(DataModel& model, const DirtyVariables& dirty_variables)
+bool DataViews::Update(DataModel& model, const DirtyVariables& dirty_variables, const Vector<DataAddress>& dirty_addresses)
 {
 	bool result = false;
 	size_t num_dirty_variables_prev = 0;
+	size_t num_dirty_addresses_prev = 0;
 
 	// View updates may result in newly added views, or even new dirty variables. Thus, we do the
 	// update recursively but with an upper limit. Without the loop, newly added views won't be
 	// updated until the next Update() call.
-	for (int i = 0; (i == 0 || !views_to_add.empty() || num_dirty_variables_prev != dirty_variables.size()) && i < 10; i++)
+	for (int i = 0;
+		 (i == 0 || !views_to_add.empty() || num_dirty_variables_prev != dirty_variables.size() || num_dirty_addresses_prev != dirty_addresses.size()) &&
+		 i < 10;
+		 i++)
 	{
 		num_dirty_variables_prev = dirty_variables.size();
+		num_dirty_addresses_prev = dirty_addresses.size();
 
 		Vector<DataView*> dirty_views;
 
@@ -107,19 +121,20 @@ bool DataViews::Update(DataModel& model, const DirtyVariables& dirty_variables)
 			for (auto&& view : views_to_add)
 			{
 				dirty_views.push_back(view.get());
-				for (const String& variable_name : view->GetVariableNameList())
-					name_view_map.emplace(variable_name, view.get());
-
+				InsertView(model, view.get());
 				views.push_back(std::move(view));
 			}
 			views_to_add.clear();
 		}
 
 		for (const String& variable_name : dirty_variables)
+			CollectDirtyViews(DataAddress{DataAddressEntry(variable_name)}, dirty_views);
+
+		for (const DataAddress& address : dirty_addresses)
 		{
-			auto pair = name_view_map.equal_range(variable_name);
-			for (auto it = pair.first; it != pair.second; ++it)
-				dirty_views.push_back(it->second);
+			// Already covered when the whole variable is dirty.
+			if (dirty_variables.count(address.front().name) == 0)
+				CollectDirtyViews(address, dirty_views);
 		}
 
 		// Remove duplicate entries
@@ -142,25 +157,325 @@ bool DataViews::Update(DataModel& model, const DirtyVariables& dirty_variables)
 		}
 
 		// Destroy views marked for destruction
-		// @performance: Horrible...
 		if (!views_to_remove.empty())
 		{
 			for (const auto& view : views_to_remove)
+				EraseView(view.get());
+
+			views_to_remove.clear();
+		}
+	}
+
+	// The dirty values have now been seen by their views, so change detection should not dirty them again.
+	if (change_detection)
+	{
+		for (const String& variable_name : dirty_variables)
+			RefreshSnapshots(model, DataAddress{DataAddressEntry(variable_name)});
+
+		for (const DataAddress& address : dirty_addresses)
+		{
+			if (dirty_variables.count(address.front().name) == 0)
+				RefreshSnapshots(model, address);
+		}
+	}
+
+	return result;
+}
+
+void DataViews::InsertView(const DataModel& model, DataView* view)
+{
+	Vector<AddressNode*>& nodes = view_nodes[view];
+
+	for (const DataAddress& address : view->GetVariableAddressList())
+	{
+		AddressNode* node = &root_node;
+		for (const DataAddressEntry& entry : address)
+		{
+			UniquePtr<AddressNode>& child = (entry.index < 0 ? node->members[entry.name] : node->indices[entry.index]);
+			if (!child)
 			{
-				for (auto it = name_view_map.begin(); it != name_view_map.end();)
-				{
-					if (it->second == view.get())
-						it = name_view_map.erase(it);
-					else
-						++it;
-				}
+				child = MakeUnique<AddressNode>();
+				child->parent = node;
+				child->name = entry.name;
+				child->index = entry.index;
 			}
+			node = child.get();
+		}
 
-			views_to_remove.clear();
+		if (node != &root_node)
+		{
+			node->views.push_back(view);
+			nodes.push_back(node);
+
+			if (change_detection && node->snapshot_index == NoSnapshot)
+				AddSnapshot(model, node, address);
 		}
 	}
+}
+
+void DataViews::EraseView(DataView* view)
+{
+	auto it = view_nodes.find(view);
+	if (it == view_nodes.end())
+		return;
+
+	Vector<AddressNode*> nodes = std::move(it->second);
+	view_nodes.erase(it);
 
+	for (AddressNode* node : nodes)
+		node->views.erase(std::remove(node->views.begin(), node->views.end(), view), node->views.end());
+
+	// Nodes may be listed several times, and pruning one node may remove others listed after it.
+	for (size_t i = 0; i < nodes.size(); i++)
+	{
+		if (AddressNode* node = nodes[i])
+		{
+			nodes[i] = nullptr;
+			PruneNode(node, nodes);
+		}
+	}
+}
+
+void DataViews::PruneNode(AddressNode* node, Vector<AddressNode*>& pending_nodes)
+{
+	while (node != &root_node && node->views.empty() && node->members.empty() && node->indices.empty())
+	{
+		if (node->snapshot_index != NoSnapshot)
+			RemoveSnapshot(node->snapshot_index);
+
+		std::replace(pending_nodes.begin(), pending_nodes.end(), node, (AddressNode*)nullptr);
+
+		AddressNode* parent = node->parent;
+		if (node->index < 0)
+			parent->members.erase(node->name);
+		else
+			parent->indices.erase(node->index);
+		node = parent;
+	}
+}
+
+size_t DataViews::GetNumAddressNodes() const
+{
+	return CountNodesRecursive(root_node) - 1;
+}
+
+size_t DataViews::CountNodesRecursive(const AddressNode& node)
+{
+	size_t result = 1;
+	for (const auto& member : node.members)
+		result += CountNodesRecursive(*member.second);
+	for (const auto& index : node.indices)
+		result += CountNodesRecursive(*index.second);
 	return result;
 }
 
+void DataViews::CollectDirtyViews(const DataAddress& address, Vector<DataView*>& dirty_views) const
+{
+	const AddressNode* node = &root_node;
+	for (size_t i = 0; i < address.size(); i++)
+	{
+		const DataAddressEntry& entry = address[i];
+		if (entry.index < 0)
+		{
+			auto it = node->members.find(entry.name);
+			node = (it != node->members.end() ? it->second.get() : nullptr);
+		}
+		else
+		{
+			auto it = node->indices.find(entry.index);
+			node = (it != node->indices.end() ? it->second.get() : nullptr);
+		}
+
+		if (!node)
+			return;
+
+		// Views depending on a parent of the address, such as the whole container of a dirty array element.
+		if (i + 1 < address.size())
+			dirty_views.insert(dirty_views.end(), node->views.begin(), node->views.end());
+	}
+
+	CollectViewsRecursive(*node, dirty_views);
+}
+
+void DataViews::CollectViewsRecursive(const AddressNode& node, Vector<DataView*>& dirty_views)
+{
+	dirty_views.insert(dirty_views.end(), node.views.begin(), node.views.end());
+	for (const auto& member : node.members)
+		CollectViewsRecursive(*member.second, dirty_views);
+	for (const auto& index : node.indices)
+		CollectViewsRecursive(*index.second, dirty_views);
+}
+
+void DataViews::EnableChangeDetection(const DataModel& model)
+{
+	if (change_detection)
+		return;
+
+	change_detection = true;
+	DataAddress address;
+	AddSnapshotsRecursive(model, &root_node, address);
+}
+
+void DataViews::DisableChangeDetection()
+{
+	change_detection = false;
+	snapshots.clear();
+	next_snapshot = 0;
+	ClearSnapshotsRecursive(&root_node);
+}
+
+bool DataViews::DetectChanges(DataModel& model, int max_checks)
+{
+	for (int i = 0; i < max_checks && next_snapshot < snapshots.size();)
+	{
+		Snapshot& snapshot = snapshots[next_snapshot];
+
+		// Drop the snapshot once no views depend on its address anymore.
+		if (snapshot.node->views.empty())
+		{
+			RemoveSnapshot(next_snapshot);
+			continue;
+		}
+
+		Variant value = model.GetSnapshotValue(snapshot.address);
+		if (!(value == snapshot.value))
+		{
+			snapshot.value = std::move(value);
+			model.DirtyVariable(snapshot.address);
+		}
+
+		next_snapshot++;
+		i++;
+	}
+
+	if (next_snapshot < snapshots.size())
+		return false;
+
+	next_snapshot = 0;
+	return true;
+}
+
+void DataViews::AddSnapshot(const DataModel& model, AddressNode* node, const DataAddress& address)
+{
+	node->snapshot_index = snapshots.size();
+	snapshots.push_back(Snapshot{address, node, model.GetSnapshotValue(address)});
+}
+
+void DataViews::AddSnapshotsRecursive(const DataModel& model, AddressNode* node, DataAddress& address)
+{
+	if (!node->views.empty() && node->snapshot_index == NoSnapshot)
+		AddSnapshot(model, node, address);
+
+	for (auto& member : node->members)
+	{
+		address.push_back(DataAddressEntry(member.first));
+		AddSnapshotsRecursive(model, member.second.get(), address);
+		address.pop_back();
+	}
+	for (auto& index : node->indices)
+	{
+		address.push_back(DataAddressEntry(index.first));
+		AddSnapshotsRecursive(model, index.second.get(), address);
+		address.pop_back();
+	}
+}
+
+void DataViews::OnVariableErase(const String& name)
+{
+	auto it = root_node.members.find(name);
+	if (it != root_node.members.end())
+		RemoveSnapshotsRecursive(it->second.get());
+}
+
+void DataViews::RemoveSnapshot(size_t index)
+{
+	auto MoveSnapshot = [this](size_t from, size_t to) {
+		if (from == to)
+			return;
+		snapshots[to] = std::move(snapshots[from]);
+		snapshots[to].node->snapshot_index = to;
+	};
+
+	RMLUI_ASSERT(index < snapshots.size());
+	snapshots[index].node->snapshot_index = NoSnapshot;
+
+	// Keep the snapshots that have already been checked during the current pass in front of the next snapshot to check.
+	if (index < next_snapshot)
+	{
+		next_snapshot -= 1;
+		MoveSnapshot(next_snapshot, index);
+		index = next_snapshot;
+	}
+
+	MoveSnapshot(snapshots.size() - 1, index);
+	snapshots.pop_back();
+}
+
+void DataViews::RemoveSnapshotsRecursive(AddressNode* node)
+{
+	if (node->snapshot_index != NoSnapshot)
+		RemoveSnapshot(node->snapshot_index);
+	for (auto& member : node->members)
+		RemoveSnapshotsRecursive(member.second.get());
+	for (auto& index : node->indices)
+		RemoveSnapshotsRecursive(index.second.get());
+}
+
+void DataViews::ClearSnapshotsRecursive(AddressNode* node)
+{
+	node->snapshot_index = NoSnapshot;
+	for (auto& member : node->members)
+		ClearSnapshotsRecursive(member.second.get());
+	for (auto& index : node->indices)
+		ClearSnapshotsRecursive(index.second.get());
+}
+
+void DataViews::RefreshSnapshots(const DataModel& model, const DataAddress& address)
+{
+	AddressNode* node = &root_node;
+	DataAddress node_address;
+	node_address.reserve(address.size());
+	for (const DataAddressEntry& entry : address)
+	{
+		if (entry.index < 0)
+		{
+			auto it = node->members.find(entry.name);
+			node = (it != node->members.end() ? it->second.get() : nullptr);
+		}
+		else
+		{
+			auto it = node->indices.find(entry.index);
+			node = (it != node->indices.end() ? it->second.get() : nullptr);
+		}
+
+		if (!node)
+			return;
+
+		node_address.push_back(entry);
+		if (node_address.size() < address.size() && node->snapshot_index != NoSnapshot)
+			snapshots[node->snapshot_index].value = model.GetSnapshotValue(node_address);
+	}
+
+	RefreshSnapshotsRecursive(model, node, node_address);
+}
+
+void DataViews::RefreshSnapshotsRecursive(const DataModel& model, AddressNode* node, DataAddress& address)
+{
+	if (node->snapshot_index != NoSnapshot)
+		snapshots[node->snapshot_index].value = model.GetSnapshotValue(address);
+
+	for (auto& member : node->members)
+	{
+		address.push_back(DataAddressEntry(member.first));
+		RefreshSnapshotsRecursive(model, member.second.get(), address);
+		address.pop_back();
+	}
+	for (auto& index : node->indices)
+	{
+		address.push_back(DataAddressEntry(index.first));
+		RefreshSnapshotsRecursive(model, index.second.get(), address);
+		address.pop_back();
+	}
+}
+
 } // namespace Rml
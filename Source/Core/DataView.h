@@ -33,6 +33,7 @@
 #include "../../Include/RmlUi/Core/Header.h"
 #include "../../Include/RmlUi/Core/Traits.h"
 #include "../../Include/RmlUi/Core/Types.h"
+#include "../../Include/RmlUi/Core/Variant.h"
 
 namespace Rml {
 
@@ -82,6 +83,10 @@ public:
 	// Returns the list of data variable name(s) which can modify this view.
 	virtual StringList GetVariableNameList() const = 0;
 
+	// Returns the list of data addresses which can modify this view, the view is updated whenever any part of the
+	// addresses are dirtied. By default, the view depends on the whole of each variable in the variable name list.
+	virtual Vector<DataAddress> GetVariableAddressList() const;
+
 	// Returns the attached element if it still exists.
 	Element* GetElement() const;
 
@@ -111,10 +116,56 @@ public:
 	void Add(DataViewPtr view);
 
 	void OnElementRemove(Element* element);
+	// Drops the snapshots of all addresses within the given variable, as it is no longer bound to the model.
+	void OnVariableErase(const String& name);
+
+	bool Update(DataModel& model, const DirtyVariables& dirty_variables, const Vector<DataAddress>& dirty_addresses);
+
+	// Change detection takes snapshots of the values at all addresses the views depend on. See DataModel::EnableChangeDetection().
+	void EnableChangeDetection(const DataModel& model);
+	void DisableChangeDetection();
 
-	bool Update(DataModel& model, const DirtyVariables& dirty_variables);
+	// Compares the values at up to 'max_checks' addresses against their snapshots, continuing from where the previous call
+	// left off, and dirties the addresses which have changed. Returns true when all the addresses have been checked.
+	bool DetectChanges(DataModel& model, int max_checks);
+
+	// Returns the number of nodes in the tree of addresses the views depend on.
+	size_t GetNumAddressNodes() const;
 
 private:
+	static constexpr size_t NoSnapshot = size_t(-1);
+
+	// Views are stored in a tree by the addresses they depend on, where each node corresponds to an address entry.
+	struct AddressNode {
+		// The parent node and the entry of this node in it, or null for the root node.
+		AddressNode* parent = nullptr;
+		String name;
+		int index = -1;
+
+		Vector<DataView*> views;
+		UnorderedMap<String, UniquePtr<AddressNode>> members;
+		UnorderedMap<int, UniquePtr<AddressNode>> indices;
+		size_t snapshot_index = NoSnapshot;
+	};
+
+	struct Snapshot {
+		DataAddress address;
+		AddressNode* node;
+		Variant value;
+	};
+
+	void InsertView(const DataModel& model, DataView* view);
+	void EraseView(DataView* view);
+	// Removes the given node and its parents from the tree for as long as they have no views or children. Any nodes removed are also cleared
+	// from the list of pending nodes.
+	void PruneNode(AddressNode* node, Vector<AddressNode*>& pending_nodes);
+	static size_t CountNodesRecursive(const AddressNode& node);
+
+	// Adds all views which may be modified by a change to the given address, that is, all views depending on the address
+	// itself, on any of its children, or on any of its parents.
+	void CollectDirtyViews(const DataAddress& address, Vector<DataView*>& dirty_views) const;
+	static void CollectViewsRecursive(const AddressNode& node, Vector<DataView*>& dirty_views);
+
 	using DataViewList = Vector<DataViewPtr>;
 
 	DataViewList views;
@@ -122,8 +173,21 @@ private:
 	DataViewList views_to_add;
 	DataViewList views_to_remove;
 
-	using NameViewMap = UnorderedMultimap<String, DataView*>;
-	NameViewMap name_view_map;
+	void AddSnapshot(const DataModel& model, AddressNode* node, const DataAddress& address);
+	void AddSnapshotsRecursive(const DataModel& model, AddressNode* node, DataAddress& address);
+	static void ClearSnapshotsRecursive(AddressNode* node);
+	void RemoveSnapshot(size_t index);
+	void RemoveSnapshotsRecursive(AddressNode* node);
+	// Takes new snapshots of the given address, its parents, and its children, as the views depending on them are about to be updated.
+	void RefreshSnapshots(const DataModel& model, const DataAddress& address);
+	void RefreshSnapshotsRecursive(const DataModel& model, AddressNode* node, DataAddress& address);
+
+	AddressNode root_node;
+	UnorderedMap<DataView*, Vector<AddressNode*>> view_nodes;
+
+	bool change_detection = false;
+	Vector<Snapshot> snapshots;
+	size_t next_snapshot = 0;
 };
 
 } // namespace Rml
@@ -27,16 +27,21 @@
  */
 
 #include "DataViewDefault.h"
+#include "../../Include/RmlUi/Core/Context.h"
 #include "../../Include/RmlUi/Core/Core.h"
 #include "../../Include/RmlUi/Core/DataVariable.h"
 #include "../../Include/RmlUi/Core/Element.h"
 #include "../../Include/RmlUi/Core/ElementText.h"
+#include "../../Include/RmlUi/Core/Event.h"
 #include "../../Include/RmlUi/Core/Factory.h"
 #include "../../Include/RmlUi/Core/SystemInterface.h"
 #include "../../Include/RmlUi/Core/Variant.h"
 #include "DataExpression.h"
 #include "DataModel.h"
+#include "Elements/ElementVirtualSpacer.h"
 #include "XMLParseTools.h"
+#include "XMLRecording.h"
+#include <algorithm>
 
 namespace Rml {
 
@@ -69,6 +74,12 @@ StringList DataViewCommon::GetVariableNameList() const
 	return expression->GetVariableNameList();
 }
 
+Vector<DataAddress> DataViewCommon::GetVariableAddressList() const
+{
+	RMLUI_ASSERT(expression);
+	return expression->GetVariableAddressList();
+}
+
 const String& DataViewCommon::GetModifier() const
 {
 	return modifier;
@@ -423,6 +434,21 @@ StringList DataViewText::GetVariableNameList() const
 	return full_list;
 }
 
+Vector<DataAddress> DataViewText::GetVariableAddressList() const
+{
+	Vector<DataAddress> full_list;
+
+	for (const DataEntry& entry : data_entries)
+	{
+		RMLUI_ASSERT(entry.data_expression);
+
+		const AddressList& entry_list = entry.data_expression->GetVariableAddressList();
+		full_list.insert(full_list.end(), entry_list.begin(), entry_list.end());
+	}
+
+	return full_list;
+}
+
 void DataViewText::Release()
 {
 	delete this;
@@ -452,8 +478,52 @@ String DataViewText::BuildText() const
 	return result;
 }
 
+// Number of rows instanced by virtualized views before the row height and viewport have been laid out.
+static constexpr int virtual_initial_rows = 16;
+// Number of rows instanced by virtualized views on each side of the viewport, in addition to the visible rows.
+static constexpr int virtual_overscan_rows = 2;
+
+// Exposes the rows of a virtualized or keyed data-for view to the row elements. Children are addressed by their row number, see
+// DataViewFor, and resolve to the bound container entry. The 'index' member resolves row numbers to entry indices.
+class BoundRowIndexDefinition final : public VariableDefinition {
+public:
+	BoundRowIndexDefinition() : VariableDefinition(DataVariableType::Array) {}
+
+	int Size(void* ptr) override { return static_cast<const DataViewFor*>(ptr)->GetNumBoundRows(); }
+
+	DataVariable Child(void* ptr, const DataAddressEntry& address) override
+	{
+		return MakeLiteralIntVariable(static_cast<const DataViewFor*>(ptr)->GetBoundRowIndex(address.index));
+	}
+};
+
+class BoundRowsDefinition final : public VariableDefinition {
+public:
+	BoundRowsDefinition() : VariableDefinition(DataVariableType::Array) {}
+
+	int Size(void* ptr) override { return static_cast<const DataViewFor*>(ptr)->GetNumBoundRows(); }
+
+	DataVariable Child(void* ptr, const DataAddressEntry& address) override
+	{
+		static BoundRowIndexDefinition row_index_definition;
+		if (address.name == "index")
+			return DataVariable(&row_index_definition, ptr);
+		return static_cast<const DataViewFor*>(ptr)->GetBoundRowVariable(address.index);
+	}
+};
+
 DataViewFor::DataViewFor(Element* element) : DataView(element, 0) {}
 
+DataViewFor::~DataViewFor()
+{
+	if (Element* spacer = leading_spacer.get())
+		rmlui_static_cast<ElementVirtualSpacer*>(spacer)->SetView(nullptr);
+	if (Element* spacer = trailing_spacer.get())
+		rmlui_static_cast<ElementVirtualSpacer*>(spacer)->SetView(nullptr);
+	if (Element* container = scroll_container.get())
+		container->RemoveEventListener(EventId::Scroll, this);
+}
+
 bool DataViewFor::Initialize(DataModel& model, Element* element, const String& in_expression, const String& in_rml_content)
 {
 	rml_contents = in_rml_content;
@@ -503,15 +573,60 @@ bool DataViewFor::Initialize(DataModel& model, Element* element, const String& i
 
 	element->SetProperty(PropertyId::Display, Property(Style::Display::None));
 
-	// Copy over the attributes, but remove the 'data-for' which would otherwise recreate the data-for loop on all constructed children recursively.
+	// Copy over the attributes, but remove the 'data-for' (or 'data-for-virtual') which would otherwise recreate the data-for loop on all
+	// constructed children recursively.
 	attributes = element->GetAttributes();
-	for (auto it = attributes.begin(); it != attributes.end(); ++it)
+	String key_expression_str;
+	for (auto it = attributes.begin(); it != attributes.end();)
 	{
 		if (it->first == "data-for")
 		{
-			attributes.erase(it);
-			break;
+			it = attributes.erase(it);
+		}
+		else if (it->first == "data-for-virtual")
+		{
+			is_virtual = true;
+			it = attributes.erase(it);
 		}
+		else if (it->first == "data-key")
+		{
+			key_expression_str = it->second.Get<String>();
+			it = attributes.erase(it);
+		}
+		else
+			++it;
+	}
+
+	if (is_virtual && !key_expression_str.empty())
+	{
+		Log::Message(Log::LT_WARNING, "The data-key attribute is ignored in data-for-virtual, rows are recycled by position. In element %s.",
+			element->GetAddress().c_str());
+		key_expression_str.clear();
+	}
+
+	if (is_virtual || !key_expression_str.empty())
+	{
+		// The row elements are bound to the rows variable, which resolves them to their current entries.
+		static BoundRowsDefinition bound_rows_definition;
+		data_model = &model;
+		rows_variable_name = model.BindInternalVariable(element, DataVariable(&bound_rows_definition, this));
+	}
+
+	if (is_virtual)
+	{
+		// The range variable is dirtied whenever the viewport may have moved, so that the range can be re-evaluated during the next update.
+		range_variable_name = model.BindInternalVariable(element, MakeLiteralIntVariable(0));
+	}
+	else if (!key_expression_str.empty())
+	{
+		// The key expression is evaluated on this element, with the iterator bound to each entry in turn through the reserved slot.
+		slot_indices.push_back(-1);
+		model.InsertAlias(element, iterator_name, DataAddress{{rows_variable_name}, {0}});
+		model.InsertAlias(element, iterator_index_name, DataAddress{{rows_variable_name}, {"index"}, {0}});
+
+		key_expression = MakeUnique<DataExpression>(key_expression_str);
+		if (!key_expression->Parse(DataExpressionInterface(&model, element), false))
+			return false;
 	}
 
 	return true;
@@ -525,6 +640,12 @@ bool DataViewFor::Update(DataModel& model)
 
 	bool result = false;
 	const int size = variable.Size();
+
+	if (is_virtual)
+		return UpdateVirtual(model, size);
+	if (key_expression)
+		return UpdateKeyed(model, size);
+
 	const int num_elements = (int)elements.size();
 	Element* element = GetElement();
 
@@ -547,7 +668,7 @@ bool DataViewFor::Update(DataModel& model)
 			Element* new_element = element->GetParentNode()->InsertBefore(std::move(new_element_ptr), element);
 			elements.push_back(new_element);
 
-			elements[i]->SetInnerRML(rml_contents);
+			InstanceRowContents(elements[i]);
 
 			RMLUI_ASSERT(i < (int)elements.size());
 		}
@@ -565,12 +686,470 @@ bool DataViewFor::Update(DataModel& model)
 	return result;
 }
 
+void DataViewFor::InstanceRowContents(Element* row)
+{
+	// The contents are parsed once and then replayed for every row.
+	if (!rml_recording)
+	{
+		Context* context = row->GetContext();
+		rml_recording = MakeUnique<XMLRecording>(rml_contents, context ? context->GetDocumentsBaseTag() : "body");
+	}
+
+	rml_recording->Instance(row);
+}
+
+bool DataViewFor::UpdateVirtual(DataModel& model, const int size)
+{
+	Element* element = GetElement();
+	Element* parent = element->GetParentNode();
+	if (!parent)
+		return false;
+
+	if (!leading_spacer)
+	{
+		// The spacers stand in for the rows before and after the instanced ones. The rows are placed between them.
+		for (ObserverPtr<Element>* spacer : {&leading_spacer, &trailing_spacer})
+		{
+			ElementPtr spacer_ptr = Factory::InstanceElement(nullptr, "#spacer", "spacer", XMLAttributes());
+			ElementVirtualSpacer* virtual_spacer = rmlui_dynamic_cast<ElementVirtualSpacer*>(spacer_ptr.get());
+			if (!virtual_spacer)
+				return false;
+			virtual_spacer->SetView(this);
+			*spacer = parent->InsertBefore(std::move(spacer_ptr), element)->GetObserverPtr();
+		}
+	}
+
+	ElementVirtualSpacer* leading = rmlui_static_cast<ElementVirtualSpacer*>(leading_spacer.get());
+	ElementVirtualSpacer* trailing = rmlui_static_cast<ElementVirtualSpacer*>(trailing_spacer.get());
+	if (!leading || !trailing)
+		return false;
+
+	const int num_elements = (int)elements.size();
+
+	// Until the rows have been laid out, instance an initial batch of rows to measure their height.
+	int first = 0;
+	int last = Math::Min(size, virtual_initial_rows);
+
+	if (has_layout && !scroll_container && !scroll_container_missing)
+		FindScrollContainer();
+
+	if (has_layout && scroll_container_missing)
+	{
+		last = size;
+	}
+	else if (Element* container = (has_layout ? scroll_container.get() : nullptr))
+	{
+		const float list_top = leading->GetAbsoluteOffset(BoxArea::Border).y;
+
+		// Estimate the height of each row from the instanced rows. The estimate is kept for the non-instanced rows, so that
+		// the range converges even for rows of varying height. It is measured again if the viewport width changes.
+		const float viewport_width = container->GetClientWidth();
+		if (num_elements > 0 && num_elements == num_laid_out_elements && (row_height <= 0.f || viewport_width != row_height_measured_width))
+		{
+			const float rows_top = list_top + leading->GetOffsetHeight();
+			const float rows_bottom = trailing->GetAbsoluteOffset(BoxArea::Border).y;
+			const float measured_row_height = (rows_bottom - rows_top) / float(num_elements);
+			if (measured_row_height > 0.f)
+			{
+				row_height = measured_row_height;
+				row_height_measured_width = viewport_width;
+			}
+		}
+
+		if (row_height > 0.f)
+		{
+			// Offset of the first entry relative to the top of the scroll container's visible area.
+			const float offset = list_top - container->GetAbsoluteOffset(BoxArea::Padding).y;
+			const float viewport_height = container->GetClientHeight();
+
+			first = Math::Clamp(int(Math::RoundDown(-offset / row_height)) - virtual_overscan_rows, 0, size);
+			last = Math::Clamp(int(Math::RoundUp((viewport_height - offset) / row_height)) + virtual_overscan_rows, first, size);
+		}
+	}
+
+	const int num_rows = last - first;
+	const bool range_changed = (first != first_row_index || num_rows != num_elements);
+	first_row_index = first;
+
+	for (int i = num_elements; i < num_rows; i++)
+	{
+		ElementPtr new_element_ptr = Factory::InstanceElement(nullptr, element->GetTagName(), element->GetTagName(), attributes);
+
+		model.InsertAlias(new_element_ptr.get(), iterator_name, DataAddress{{rows_variable_name}, {i}});
+		model.InsertAlias(new_element_ptr.get(), iterator_index_name, DataAddress{{rows_variable_name}, {"index"}, {i}});
+
+		Element* new_element = parent->InsertBefore(std::move(new_element_ptr), trailing);
+		elements.push_back(new_element);
+
+		InstanceRowContents(new_element);
+	}
+
+	for (int i = num_rows; i < num_elements; i++)
+	{
+		model.EraseAliases(elements[i]);
+		elements[i]->GetParentNode()->RemoveChild(elements[i]).reset();
+	}
+
+	if (num_elements > num_rows)
+		elements.resize(num_rows);
+
+	leading->SetHeight(float(first) * row_height);
+	trailing->SetHeight(float(size - last) * row_height);
+
+	// The rows need to be updated whenever they are bound to other entries, or when the container is changed. Conversely, the
+	// rows may be changed through assignments, which must be reflected in any views of the container.
+	const String& container_name = container_address.front().name;
+	if (range_changed || model.IsVariableDirty(container_name) || model.IsVariableDirty(rows_variable_name))
+	{
+		model.DirtyVariable(rows_variable_name);
+		model.DirtyVariable(container_name);
+	}
+
+	return range_changed;
+}
+
+static bool IsSameAddress(const DataAddress& a, const DataAddress& b)
+{
+	if (a.size() != b.size())
+		return false;
+	for (size_t i = 0; i < a.size(); i++)
+	{
+		if (a[i].index != b[i].index || a[i].name != b[i].name)
+			return false;
+	}
+	return true;
+}
+
+// Returns true if the addresses are equal up to the length of the shorter one, starting at the given offset into each.
+static bool IsCommonAddress(const DataAddress& a, size_t a_offset, const DataAddress& b, size_t b_offset)
+{
+	for (; a_offset < a.size() && b_offset < b.size(); a_offset++, b_offset++)
+	{
+		if (a[a_offset].index != b[b_offset].index || a[a_offset].name != b[b_offset].name)
+			return false;
+	}
+	return true;
+}
+
+bool DataViewFor::UpdateKeyed(DataModel& model, const int size)
+{
+	// Addresses of the container entries have their index at this position, and the addresses of the rows their slot at position one.
+	const size_t entry_index_position = container_address.size();
+	const DataAddress rows_address = {DataAddressEntry(rows_variable_name)};
+
+	Vector<DataAddress> dirty_entries, dirty_rows;
+	const bool container_dirty = model.GetDirtyAddresses(container_address, dirty_entries);
+	model.GetDirtyAddresses(rows_address, dirty_rows);
+
+	// The rows only need to be matched to the entries again when the size or any of the keys may have changed.
+	bool reconcile = (container_dirty || size != (int)elements.size());
+	if (!reconcile)
+	{
+		const AddressList& key_addresses = key_expression->GetVariableAddressList();
+		for (const DataAddress& entry_address : dirty_entries)
+		{
+			for (const DataAddress& key_address : key_addresses)
+			{
+				if (key_address.size() >= 2 && key_address[0].name == rows_variable_name && key_address[1].index == 0 &&
+					IsCommonAddress(entry_address, entry_index_position + 1, key_address, 2))
+					reconcile = true;
+			}
+		}
+	}
+
+	const bool result = (reconcile && ReconcileKeyedRows(model, size));
+
+	if (container_dirty)
+	{
+		// Any of the entries may have changed. The rows which are unchanged are re-evaluated, but keep their current values.
+		model.DirtyVariable(rows_variable_name);
+		return result;
+	}
+
+	// The rows are bound to the entries through their slot, forward changes between the two so that views of either are updated.
+	for (const DataAddress& entry_address : dirty_entries)
+	{
+		const int index = entry_address[entry_index_position].index;
+		if (index < 0 || index >= (int)row_slots.size())
+			continue;
+
+		DataAddress row_address;
+		row_address.reserve(entry_address.size() - entry_index_position + 1);
+		row_address.push_back(DataAddressEntry(rows_variable_name));
+		row_address.push_back(DataAddressEntry(row_slots[index]));
+		row_address.insert(row_address.end(), entry_address.begin() + entry_index_position + 1, entry_address.end());
+
+		auto is_same_address = [&](const DataAddress& address) { return IsSameAddress(address, row_address); };
+		if (std::none_of(dirty_rows.begin(), dirty_rows.end(), is_same_address))
+			model.DirtyVariable(row_address);
+	}
+
+	for (const DataAddress& row_address : dirty_rows)
+	{
+		const int slot = row_address[1].index;
+		if (slot <= 0 || slot >= (int)slot_indices.size() || slot_indices[slot] < 0)
+			continue;
+
+		DataAddress entry_address;
+		entry_address.reserve(entry_index_position + row_address.size() - 1);
+		entry_address = container_address;
+		entry_address.push_back(DataAddressEntry(slot_indices[slot]));
+		entry_address.insert(entry_address.end(), row_address.begin() + 2, row_address.end());
+
+		auto is_same_address = [&](const DataAddress& address) { return IsSameAddress(address, entry_address); };
+		if (std::none_of(dirty_entries.begin(), dirty_entries.end(), is_same_address))
+			model.DirtyVariable(entry_address);
+	}
+
+	return result;
+}
+
+bool DataViewFor::ReconcileKeyedRows(DataModel& model, const int size)
+{
+	Element* element = GetElement();
+	Element* parent = element->GetParentNode();
+
+	StringList keys(size);
+	{
+		DataExpressionInterface expression_interface(&model, element);
+		for (int i = 0; i < size; i++)
+		{
+			slot_indices[0] = i;
+			Variant key;
+			if (key_expression->Run(expression_interface, key))
+				keys[i] = key.Get<String>();
+		}
+		slot_indices[0] = -1;
+	}
+
+	// Match the current rows to the entries by their key. Each row is only matched once, any further entries with the same key are
+	// given new rows.
+	UnorderedMap<String, int> row_by_key;
+	row_by_key.reserve(row_keys.size());
+	for (int row = 0; row < (int)row_keys.size(); row++)
+		row_by_key.emplace(row_keys[row], row);
+
+	const int num_rows = (int)elements.size();
+	Vector<bool> row_matched(num_rows, false);
+	ElementList new_elements(size, nullptr);
+	Vector<int> new_slots(size, -1);
+	bool rows_changed = (size != num_rows);
+	bool duplicate_keys = false;
+
+	for (int i = 0; i < size; i++)
+	{
+		auto it = row_by_key.find(keys[i]);
+		if (it == row_by_key.end())
+			continue;
+
+		const int row = it->second;
+		if (row_matched[row])
+		{
+			duplicate_keys = true;
+			continue;
+		}
+
+		row_matched[row] = true;
+		new_elements[i] = elements[row];
+		new_slots[i] = row_slots[row];
+		rows_changed |= (row != i);
+	}
+
+	if (duplicate_keys)
+		Log::Message(Log::LT_WARNING, "Duplicate keys in data-for, rows with duplicate keys are instanced anew. In element %s.",
+			element->GetAddress().c_str());
+
+	for (int row = 0; row < num_rows; row++)
+	{
+		if (row_matched[row])
+			continue;
+
+		model.EraseAliases(elements[row]);
+		elements[row]->GetParentNode()->RemoveChild(elements[row]).reset();
+		slot_indices[row_slots[row]] = -1;
+		free_slots.push_back(row_slots[row]);
+		rows_changed = true;
+	}
+
+	for (int i = 0; i < size; i++)
+	{
+		const int slot = new_slots[i];
+		if (slot >= 0)
+		{
+			// The index of moved rows must be updated, their entries are otherwise unchanged.
+			if (slot_indices[slot] != i)
+				model.DirtyVariable(DataAddress{{rows_variable_name}, {"index"}, {slot}});
+			slot_indices[slot] = i;
+			continue;
+		}
+
+		int new_slot = 0;
+		if (free_slots.empty())
+		{
+			new_slot = (int)slot_indices.size();
+			slot_indices.push_back(i);
+		}
+		else
+		{
+			new_slot = free_slots.back();
+			free_slots.pop_back();
+			slot_indices[new_slot] = i;
+		}
+
+		ElementPtr new_element_ptr = Factory::InstanceElement(nullptr, element->GetTagName(), element->GetTagName(), attributes);
+
+		model.InsertAlias(new_element_ptr.get(), iterator_name, DataAddress{{rows_variable_name}, {new_slot}});
+		model.InsertAlias(new_element_ptr.get(), iterator_index_name, DataAddress{{rows_variable_name}, {"index"}, {new_slot}});
+
+		Element* new_element = parent->InsertBefore(std::move(new_element_ptr), element);
+		InstanceRowContents(new_element);
+
+		new_elements[i] = new_element;
+		new_slots[i] = new_slot;
+	}
+
+	elements = std::move(new_elements);
+	row_slots = std::move(new_slots);
+	row_keys = std::move(keys);
+
+	if (rows_changed)
+		ReorderRowElements();
+
+	return rows_changed;
+}
+
+void DataViewFor::ReorderRowElements()
+{
+	// Removing and inserting the rows would detach them from the data model, thus their views would have to be created again. Instead,
+	// the row elements are reordered in-place among the same positions of the parent's children.
+	Element* parent = GetElement()->GetParentNode();
+
+	UnorderedMap<Element*, int> row_order;
+	row_order.reserve(elements.size());
+	for (int i = 0; i < (int)elements.size(); i++)
+		row_order.emplace(elements[i], i);
+
+	Vector<size_t> positions;
+	positions.reserve(elements.size());
+	bool in_order = true;
+	for (size_t i = 0; i < parent->children.size(); i++)
+	{
+		auto it = row_order.find(parent->children[i].get());
+		if (it == row_order.end())
+			continue;
+		in_order &= (it->second == (int)positions.size());
+		positions.push_back(i);
+	}
+
+	RMLUI_ASSERT(positions.size() == elements.size());
+	if (in_order || positions.size() != elements.size())
+		return;
+
+	Vector<ElementPtr> rows(elements.size());
+	for (size_t position : positions)
+	{
+		ElementPtr& child = parent->children[position];
+		const int row = row_order[child.get()];
+		rows[row] = std::move(child);
+	}
+	for (size_t i = 0; i < positions.size(); i++)
+		parent->children[positions[i]] = std::move(rows[i]);
+
+	// The same as when inserting children, the layout and any structural selectors of the rows are affected.
+	parent->DirtyContentLayout();
+	parent->DirtyStackingContext();
+	parent->DirtyDefinition(Element::DirtyNodes::Self);
+}
+
+void DataViewFor::FindScrollContainer()
+{
+	for (Element* ancestor = GetElement()->GetParentNode(); ancestor; ancestor = ancestor->GetParentNode())
+	{
+		const Style::Overflow overflow_y = ancestor->GetComputedValues().overflow_y();
+		if (overflow_y == Style::Overflow::Scroll || overflow_y == Style::Overflow::Auto)
+		{
+			ancestor->AddEventListener(EventId::Scroll, this);
+			scroll_container = ancestor->GetObserverPtr();
+			return;
+		}
+	}
+
+	scroll_container_missing = true;
+	Log::Message(Log::LT_WARNING, "Could not find a scroll container for data-for-virtual in element %s, all rows will be instanced.",
+		GetElement()->GetAddress().c_str());
+}
+
+DataVariable DataViewFor::GetBoundRowVariable(int row) const
+{
+	if (!data_model || row < 0 || row >= GetNumBoundRows())
+		return DataVariable();
+
+	// The container entry may already be removed while this view is waiting to be removed along with its element.
+	DataVariable container = data_model->FindVariable(container_address);
+	const int index = GetBoundRowIndex(row);
+	if (!container || index < 0 || index >= container.Size())
+		return DataVariable();
+
+	return container.Child(DataAddressEntry(index));
+}
+
+int DataViewFor::GetNumBoundRows() const
+{
+	return is_virtual ? (int)elements.size() : (int)slot_indices.size();
+}
+
+int DataViewFor::GetBoundRowIndex(int row) const
+{
+	if (is_virtual)
+		return first_row_index + row;
+	return (row >= 0 && row < (int)slot_indices.size()) ? slot_indices[row] : -1;
+}
+
+void DataViewFor::OnSpacerLayout()
+{
+	has_layout = true;
+	num_laid_out_elements = (int)elements.size();
+	DirtyVirtualRange();
+}
+
+void DataViewFor::ProcessEvent(Event& event)
+{
+	if (event.GetId() == EventId::Scroll && event.GetTargetElement() == scroll_container.get())
+		DirtyVirtualRange();
+}
+
+void DataViewFor::DirtyVirtualRange()
+{
+	// The internal variables are unbound once the element is removed from the model, at which point this view is also removed.
+	Element* element = (IsValid() ? GetElement() : nullptr);
+	if (!element || element->GetDataModel() != data_model)
+		return;
+
+	data_model->DirtyVariable(range_variable_name);
+	if (Context* context = element->GetContext())
+		context->RequestNextUpdate(0);
+}
+
 StringList DataViewFor::GetVariableNameList() const
 {
 	RMLUI_ASSERT(!container_address.empty());
+	if (is_virtual)
+		return StringList{container_address.front().name, rows_variable_name, range_variable_name};
+	if (key_expression)
+		return StringList{container_address.front().name, rows_variable_name};
 	return StringList{container_address.front().name};
 }
 
+Vector<DataAddress> DataViewFor::GetVariableAddressList() const
+{
+	RMLUI_ASSERT(!container_address.empty());
+	if (is_virtual)
+		return Vector<DataAddress>{container_address, DataAddress{DataAddressEntry(rows_variable_name)}, DataAddress{DataAddressEntry(range_variable_name)}};
+	if (key_expression)
+		return Vector<DataAddress>{container_address, DataAddress{DataAddressEntry(rows_variable_name)}};
+	return Vector<DataAddress>{container_address};
+}
+
 void DataViewFor::Release()
 {
 	delete this;
@@ -29,6 +29,8 @@
 #ifndef RMLUI_CORE_DATAVIEWDEFAULT_H
 #define RMLUI_CORE_DATAVIEWDEFAULT_H
 
+#include "../../Include/RmlUi/Core/DataVariable.h"
+#include "../../Include/RmlUi/Core/EventListener.h"
 #include "../../Include/RmlUi/Core/Header.h"
 #include "../../Include/RmlUi/Core/Types.h"
 #include "../../Include/RmlUi/Core/Variant.h"
@@ -38,6 +40,7 @@ namespace Rml {
 
 class Element;
 class DataExpression;
+class XMLRecording;
 using DataExpressionPtr = UniquePtr<DataExpression>;
 
 class DataViewCommon : public DataView {
@@ -47,6 +50,7 @@ public:
 	bool Initialize(DataModel& model, Element* element, const String& expression, const String& modifier) override;
 
 	StringList GetVariableNameList() const override;
+	Vector<DataAddress> GetVariableAddressList() const override;
 
 protected:
 	const String& GetModifier() const;
@@ -133,6 +137,7 @@ public:
 
 	bool Update(DataModel& model) override;
 	StringList GetVariableNameList() const override;
+	Vector<DataAddress> GetVariableAddressList() const override;
 
 protected:
 	void Release() override;
@@ -150,27 +155,77 @@ private:
 	Vector<DataEntry> data_entries;
 };
 
-class DataViewFor final : public DataView {
+class DataViewFor final : public DataView, public EventListener {
 public:
 	DataViewFor(Element* element);
+	~DataViewFor();
 
 	bool Initialize(DataModel& model, Element* element, const String& expression, const String& inner_rml) override;
 
 	bool Update(DataModel& model) override;
 
 	StringList GetVariableNameList() const override;
+	Vector<DataAddress> GetVariableAddressList() const override;
+
+	// Virtualized views ('data-for-virtual') only instance the rows intersecting the viewport of their scroll container. The
+	// row elements are recycled by binding each of them to the container entry at the given offset from the first visible row.
+	// Keyed views ('data-key') bind each row element to a fixed slot, which is moved to the entry with the same key as the
+	// container changes. The row number below refers to the offset for virtualized views, and the slot for keyed views.
+	int GetNumBoundRows() const;
+	DataVariable GetBoundRowVariable(int row) const;
+	int GetBoundRowIndex(int row) const;
+
+	// Called by the spacer elements of virtualized views whenever they are laid out.
+	void OnSpacerLayout();
 
 protected:
 	void Release() override;
 
+	void ProcessEvent(Event& event) override;
+
 private:
+	bool UpdateVirtual(DataModel& model, int size);
+	bool UpdateKeyed(DataModel& model, int size);
+	bool ReconcileKeyedRows(DataModel& model, int size);
+	void ReorderRowElements();
+	void InstanceRowContents(Element* row);
+	void FindScrollContainer();
+	void DirtyVirtualRange();
+
 	DataAddress container_address;
 	String iterator_name;
 	String iterator_index_name;
 	String rml_contents;
+	UniquePtr<XMLRecording> rml_recording;
 	ElementAttributes attributes;
 
 	ElementList elements;
+
+	// Virtualized and keyed views only.
+	DataModel* data_model = nullptr;
+	String rows_variable_name;
+
+	// Keyed views only. Slot zero is reserved for evaluating the key of each entry.
+	DataExpressionPtr key_expression;
+	StringList row_keys;
+	Vector<int> row_slots;
+	Vector<int> slot_indices;
+	Vector<int> free_slots;
+
+	// Virtualized views only.
+	bool is_virtual = false;
+	String range_variable_name;
+
+	int first_row_index = 0;
+	float row_height = 0.f;
+	float row_height_measured_width = -1.f;
+	bool has_layout = false;
+	int num_laid_out_elements = 0;
+	bool scroll_container_missing = false;
+
+	ObserverPtr<Element> leading_spacer;
+	ObserverPtr<Element> trailing_spacer;
+	ObserverPtr<Element> scroll_container;
 };
 
 class DataViewAlias final : public DataView {
@@ -35,6 +35,7 @@
 #include "../../Include/RmlUi/Core/PropertyDefinition.h"
 #include "../../Include/RmlUi/Core/RenderManager.h"
 #include "../../Include/RmlUi/Core/TextShapingContext.h"
+#include "TextGeometry.h"
 
 namespace Rml {
 
@@ -52,7 +53,7 @@ void DecoratorText::Initialise(String in_text, bool in_inherit_color, Colourb in
 
 DecoratorDataHandle DecoratorText::GenerateElementData(Element* element, BoxArea paint_area) const
 {
-	ElementData* data = new ElementData{paint_area, {}, -1};
+	ElementData* data = new ElementData{paint_area, {}, -1, {}};
 
 	if (!GenerateGeometry(element, *data))
 	{
@@ -76,8 +77,13 @@ void DecoratorText::RenderElement(Element* element, DecoratorDataHandle element_
 
 	const Vector2f translation = element->GetAbsoluteOffset(BoxArea::Border);
 
-	for (size_t i = 0; i < data->textured_geometry.size(); ++i)
-		data->textured_geometry[i].geometry.Render(translation, data->textured_geometry[i].texture);
+	for (const TexturedGeometry& textured_geometry : data->textured_geometry)
+	{
+		if (textured_geometry.shader)
+			textured_geometry.geometry.Render(translation, textured_geometry.texture, *textured_geometry.shader);
+		else
+			textured_geometry.geometry.Render(translation, textured_geometry.texture);
+	}
 }
 
 bool DecoratorText::GenerateGeometry(Element* element, ElementData& element_data) const
@@ -110,7 +116,10 @@ bool DecoratorText::GenerateGeometry(Element* element, ElementData& element_data
 
 	RenderManager& render_manager = element->GetContext()->GetRenderManager();
 	TexturedMeshList mesh_list;
-	font_engine_interface->GenerateString(render_manager, font_face_handle, {}, text, offset, text_color, opacity, text_shaping_context, mesh_list);
+	Vector<const CompiledShader*> mesh_shaders;
+	Vector<SharedPtr<const void>> glyph_pins;
+	TextGeometry::GenerateString(render_manager, font_face_handle, {}, text, offset, text_color, opacity, text_shaping_context, mesh_list,
+		mesh_shaders, glyph_pins);
 
 	if (mesh_list.empty())
 		return false;
@@ -120,12 +129,14 @@ bool DecoratorText::GenerateGeometry(Element* element, ElementData& element_data
 	{
 		textured_geometry[i].geometry = render_manager.MakeGeometry(std::move(mesh_list[i].mesh));
 		textured_geometry[i].texture = mesh_list[i].texture;
+		textured_geometry[i].shader = mesh_shaders[i];
 	}
 
 	element_data = ElementData{
 		element_data.paint_area,
 		std::move(textured_geometry),
 		font_engine_interface->GetVersion(font_face_handle),
+		std::move(glyph_pins),
 	};
 
 	return true;
@@ -52,11 +52,14 @@ private:
 	struct TexturedGeometry {
 		Geometry geometry;
 		Texture texture;
+		const CompiledShader* shader = nullptr;
 	};
 	struct ElementData {
 		BoxArea paint_area;
 		Vector<TexturedGeometry> textured_geometry;
 		int font_handle_version;
+		// Protects the glyphs used by the geometry from being evicted by the font engine.
+		Vector<SharedPtr<const void>> glyph_pins;
 	};
 
 	bool GenerateGeometry(Element* element, ElementData& element_data) const;
@@ -0,0 +1,161 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "DefinitionPrefetch.h"
+#include "../../Include/RmlUi/Core/Core.h"
+#include "../../Include/RmlUi/Core/Element.h"
+#include "../../Include/RmlUi/Core/Profiling.h"
+#include "../../Include/RmlUi/Core/StyleSheet.h"
+#include "../../Include/RmlUi/Core/SystemInterface.h"
+#include "AncestorFilter.h"
+#include "ElementMeta.h"
+
+namespace Rml {
+
+// Below this number of elements, the overhead of distributing the work outweighs the gains.
+static constexpr int min_prefetch_elements = 256;
+static constexpr int elements_per_task = 64;
+
+// Incremented whenever the prefetched definitions are invalidated. Prefetched definitions are only valid for the generation they were made in.
+static uint32_t prefetch_generation = 1;
+// True while any definitions of the current generation may be pending, otherwise there is nothing to invalidate on individual elements.
+static bool has_prefetched_definitions = false;
+
+struct DefinitionPrefetch::Entry {
+	Element* element;
+	const StyleSheet* style_sheet;
+	StyleSheetIndex::NodeList applicable_nodes;
+};
+
+// Collects the elements which will update their definition, by mirroring the propagation of dirty flags in Element::UpdateDefinition().
+void DefinitionPrefetch::CollectElements(Element* element, bool parent_dirtied_children, Vector<Entry>& entries)
+{
+	const bool dirty_definition = (parent_dirtied_children || element->dirty_definition);
+
+	if (dirty_definition || element->dirty_own_definition)
+	{
+		if (const StyleSheet* style_sheet = element->GetStyleSheet())
+		{
+			if (element->GetTagName() != "#text")
+			{
+				// Bring the ancestor filter up to date, so that it is only read during matching.
+				AncestorFilter::Get(element);
+				entries.push_back(Entry{element, style_sheet, {}});
+			}
+		}
+	}
+
+	const bool dirty_children = (dirty_definition || element->dirty_child_definitions);
+	const int num_children = element->GetNumChildren(true);
+	for (int i = 0; i < num_children; i++)
+		CollectElements(element->GetChild(i), dirty_children, entries);
+}
+
+void DefinitionPrefetch::Prefetch(Element* root)
+{
+	RMLUI_ZoneScoped;
+
+	Invalidate();
+
+	Vector<Entry> entries;
+	CollectElements(root, false, entries);
+
+	const int num_entries = (int)entries.size();
+	if (num_entries < min_prefetch_elements)
+		return;
+
+	const int num_tasks = (num_entries + elements_per_task - 1) / elements_per_task;
+	GetSystemInterface()->ExecuteParallel(num_tasks, [&entries, num_entries](int task_index) {
+		const int begin = task_index * elements_per_task;
+		const int end = Math::Min(begin + elements_per_task, num_entries);
+		for (int i = begin; i < end; i++)
+			entries[i].style_sheet->GetApplicableNodes(entries[i].element, entries[i].applicable_nodes);
+	});
+
+	// Looking up the definitions modifies the style sheet's definition cache, so this is done after all the tasks have finished.
+	for (Entry& entry : entries)
+	{
+		ElementMeta& meta = *entry.element->meta;
+		meta.prefetched_definition = entry.style_sheet->GetElementDefinition(entry.applicable_nodes);
+		meta.prefetched_style_sheet = entry.style_sheet;
+		meta.prefetch_generation = prefetch_generation;
+	}
+	has_prefetched_definitions = true;
+}
+
+bool DefinitionPrefetch::TakeDefinition(Element* element, SharedPtr<const ElementDefinition>& definition)
+{
+	ElementMeta& meta = *element->meta;
+	if (meta.prefetch_generation != prefetch_generation)
+		return false;
+
+	meta.prefetch_generation = 0;
+	if (meta.prefetched_style_sheet != element->GetStyleSheet())
+	{
+		meta.prefetched_definition.reset();
+		return false;
+	}
+
+	definition = std::move(meta.prefetched_definition);
+	return true;
+}
+
+void DefinitionPrefetch::Invalidate()
+{
+	prefetch_generation += 1;
+	if (prefetch_generation == 0)
+		prefetch_generation = 1;
+	has_prefetched_definitions = false;
+}
+
+void DefinitionPrefetch::InvalidateElement(Element* element)
+{
+	if (!has_prefetched_definitions)
+		return;
+
+	ElementMeta& meta = *element->meta;
+	if (meta.prefetch_generation == prefetch_generation)
+	{
+		meta.prefetch_generation = 0;
+		meta.prefetched_definition.reset();
+	}
+}
+
+void DefinitionPrefetch::InvalidateDescendants(Element* element)
+{
+	if (!has_prefetched_definitions)
+		return;
+
+	for (const ElementPtr& child : element->children)
+	{
+		InvalidateElement(child.get());
+		InvalidateDescendants(child.get());
+	}
+}
+
+} // namespace Rml
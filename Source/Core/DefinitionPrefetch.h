@@ -0,0 +1,69 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef RMLUI_CORE_DEFINITIONPREFETCH_H
+#define RMLUI_CORE_DEFINITIONPREFETCH_H
+
+#include "../../Include/RmlUi/Core/Types.h"
+
+namespace Rml {
+
+class Element;
+class ElementDefinition;
+
+/**
+    Matches the elements which are about to update their definition against their style sheet ahead of the regular update, with the
+    matching distributed over multiple tasks using the system interface.
+
+    Selector matching only reads from the element hierarchy and the style sheet, and is thus safe to run concurrently as long as the
+    hierarchy is not modified. The results are stored on each element and picked up during its definition update. Any change which dirties
+    a definition in the meantime invalidates the prefetched results of the elements it dirties, which then fall back to regular matching.
+ */
+class DefinitionPrefetch {
+public:
+	/// Prefetches the definitions of all the elements in the given subtree whose definitions will be updated during its next update.
+	static void Prefetch(Element* root);
+
+	/// Retrieves the prefetched definition of the given element, if it is still valid.
+	/// @return True if a valid definition was prefetched, in which case 'definition' is set, otherwise false.
+	static bool TakeDefinition(Element* element, SharedPtr<const ElementDefinition>& definition);
+
+	/// Invalidates all prefetched definitions.
+	static void Invalidate();
+	/// Invalidates the prefetched definition of the given element.
+	static void InvalidateElement(Element* element);
+	/// Invalidates the prefetched definitions of all the descendants of the given element, not including the element itself.
+	static void InvalidateDescendants(Element* element);
+
+private:
+	struct Entry;
+	static void CollectElements(Element* element, bool parent_dirtied_children, Vector<Entry>& entries);
+};
+
+} // namespace Rml
+#endif
@@ -43,9 +43,11 @@
 #include "../../Include/RmlUi/Core/StyleSheet.h"
 #include "../../Include/RmlUi/Core/StyleSheetSpecification.h"
 #include "../../Include/RmlUi/Core/TransformPrimitive.h"
+#include "AncestorFilter.h"
 #include "Clock.h"
 #include "ComputeProperty.h"
 #include "DataModel.h"
+#include "DefinitionPrefetch.h"
 #include "ElementAnimation.h"
 #include "ElementBackgroundBorder.h"
 #include "ElementDefinition.h"
@@ -58,6 +60,7 @@
 #include "PluginRegistry.h"
 #include "Pool.h"
 #include "PropertiesIterator.h"
+#include "RenderManagerAccess.h"
 #include "StyleSheetNode.h"
 #include "StyleSheetParser.h"
 #include "TransformState.h"
@@ -71,6 +74,9 @@ namespace Rml {
 // Determines how many levels up in the hierarchy the OnChildAdd and OnChildRemove are called (starting at the child itself)
 static constexpr int ChildNotifyLevels = 2;
 
+// The current render pass, used to stamp changes to elements and their recorded render commands for retained rendering.
+static uint32_t render_pass_stamp = 1;
+
 // Helper function to select scroll offset delta
 static float GetScrollOffsetDelta(ScrollAlignment alignment, float begin_offset, float end_offset)
 {
@@ -95,7 +101,7 @@ static float GetScrollOffsetDelta(ScrollAlignment alignment, float begin_offset,
 Element::Element(const String& tag) :
 	local_stacking_context(false), local_stacking_context_forced(false), stacking_context_dirty(false), computed_values_are_default_initialized(true),
 	visible(true), offset_fixed(false), absolute_offset_dirty(true), rounded_main_padding_size_dirty(true), dirty_definition(false),
-	dirty_child_definitions(false), dirty_animation(false), dirty_transition(false), dirty_transform(false), dirty_perspective(false), tag(tag),
+	dirty_own_definition(false), dirty_child_definitions(false), dirty_animation(false), dirty_transition(false), dirty_transform(false), dirty_perspective(false), tag(tag),
 	relative_offset_base(0, 0), relative_offset_position(0, 0), absolute_offset(0, 0), scroll_offset(0, 0)
 {
 	RMLUI_ASSERT(tag == StringUtilities::ToLower(tag));
@@ -113,6 +119,9 @@ Element::Element(const String& tag) :
 
 	z_index = 0;
 
+	render_change_stamp = 0;
+	render_subtree_change_stamp = 0;
+
 	meta = ElementMetaPool::element_meta_pool->pool.AllocateAndConstruct(this);
 	data_model = nullptr;
 }
@@ -195,7 +204,10 @@ void Element::UpdateProperties(const float dp_ratio, const Vector2f vp_dimension
 		// Computed values are just calculated and can safely be used in OnPropertyChange.
 		// However, new properties set during this call will not be available until the next update loop.
 		if (!dirty_properties.Empty())
+		{
+			DirtyRender();
 			OnPropertyChange(dirty_properties);
+		}
 	}
 }
 
@@ -207,6 +219,32 @@ void Element::Render()
 	RMLUI_ZoneText(name.c_str(), name.size());
 #endif
 
+	// With retained rendering, each local stacking context records its render commands. These are replayed on later frames, instead of
+	// traversing the stacking context, for as long as nothing in it or its ancestors has changed.
+	RenderManager* recording_render_manager = nullptr;
+	if (local_stacking_context)
+	{
+		Context* context = GetContext();
+		if (context && context->IsRetainedRenderingEnabled())
+		{
+			RenderManager* render_manager = &context->GetRenderManager();
+			UniquePtr<RenderCommandList>& render_commands = meta->render_commands;
+
+			if (render_commands && render_commands->IsValid() && IsRenderRecordingValid(render_commands->GetRecordStamp()) &&
+				RenderManagerAccess::ReplayRecording(render_manager, *render_commands))
+			{
+				return;
+			}
+
+			if (!render_commands)
+				render_commands = MakeUnique<RenderCommandList>();
+
+			RenderManagerAccess::BeginRecording(render_manager, *render_commands);
+			render_commands->SetRecordStamp(render_pass_stamp);
+			recording_render_manager = render_manager;
+		}
+	}
+
 	UpdateAbsoluteOffsetAndRenderBoxData();
 
 	// Rebuild our stacking context if necessary.
@@ -238,6 +276,9 @@ void Element::Render()
 		element->Render();
 
 	meta->effects.RenderEffects(RenderStage::Exit);
+
+	if (recording_render_manager)
+		RenderManagerAccess::EndRecording(recording_render_manager);
 }
 
 ElementPtr Element::Clone() const
@@ -280,7 +321,13 @@ ElementPtr Element::Clone() const
 void Element::SetClass(const String& class_name, bool activate)
 {
 	if (meta->style.SetClass(class_name, activate))
-		DirtyDefinition(DirtyNodes::SelfAndSiblings);
+	{
+		AncestorFilter::Dirty(this, false);
+		if (const StyleSheet* style_sheet = GetStyleSheet())
+			DirtyDefinition(style_sheet->GetClassInvalidationScope(class_name));
+		else
+			DirtyDefinition(DirtyNodes::SelfAndSiblings);
+	}
 }
 
 bool Element::IsClassSet(const String& class_name) const
@@ -429,7 +476,11 @@ void Element::UpdateAbsoluteOffsetAndRenderBoxData()
 
 void Element::SetClipArea(BoxArea _clip_area)
 {
-	clip_area = _clip_area;
+	if (clip_area != _clip_area)
+	{
+		clip_area = _clip_area;
+		DirtyRender();
+	}
 }
 
 BoxArea Element::GetClipArea() const
@@ -442,6 +493,7 @@ void Element::SetScrollableOverflowRectangle(Vector2f _scrollable_overflow_recta
 	if (scrollable_overflow_rectangle != _scrollable_overflow_rectangle)
 	{
 		scrollable_overflow_rectangle = _scrollable_overflow_rectangle;
+		DirtyRender();
 		if (clamp_scroll_offset)
 			ClampScrollOffset();
 	}
@@ -468,6 +520,7 @@ void Element::SetBox(const Box& box)
 		meta->background_border.DirtyBackground();
 		meta->background_border.DirtyBorder();
 		meta->effects.DirtyEffectsData();
+		DirtyRender();
 	}
 }
 
@@ -478,6 +531,7 @@ void Element::AddBox(const Box& box, Vector2f offset)
 	meta->background_border.DirtyBackground();
 	meta->background_border.DirtyBorder();
 	meta->effects.DirtyEffectsData();
+	DirtyRender();
 }
 
 const Box& Element::GetBox()
@@ -794,8 +848,12 @@ void Element::SetPseudoClass(const String& pseudo_class, bool activate)
 {
 	if (meta->style.SetPseudoClass(pseudo_class, activate, false))
 	{
-		// Include siblings in case of RCSS presence of sibling combinators '+', '~'.
-		DirtyDefinition(DirtyNodes::SelfAndSiblings);
+		// Only elements which may be affected by the pseudo class through any selector in the style sheet need to be updated. Without a style
+		// sheet, include siblings in case of RCSS presence of sibling combinators '+', '~'.
+		if (const StyleSheet* style_sheet = GetStyleSheet())
+			DirtyDefinition(style_sheet->GetPseudoClassInvalidationScope(pseudo_class));
+		else
+			DirtyDefinition(DirtyNodes::SelfAndSiblings);
 		OnPseudoClassChange(pseudo_class, activate);
 	}
 }
@@ -1351,7 +1409,7 @@ Element* Element::AppendChild(ElementPtr child, bool dom_element)
 	DirtyDefinition(DirtyNodes::Self);
 
 	if (dom_element)
-		DirtyLayout();
+		DirtyContentLayout();
 
 	return child_ptr;
 }
@@ -1385,7 +1443,7 @@ Element* Element::InsertBefore(ElementPtr child, Element* adjacent_element)
 		if ((int)child_index >= GetNumChildren())
 			num_non_dom_children++;
 		else
-			DirtyLayout();
+			DirtyContentLayout();
 
 		children.insert(children.begin() + child_index, std::move(child));
 		child_ptr->SetParent(this);
@@ -1453,6 +1511,8 @@ ElementPtr Element::RemoveChild(Element* child)
 			ElementPtr detached_child = std::move(*itr);
 			children.erase(itr);
 
+			meta->style.RemoveStyleSharingCandidate(child);
+
 			// Remove the child element as the focused child of this element.
 			if (child == focus)
 			{
@@ -1478,7 +1538,7 @@ ElementPtr Element::RemoveChild(Element* child)
 
 			detached_child->SetParent(nullptr);
 
-			DirtyLayout();
+			DirtyContentLayout();
 			DirtyStackingContext();
 			DirtyDefinition(DirtyNodes::Self);
 
@@ -1652,6 +1712,15 @@ ElementScroll* Element::GetElementScroll() const
 	return &meta->scroll;
 }
 
+void Element::DirtyRender()
+{
+	render_change_stamp = render_pass_stamp;
+
+	// Propagate the change to all ancestors, stopping at the first one already changed during this pass, then all of its ancestors are as well.
+	for (Element* element = this; element && element->render_subtree_change_stamp != render_pass_stamp; element = element->parent)
+		element->render_subtree_change_stamp = render_pass_stamp;
+}
+
 DataModel* Element::GetDataModel() const
 {
 	return data_model;
@@ -1689,17 +1758,42 @@ void Element::OnStyleSheetChange() {}
 
 void Element::OnAttributeChange(const ElementAttributes& changed_attributes)
 {
+	DirtyRender();
+
+	const StyleSheet* style_sheet = GetStyleSheet();
+	InvalidationScope invalidation_scope = InvalidationScope::None;
+
 	for (const auto& element_attribute : changed_attributes)
 	{
 		const auto& attribute = element_attribute.first;
 		const auto& value = element_attribute.second;
+
+		if (style_sheet)
+			invalidation_scope = invalidation_scope | style_sheet->GetAttributeInvalidationScope(attribute);
+
 		if (attribute == "id")
 		{
+			if (style_sheet)
+				invalidation_scope = invalidation_scope | style_sheet->GetIdInvalidationScope(id);
 			id = value.Get<String>();
+			if (style_sheet)
+				invalidation_scope = invalidation_scope | style_sheet->GetIdInvalidationScope(id);
+			AncestorFilter::Dirty(this, false);
 		}
 		else if (attribute == "class")
 		{
+			if (style_sheet)
+			{
+				for (const String& class_name : meta->style.GetClassNameList())
+					invalidation_scope = invalidation_scope | style_sheet->GetClassInvalidationScope(class_name);
+			}
 			meta->style.SetClassNames(value.Get<String>());
+			if (style_sheet)
+			{
+				for (const String& class_name : meta->style.GetClassNameList())
+					invalidation_scope = invalidation_scope | style_sheet->GetClassInvalidationScope(class_name);
+			}
+			AncestorFilter::Dirty(this, false);
 		}
 		else if (((attribute == "colspan" || attribute == "rowspan") && meta->computed_values.display() == Style::Display::TableCell) ||
 			(attribute == "span" &&
@@ -1779,8 +1873,12 @@ void Element::OnAttributeChange(const ElementAttributes& changed_attributes)
 	}
 
 	// Any change to the attributes may affect which styles apply to the current element, in particular due to attribute selectors, ID selectors, and
-	// class selectors. This can further affect all siblings or descendants due to sibling or descendant combinators.
-	DirtyDefinition(DirtyNodes::SelfAndSiblings);
+	// class selectors. This can further affect all siblings or descendants due to sibling or descendant combinators. Use the invalidation sets of
+	// the style sheet to only update those elements which may actually be affected.
+	if (style_sheet)
+		DirtyDefinition(invalidation_scope);
+	else
+		DirtyDefinition(DirtyNodes::SelfAndSiblings);
 }
 
 void Element::OnPropertyChange(const PropertyIdSet& changed_properties)
@@ -1793,33 +1891,29 @@ void Element::OnPropertyChange(const PropertyIdSet& changed_properties)
 		changed_properties.Contains(PropertyId::Left)      //
 	);
 
-	// See if the document layout needs to be updated.
-	if (!IsLayoutDirty())
+	// Force a relayout if any of the changed properties require it. Even if the document layout is already dirty, this is needed to clear any
+	// cached layout results.
+	const PropertyIdSet changed_properties_forcing_layout =
+		(changed_properties & StyleSheetSpecification::GetRegisteredPropertiesForcingLayout());
+
+	if (!changed_properties_forcing_layout.Empty())
 	{
-		// Force a relayout if any of the changed properties require it.
-		const PropertyIdSet changed_properties_forcing_layout =
-			(changed_properties & StyleSheetSpecification::GetRegisteredPropertiesForcingLayout());
+		DirtyLayout();
+	}
+	else if (top_right_bottom_left_changed)
+	{
+		// Normally, the position properties only affect the position of the element and not the layout. Thus, these properties are not registered
+		// as affecting layout. However, when absolutely positioned elements with both left & right, or top & bottom are set to definite values,
+		// they affect the size of the element and thereby also the layout. This layout-dirtying condition needs to be registered manually.
+		using namespace Style;
+		const ComputedValues& computed = GetComputedValues();
+		const bool absolutely_positioned = (computed.position() == Position::Absolute || computed.position() == Position::Fixed);
+		const bool sized_width = (computed.width().type == Width::Auto && computed.left().type != Left::Auto && computed.right().type != Right::Auto);
+		const bool sized_height =
+			(computed.height().type == Height::Auto && computed.top().type != Top::Auto && computed.bottom().type != Bottom::Auto);
 
-		if (!changed_properties_forcing_layout.Empty())
-		{
+		if (absolutely_positioned && (sized_width || sized_height))
 			DirtyLayout();
-		}
-		else if (top_right_bottom_left_changed)
-		{
-			// Normally, the position properties only affect the position of the element and not the layout. Thus, these properties are not registered
-			// as affecting layout. However, when absolutely positioned elements with both left & right, or top & bottom are set to definite values,
-			// they affect the size of the element and thereby also the layout. This layout-dirtying condition needs to be registered manually.
-			using namespace Style;
-			const ComputedValues& computed = GetComputedValues();
-			const bool absolutely_positioned = (computed.position() == Position::Absolute || computed.position() == Position::Fixed);
-			const bool sized_width =
-				(computed.width().type == Width::Auto && computed.left().type != Left::Auto && computed.right().type != Right::Auto);
-			const bool sized_height =
-				(computed.height().type == Height::Auto && computed.top().type != Top::Auto && computed.bottom().type != Bottom::Auto);
-
-			if (absolutely_positioned && (sized_width || sized_height))
-				DirtyLayout();
-		}
 	}
 
 	// Update the position.
@@ -1877,6 +1971,8 @@ void Element::OnPropertyChange(const PropertyIdSet& changed_properties)
 				// local stacking context.
 				stacking_context.clear();
 				stacking_context_dirty = local_stacking_context;
+				if (!local_stacking_context)
+					meta->render_commands.reset();
 			}
 
 			// When our z-index or local stacking context changes, then we must dirty our parent stacking context so we are re-indexed.
@@ -1961,8 +2057,25 @@ void Element::OnChildRemove(Element* /*child*/) {}
 
 void Element::DirtyLayout()
 {
-	if (Element* document = GetOwnerDocument())
-		document->DirtyLayout();
+	DirtyLayoutCache();
+
+	// Changes to our own box may affect our parent, thus look for the nearest layout boundary starting from there.
+	if (ElementDocument* document = GetOwnerDocument())
+		document->DirtyLayoutBoundary(parent);
+}
+
+void Element::DirtyContentLayout()
+{
+	DirtyLayoutCache();
+
+	if (ElementDocument* document = GetOwnerDocument())
+		document->DirtyLayoutBoundary(this);
+}
+
+void Element::DirtyLayoutCache()
+{
+	for (Element* element = this; element; element = element->parent)
+		element->meta->layout_cache.Clear();
 }
 
 bool Element::IsLayoutDirty()
@@ -2141,6 +2254,10 @@ void Element::SetParent(Element* _parent)
 	RMLUI_ASSERT(!parent || !_parent);
 
 	parent = _parent;
+	AncestorFilter::Dirty(this, true);
+
+	// Our position in the hierarchy changed, so the ancestors and clipping used to render any recorded stacking context may differ too.
+	DirtyRender();
 
 	if (parent)
 	{
@@ -2190,6 +2307,8 @@ void Element::DirtyAbsoluteOffset()
 
 void Element::DirtyAbsoluteOffsetRecursive()
 {
+	DirtyRender();
+
 	if (!absolute_offset_dirty)
 	{
 		absolute_offset_dirty = true;
@@ -2443,6 +2562,8 @@ void Element::AddToStackingContext(Vector<StackingContextChild>& stacking_childr
 
 void Element::DirtyStackingContext()
 {
+	DirtyRender();
+
 	// Find the first ancestor that has a local stacking context, that is our stacking context parent.
 	Element* stacking_context_parent = this;
 	while (stacking_context_parent && !stacking_context_parent->local_stacking_context)
@@ -2456,27 +2577,66 @@ void Element::DirtyStackingContext()
 
 void Element::DirtyDefinition(DirtyNodes dirty_nodes)
 {
+	// Any definitions prefetched for the dirtied elements may no longer match, the dirtied nodes include all their descendants.
 	switch (dirty_nodes)
 	{
-	case DirtyNodes::Self: dirty_definition = true; break;
+	case DirtyNodes::Self:
+		dirty_definition = true;
+		DefinitionPrefetch::InvalidateElement(this);
+		DefinitionPrefetch::InvalidateDescendants(this);
+		break;
 	case DirtyNodes::SelfAndSiblings:
 		dirty_definition = true;
+		DefinitionPrefetch::InvalidateElement(this);
+		DefinitionPrefetch::InvalidateDescendants(parent ? parent : this);
 		if (parent)
 			parent->dirty_child_definitions = true;
 		break;
 	}
 }
 
-void Element::UpdateDefinition()
+void Element::DirtyDefinition(InvalidationScope scope)
 {
-	if (dirty_definition)
+	if ((scope & InvalidationScope::Self) != InvalidationScope::None)
 	{
-		dirty_definition = false;
+		dirty_own_definition = true;
+		DefinitionPrefetch::InvalidateElement(this);
+	}
 
+	if ((scope & InvalidationScope::Descendants) != InvalidationScope::None)
+	{
+		dirty_child_definitions = true;
+		DefinitionPrefetch::InvalidateDescendants(this);
+	}
+	else if ((scope & InvalidationScope::Children) != InvalidationScope::None)
+	{
+		for (const ElementPtr& child : children)
+		{
+			child->dirty_own_definition = true;
+			DefinitionPrefetch::InvalidateElement(child.get());
+		}
+	}
+
+	if ((scope & InvalidationScope::Siblings) != InvalidationScope::None && parent)
+	{
+		parent->dirty_child_definitions = true;
+		DefinitionPrefetch::InvalidateDescendants(parent);
+	}
+}
+
+void Element::UpdateDefinition()
+{
+	if (dirty_definition || dirty_own_definition)
+	{
 		// Dirty definition implies all our descendent elements. Anything that can change the definition of this element can also change the
 		// definition of any descendants due to the presence of RCSS descendant or child combinators. In principle this also applies to sibling
-		// combinators, but those are handled during the DirtyDefinition call.
-		dirty_child_definitions = true;
+		// combinators, but those are handled during the DirtyDefinition call. When the affected elements are known from the style sheet's
+		// invalidation sets, only our own definition is dirtied instead.
+		if (dirty_definition)
+			dirty_child_definitions = true;
+
+		dirty_definition = false;
+		dirty_own_definition = false;
 
 		GetStyle()->UpdateDefinition();
 	}
@@ -2808,6 +2968,27 @@ void Element::DirtyTransformState(bool perspective_dirty, bool transform_dirty)
 {
 	dirty_perspective |= perspective_dirty;
 	dirty_transform |= transform_dirty;
+	DirtyRender();
+}
+
+bool Element::IsRenderRecordingValid(uint32_t record_stamp) const
+{
+	if (render_subtree_change_stamp >= record_stamp)
+		return false;
+
+	// Changes to ancestors may affect our clipping, transforms, and offsets, even if they do not affect our own state.
+	for (const Element* ancestor = parent; ancestor; ancestor = ancestor->parent)
+	{
+		if (ancestor->render_change_stamp >= record_stamp)
+			return false;
+	}
+
+	return true;
+}
+
+void Element::BeginRenderPass()
+{
+	render_pass_stamp += 1;
 }
 
 void Element::UpdateTransformState()
@@ -2967,6 +3148,7 @@ void Element::UpdateTransformState()
 void Element::OnStyleSheetChangeRecursive()
 {
 	meta->effects.DirtyEffects();
+	DirtyRender();
 
 	OnStyleSheetChange();
 
@@ -2979,6 +3161,7 @@ void Element::OnStyleSheetChangeRecursive()
 void Element::OnDpRatioChangeRecursive()
 {
 	meta->effects.DirtyEffects();
+	DirtyRender();
 	GetStyle()->DirtyPropertiesWithUnits(Unit::DP_SCALABLE_LENGTH);
 
 	OnDpRatioChange();
@@ -2994,6 +3177,7 @@ void Element::DirtyFontFaceRecursive()
 	// Dirty the font size to force the element to update the face handle during the next Update(), and update any existing text geometry.
 	meta->style.DirtyProperty(PropertyId::FontSize);
 	meta->computed_values.font_face_handle(0);
+	DirtyRender();
 
 	const int num_children = GetNumChildren(true);
 	for (int i = 0; i < num_children; ++i)
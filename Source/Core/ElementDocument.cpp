@@ -34,6 +34,7 @@
 #include "../../Include/RmlUi/Core/StreamMemory.h"
 #include "../../Include/RmlUi/Core/StyleSheet.h"
 #include "../../Include/RmlUi/Core/StyleSheetContainer.h"
+#include "DefinitionPrefetch.h"
 #include "DocumentHeader.h"
 #include "ElementStyle.h"
 #include "EventDispatcher.h"
@@ -509,7 +510,12 @@ void ElementDocument::UpdateDocument()
 {
 	const float dp_ratio = (context ? context->GetDensityIndependentPixelRatio() : 1.0f);
 	const Vector2f vp_dimensions = (context ? Vector2f(context->GetDimensions()) : Vector2f(1.0f));
+	const bool prefetch_definitions = (context && context->IsParallelStyleResolutionEnabled());
+	if (prefetch_definitions)
+		DefinitionPrefetch::Prefetch(this);
 	Update(dp_ratio, vp_dimensions);
+	if (prefetch_definitions)
+		DefinitionPrefetch::Invalidate();
 	UpdateLayout();
 	UpdatePosition();
 }
@@ -518,6 +524,50 @@ void ElementDocument::UpdateLayout()
 {
 	// Note: Carefully consider when to call this function for performance reasons.
 	// Ideally, only called once per update loop.
+	if (!layout_dirty && !dirty_layout_boundaries.empty())
+	{
+		// Properties may have changed since the boundaries were dirtied, so that they no longer act as layout boundaries. Dirty them again to
+		// find the current nearest boundaries.
+		Vector<ObserverPtr<Element>> boundaries = std::move(dirty_layout_boundaries);
+		dirty_layout_boundaries.clear();
+		for (const ObserverPtr<Element>& boundary : boundaries)
+		{
+			if (boundary && boundary->GetOwnerDocument() == this)
+				DirtyLayoutBoundary(boundary.get());
+		}
+	}
+
+	if (!layout_dirty && !dirty_layout_boundaries.empty())
+	{
+		RMLUI_ZoneScopedN("UpdateLayoutBoundaries");
+
+		Vector<ObserverPtr<Element>> boundaries = std::move(dirty_layout_boundaries);
+		dirty_layout_boundaries.clear();
+
+		SmallUnorderedSet<Element*> boundary_set;
+		for (const ObserverPtr<Element>& boundary : boundaries)
+			boundary_set.insert(boundary.get());
+
+		bool format_document = false;
+		for (const ObserverPtr<Element>& boundary : boundaries)
+		{
+			// Skip boundaries that are formatted as part of another boundary, or that are not displayed at all.
+			bool skip_boundary = false;
+			for (Element* ancestor = boundary->GetParentNode(); ancestor && ancestor != this && !skip_boundary; ancestor = ancestor->GetParentNode())
+				skip_boundary = (boundary_set.count(ancestor) == 1 || ancestor->GetDisplay() == Style::Display::None);
+
+			if (!skip_boundary && !LayoutEngine::FormatLayoutBoundary(boundary.get()))
+			{
+				format_document = true;
+				break;
+			}
+		}
+
+		// As with document formatting below, ignore layout dirtied during formatting.
+		layout_dirty = format_document;
+		dirty_layout_boundaries.clear();
+	}
+
 	if (layout_dirty)
 	{
 		RMLUI_ZoneScoped;
@@ -532,6 +582,7 @@ void ElementDocument::UpdateLayout()
 		// Ignore dirtied layout during document formatting. Layouting must not require re-iteration.
 		// In particular, scrollbars being enabled may set the dirty flag, but this case is already handled within the layout engine.
 		layout_dirty = false;
+		dirty_layout_boundaries.clear();
 	}
 }
 
@@ -591,6 +642,26 @@ bool ElementDocument::IsLayoutDirty()
 	return layout_dirty;
 }
 
+void ElementDocument::DirtyLayoutBoundary(Element* element)
+{
+	if (layout_dirty)
+		return;
+
+	for (; element && element != this; element = element->GetParentNode())
+	{
+		if (LayoutEngine::IsLayoutBoundary(element))
+		{
+			auto it = std::find_if(dirty_layout_boundaries.begin(), dirty_layout_boundaries.end(),
+				[element](const ObserverPtr<Element>& boundary) { return boundary.get() == element; });
+			if (it == dirty_layout_boundaries.end())
+				dirty_layout_boundaries.push_back(element->GetObserverPtr());
+			return;
+		}
+	}
+
+	layout_dirty = true;
+}
+
 void ElementDocument::DirtyVwAndVhProperties()
 {
 	GetStyle()->DirtyPropertiesWithUnitsRecursive(Unit::VW | Unit::VH);
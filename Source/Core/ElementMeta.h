@@ -34,12 +34,15 @@
 #include "../../Include/RmlUi/Core/ElementScroll.h"
 #include "../../Include/RmlUi/Core/Traits.h"
 #include "../../Include/RmlUi/Core/Types.h"
+#include "AncestorFilter.h"
 #include "ControlledLifetimeResource.h"
 #include "ElementBackgroundBorder.h"
 #include "ElementEffects.h"
 #include "ElementStyle.h"
 #include "EventDispatcher.h"
+#include "Layout/LayoutCache.h"
 #include "Pool.h"
+#include "RenderCommandList.h"
 
 namespace Rml {
 
@@ -53,6 +56,13 @@ struct ElementMeta {
 	ElementEffects effects;
 	ElementScroll scroll;
 	Style::ComputedValues computed_values;
+	UniquePtr<RenderCommandList> render_commands;
+	LayoutCache layout_cache;
+	AncestorFilter ancestor_filter;
+	bool ancestor_filter_dirty = true;
+	SharedPtr<const ElementDefinition> prefetched_definition;
+	const StyleSheet* prefetched_style_sheet = nullptr;
+	uint32_t prefetch_generation = 0;
 };
 
 struct ElementMetaPool {
@@ -44,7 +44,9 @@
 #include "../../Include/RmlUi/Core/StyleSheetSpecification.h"
 #include "../../Include/RmlUi/Core/TransformPrimitive.h"
 #include "ComputeProperty.h"
+#include "DefinitionPrefetch.h"
 #include "ElementDefinition.h"
+#include "ElementMeta.h"
 #include "PropertiesIterator.h"
 #include <algorithm>
 
@@ -175,7 +177,22 @@ void ElementStyle::UpdateDefinition()
 
 	if (const StyleSheet* style_sheet = element->GetStyleSheet())
 	{
-		new_definition = style_sheet->GetElementDefinition(element);
+		// Siblings, such as list items, often have identical selector inputs. In that case, share the definition of the sibling which most
+		// recently updated its definition, instead of matching the element against the style sheet again.
+		ElementStyle* parent_style = (element->parent ? &element->parent->meta->style : nullptr);
+		const Element* candidate = (parent_style ? parent_style->style_sharing_candidate : nullptr);
+
+		if (DefinitionPrefetch::TakeDefinition(element, new_definition))
+		{
+			// The definition was already matched ahead of the update, see Context::EnableParallelStyleResolution().
+		}
+		else if (candidate && CanShareDefinition(candidate) && style_sheet->IsElementDefinitionShareable(element))
+			new_definition = candidate->meta->style.definition;
+		else
+			new_definition = style_sheet->GetElementDefinition(element);
+
+		if (parent_style)
+			parent_style->style_sharing_candidate = element;
 	}
 
 	// Switch the property definitions if the definition has changed.
@@ -212,6 +229,40 @@ void ElementStyle::UpdateDefinition()
 	}
 }
 
+void ElementStyle::RemoveStyleSharingCandidate(const Element* child)
+{
+	if (style_sharing_candidate == child)
+		style_sharing_candidate = nullptr;
+}
+
+bool ElementStyle::CanShareDefinition(const Element* candidate) const
+{
+	// The candidate must have an up-to-date definition, and match us on all selector inputs other than attributes and siblings.
+	if (candidate == element || candidate->dirty_definition || candidate->dirty_own_definition)
+		return false;
+
+	if (candidate->GetTagName() != element->GetTagName() || candidate->GetId() != element->GetId())
+		return false;
+
+	const ElementStyle& candidate_style = candidate->meta->style;
+	if (candidate_style.classes != classes)
+		return false;
+
+	auto NumSetPseudoClasses = [](const PseudoClassMap& map) {
+		return std::count_if(map.begin(), map.end(), [](const auto& pair) { return pair.second != PseudoClassState::Clear; });
+	};
+	if (NumSetPseudoClasses(candidate_style.pseudo_classes) != NumSetPseudoClasses(pseudo_classes))
+		return false;
+
+	for (const auto& pair : pseudo_classes)
+	{
+		if (pair.second != PseudoClassState::Clear && !candidate_style.IsPseudoClassSet(pair.first))
+			return false;
+	}
+
+	return true;
+}
+
 bool ElementStyle::SetPseudoClass(const String& pseudo_class, bool activate, bool override_class)
 {
 	bool changed = false;
@@ -56,6 +56,8 @@ public:
 
 	/// Update this definition if required
 	void UpdateDefinition();
+	/// Stops considering the given child for sharing its definition with its siblings, must be called when it is removed from our element.
+	void RemoveStyleSharingCandidate(const Element* child);
 
 	/// Sets or removes a pseudo-class on the element.
 	/// @param[in] pseudo_class The pseudo class to activate or deactivate.
@@ -144,6 +146,9 @@ public:
 	PropertiesIterator Iterate() const;
 
 private:
+	// Returns true if the given sibling of our element is guaranteed to match the same style sheet nodes as our element.
+	bool CanShareDefinition(const Element* candidate) const;
+
 	// Sets a list of properties as dirty.
 	void DirtyProperties(const PropertyIdSet& properties);
 
@@ -167,6 +172,9 @@ private:
 	SharedPtr<const ElementDefinition> definition;
 
 	PropertyIdSet dirty_properties;
+
+	// The child of our element which most recently updated its definition, it may share its definition with the next child to update.
+	const Element* style_sharing_candidate = nullptr;
 };
 
 } // namespace Rml
@@ -41,6 +41,8 @@
 #include "ComputeProperty.h"
 #include "ElementDefinition.h"
 #include "ElementStyle.h"
+#include "TextGeometry.h"
+#include "TextWidthCache.h"
 #include "TransformState.h"
 
 namespace Rml {
@@ -69,8 +71,8 @@ void LogMissingFontFace(Element* element)
 }
 
 ElementText::ElementText(const String& tag) :
-	Element(tag), colour(255, 255, 255), opacity(1), font_handle_version(0), geometry_dirty(true), dirty_layout_on_change(true),
-	generated_decoration(Style::TextDecoration::None), decoration_property(Style::TextDecoration::None), font_effects_dirty(true),
+	Element(tag), colour(255, 255, 255), opacity(1), line_meshes_colour(255, 255, 255), line_meshes_opacity(1), font_handle_version(0),
+	geometry_dirty(true), line_meshes_dirty(true), dirty_layout_on_change(true), generated_decoration(Style::TextDecoration::None), decoration_property(Style::TextDecoration::None), font_effects_dirty(true),
 	font_effects_handle(0)
 {}
 
@@ -104,7 +106,10 @@ void ElementText::OnRender()
 
 	// If our font effects have potentially changed, update it and force a geometry generation if necessary.
 	if (font_effects_dirty && UpdateFontEffects())
+	{
 		geometry_dirty = true;
+		line_meshes_dirty = true;
+	}
 
 	// Dirty geometry if font version has changed.
 	int new_version = GetFontEngineInterface()->GetVersion(font_face_handle);
@@ -112,9 +117,10 @@ void ElementText::OnRender()
 	{
 		font_handle_version = new_version;
 		geometry_dirty = true;
+		line_meshes_dirty = true;
 	}
 
-	// Regenerate the geometry if the colour or font configuration has altered.
+	// Regenerate the geometry if the lines, colour, or font configuration has altered.
 	if (geometry_dirty)
 		GenerateGeometry(render_manager, font_face_handle);
 
@@ -173,7 +179,12 @@ void ElementText::OnRender()
 	if (render)
 	{
 		for (size_t i = 0; i < geometry.size(); ++i)
-			geometry[i].geometry.Render(translation, geometry[i].texture);
+		{
+			if (geometry[i].shader)
+				geometry[i].geometry.Render(translation, geometry[i].texture, *geometry[i].shader);
+			else
+				geometry[i].geometry.Render(translation, geometry[i].texture);
+		}
 	}
 
 	if (decoration)
@@ -235,7 +246,7 @@ bool ElementText::GenerateLine(String& line, int& line_length, float& line_width
 		// Generate the next token and determine its pixel-length.
 		bool break_line = BuildToken(token, next_token_begin, string_end, line.empty() && trim_whitespace_prefix, collapse_white_space,
 			break_at_endline, text_transform_property, decode_escape_characters);
-		int token_width = font_engine_interface->GetStringWidth(font_face_handle, token, text_shaping_context, previous_codepoint);
+		int token_width = TextWidthCache::GetStringWidth(font_engine_interface, font_face_handle, token, text_shaping_context, previous_codepoint);
 
 		// If we're breaking to fit a line box, check if the token can fit on the line before we add it.
 		if (break_at_line)
@@ -273,7 +284,8 @@ bool ElementText::GenerateLine(String& line, int& line_length, float& line_width
 						next_token_begin = token_begin;
 						BuildToken(token, next_token_begin, partial_string_end, line.empty() && trim_whitespace_prefix, collapse_white_space,
 							break_at_endline, text_transform_property, decode_escape_characters);
-						token_width = font_engine_interface->GetStringWidth(font_face_handle, token, text_shaping_context, previous_codepoint);
+						token_width =
+							TextWidthCache::GetStringWidth(font_engine_interface, font_face_handle, token, text_shaping_context, previous_codepoint);
 
 						if (force_loop_break_at_end || token_width <= max_token_width)
 							break;
@@ -308,18 +320,30 @@ bool ElementText::GenerateLine(String& line, int& line_length, float& line_width
 void ElementText::ClearLines()
 {
 	RMLUI_ZoneScoped;
-	lines.clear();
+
+	// Keep the cleared lines, so that their meshes can be reused by identical lines added during the next layout.
+	if (!lines.empty())
+	{
+		previous_lines = std::move(lines);
+		lines.clear();
+	}
+
 	generated_decoration = Style::TextDecoration::None;
+	DirtyRender();
 }
 
 void ElementText::AddLine(Vector2f line_position, String line)
 {
-	if (font_effects_dirty)
-		UpdateFontEffects();
+	if (font_effects_dirty && UpdateFontEffects())
+		line_meshes_dirty = true;
 
 	lines.emplace_back(std::move(line), line_position);
 
+	if (!line_meshes_dirty)
+		ReuseLineMeshes(lines.back());
+
 	geometry_dirty = true;
+	DirtyRender();
 }
 
 void ElementText::SuppressAutoLayout()
@@ -367,6 +391,7 @@ void ElementText::OnPropertyChange(const PropertyIdSet& changed_properties)
 	{
 		font_face_changed = true;
 		geometry_dirty = true;
+		line_meshes_dirty = true;
 
 		font_effects_handle = 0;
 		font_effects_dirty = true;
@@ -393,7 +418,7 @@ void ElementText::OnPropertyChange(const PropertyIdSet& changed_properties)
 	}
 	else if (colour_changed)
 	{
-		// Force the geometry to be regenerated.
+		// Force the geometry to be rebuilt, this recolours the line meshes when possible.
 		geometry_dirty = true;
 
 		// Re-colour the decoration geometry.
@@ -423,27 +448,129 @@ bool ElementText::UpdateFontEffects()
 
 	font_effects_dirty = false;
 
+	// Request a font layer configuration to match this set of effects. If this is different from
+	// our old configuration, then return true to indicate we'll need to regenerate geometry.
+	FontEffectsHandle new_font_effects_handle = GetFontEngineInterface()->PrepareFontEffects(GetFontFaceHandle(), GetFontEffects());
+	if (new_font_effects_handle != font_effects_handle)
+	{
+		font_effects_handle = new_font_effects_handle;
+		return true;
+	}
+
+	return false;
+}
+
+const FontEffectList& ElementText::GetFontEffects()
+{
 	static const FontEffectList empty_font_effects;
 
 	// Fetch the font-effect for this text element
-	const FontEffectList* font_effects = &empty_font_effects;
 	if (GetComputedValues().has_font_effect())
 	{
 		if (const Property* p = GetProperty(PropertyId::FontEffect))
 			if (FontEffectsPtr effects = p->Get<FontEffectsPtr>())
-				font_effects = &effects->list;
+				return effects->list;
 	}
 
-	// Request a font layer configuration to match this set of effects. If this is different from
-	// our old configuration, then return true to indicate we'll need to regenerate geometry.
-	FontEffectsHandle new_font_effects_handle = GetFontEngineInterface()->PrepareFontEffects(GetFontFaceHandle(), *font_effects);
-	if (new_font_effects_handle != font_effects_handle)
+	return empty_font_effects;
+}
+
+void ElementText::ReuseLineMeshes(Line& line)
+{
+	// Lines are usually added again in the same order as before, only consider the previous line at the same index.
+	const size_t index = lines.size() - 1;
+	if (index >= previous_lines.size())
+		return;
+
+	Line& previous_line = previous_lines[index];
+	if (!previous_line.meshes_generated || previous_line.text != line.text)
+		return;
+
+	// Glyph positions are rounded when generated, thus only whole-pixel offsets give identical meshes when translated.
+	const Vector2f offset = line.position - previous_line.position;
+	if (offset != offset.Round())
+		return;
+
+	line.width = previous_line.width;
+	line.meshes = std::move(previous_line.meshes);
+	line.mesh_shaders = std::move(previous_line.mesh_shaders);
+	line.glyph_pins = std::move(previous_line.glyph_pins);
+	line.meshes_generated = true;
+	previous_line.meshes_generated = false;
+
+	if (offset != Vector2f(0.f))
 	{
-		font_effects_handle = new_font_effects_handle;
+		for (TexturedMesh& textured_mesh : line.meshes)
+		{
+			for (Vertex& vertex : textured_mesh.mesh.vertices)
+				vertex.position += offset;
+		}
+	}
+}
+
+bool ElementText::RecolourLineMeshes()
+{
+	// The vertex colours of text are derived from the text colour, or from the colour of each font effect. Map each colour the meshes were
+	// generated with to its current value. Glyphs with their own colours, such as emojis, take their vertex colour from the text's alpha.
+	struct ColourMapping {
+		ColourbPremultiplied from, to;
+	};
+	Vector<ColourMapping> mappings;
+
+	auto AddMapping = [&mappings](ColourbPremultiplied from, ColourbPremultiplied to) {
+		for (const ColourMapping& mapping : mappings)
+		{
+			if (mapping.from == from)
+				return mapping.to == to;
+		}
+		mappings.push_back(ColourMapping{from, to});
 		return true;
+	};
+
+	bool result = AddMapping(line_meshes_colour, colour) &&
+		AddMapping(ColourbPremultiplied(line_meshes_colour.alpha, line_meshes_colour.alpha), ColourbPremultiplied(colour.alpha, colour.alpha));
+
+	for (const SharedPtr<const FontEffect>& font_effect : GetFontEffects())
+	{
+		const Colourb effect_colour = font_effect->GetColour();
+		result = result && AddMapping(effect_colour.ToPremultiplied(line_meshes_opacity), effect_colour.ToPremultiplied(opacity));
 	}
 
-	return false;
+	if (!result)
+		return false;
+
+	auto FindMapping = [&mappings](ColourbPremultiplied from) -> const ColourMapping* {
+		for (const ColourMapping& mapping : mappings)
+		{
+			if (mapping.from == from)
+				return &mapping;
+		}
+		return nullptr;
+	};
+
+	// Make sure every vertex colour is known before modifying any of them, otherwise the font engine must have coloured them differently.
+	for (const Line& line : lines)
+	{
+		for (const TexturedMesh& textured_mesh : line.meshes)
+		{
+			for (const Vertex& vertex : textured_mesh.mesh.vertices)
+			{
+				if (!FindMapping(vertex.colour))
+					return false;
+			}
+		}
+	}
+
+	for (Line& line : lines)
+	{
+		for (TexturedMesh& textured_mesh : line.meshes)
+		{
+			for (Vertex& vertex : textured_mesh.mesh.vertices)
+				vertex.colour = FindMapping(vertex.colour)->to;
+		}
+	}
+
+	return true;
 }
 
 void ElementText::GenerateGeometry(RenderManager& render_manager, const FontFaceHandle font_face_handle)
@@ -453,14 +580,61 @@ void ElementText::GenerateGeometry(RenderManager& render_manager, const FontFace
 	const auto& computed = GetComputedValues();
 	const TextShapingContext text_shaping_context{computed.language(), computed.direction(), computed.letter_spacing()};
 
+	// Lines reused from the previous layout were generated with the old colour, they are recoloured along with the other lines.
+	if (!line_meshes_dirty && (line_meshes_colour != colour || line_meshes_opacity != opacity) && !RecolourLineMeshes())
+		line_meshes_dirty = true;
+
+	if (line_meshes_dirty)
+	{
+		for (Line& line : lines)
+		{
+			line.meshes.clear();
+			line.mesh_shaders.clear();
+			line.glyph_pins.clear();
+			line.meshes_generated = false;
+		}
+	}
+
+	line_meshes_dirty = false;
+	line_meshes_colour = colour;
+	line_meshes_opacity = opacity;
+	previous_lines.clear();
+
+	// Generate the meshes of any new lines, each line is generated separately so that its meshes can be cached.
+	for (Line& line : lines)
+	{
+		if (line.meshes_generated)
+			continue;
+
+		line.width = TextGeometry::GenerateString(render_manager, font_face_handle, font_effects_handle, line.text, line.position, colour, opacity,
+			text_shaping_context, line.meshes, line.mesh_shaders, line.glyph_pins);
+		line.meshes_generated = true;
+	}
+
+	// Combine the meshes of all lines, meshes at the same index in each line normally share the same texture.
 	TexturedMeshList mesh_list;
+	Vector<const CompiledShader*> mesh_shaders;
 	mesh_list.reserve(geometry.size());
+	mesh_shaders.reserve(geometry.size());
 
-	// Generate the new geometry, one line at a time.
-	for (size_t i = 0; i < lines.size(); ++i)
+	for (const Line& line : lines)
 	{
-		lines[i].width = GetFontEngineInterface()->GenerateString(render_manager, font_face_handle, font_effects_handle, lines[i].text,
-			lines[i].position, colour, opacity, text_shaping_context, mesh_list);
+		for (size_t i = 0; i < line.meshes.size(); i++)
+		{
+			const TexturedMesh& line_mesh = line.meshes[i];
+			if (i >= mesh_list.size() || !(mesh_list[i].texture == line_mesh.texture) || mesh_shaders[i] != line.mesh_shaders[i])
+			{
+				mesh_list.push_back(line_mesh);
+				mesh_shaders.push_back(line.mesh_shaders[i]);
+				continue;
+			}
+
+			Mesh& mesh = mesh_list[i].mesh;
+			const int index_offset = (int)mesh.vertices.size();
+			mesh.vertices.insert(mesh.vertices.end(), line_mesh.mesh.vertices.begin(), line_mesh.mesh.vertices.end());
+			for (int index : line_mesh.mesh.indices)
+				mesh.indices.push_back(index + index_offset);
+		}
 	}
 
 	// Apply the new geometry and textures. Reuse the old geometry if the mesh matches, which can be relatively common
@@ -472,6 +646,7 @@ void ElementText::GenerateGeometry(RenderManager& render_manager, const FontFace
 			geometry[i].geometry = render_manager.MakeGeometry(std::move(mesh_list[i].mesh));
 
 		geometry[i].texture = mesh_list[i].texture;
+		geometry[i].shader = mesh_shaders[i];
 	}
 
 	generated_decoration = Style::TextDecoration::None;
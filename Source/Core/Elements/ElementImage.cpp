@@ -217,6 +217,7 @@ bool ElementImage::LoadTexture()
 	texture_dirty = false;
 	geometry_dirty = true;
 	dimensions_scale = 1.0f;
+	DirtyRender();
 
 	RenderManager* render_manager = GetRenderManager();
 	if (!render_manager)
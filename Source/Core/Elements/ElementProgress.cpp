@@ -339,6 +339,7 @@ void ElementProgress::GenerateGeometry()
 bool ElementProgress::LoadTexture()
 {
 	geometry_dirty = true;
+	DirtyRender();
 	rect_set = false;
 
 	String name;
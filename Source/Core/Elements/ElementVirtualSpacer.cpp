@@ -26,71 +26,37 @@
  *
  */
 
-#include "TextureLayoutRectangle.h"
+#include "ElementVirtualSpacer.h"
+#include "../DataViewDefault.h"
 
 namespace Rml {
 
-TextureLayoutRectangle::TextureLayoutRectangle(const int _id, const Vector2i dimensions) : dimensions(dimensions), texture_position(0, 0)
+ElementVirtualSpacer::ElementVirtualSpacer(const String& tag) : Element(tag), view(nullptr), height(0.f)
 {
-	id = _id;
-	texture_index = -1;
-
-	texture_data = nullptr;
-	texture_stride = 0;
-}
-
-TextureLayoutRectangle::~TextureLayoutRectangle() {}
-
-int TextureLayoutRectangle::GetId() const
-{
-	return id;
-}
-
-Vector2i TextureLayoutRectangle::GetPosition() const
-{
-	return texture_position;
-}
-
-Vector2i TextureLayoutRectangle::GetDimensions() const
-{
-	return dimensions;
+	SetProperty(PropertyId::Display, Property(Style::Display::Block));
+	SetProperty(PropertyId::Height, Property(0.f, Unit::PX));
 }
 
-void TextureLayoutRectangle::Place(const int _texture_index, const Vector2i position)
-{
-	texture_index = _texture_index;
-	texture_position = position;
-}
-
-void TextureLayoutRectangle::Unplace()
-{
-	texture_index = -1;
-}
-
-bool TextureLayoutRectangle::IsPlaced() const
-{
-	return texture_index > -1;
-}
-
-void TextureLayoutRectangle::Allocate(byte* _texture_data, int _texture_stride)
-{
-	texture_data = _texture_data + ((texture_position.y * _texture_stride) + texture_position.x * 4);
-	texture_stride = _texture_stride;
-}
+ElementVirtualSpacer::~ElementVirtualSpacer() {}
 
-int TextureLayoutRectangle::GetTextureIndex()
+void ElementVirtualSpacer::SetView(DataViewFor* _view)
 {
-	return texture_index;
+	view = _view;
 }
 
-byte* TextureLayoutRectangle::GetTextureData()
+void ElementVirtualSpacer::SetHeight(float new_height)
 {
-	return texture_data;
+	if (new_height != height)
+	{
+		height = new_height;
+		SetProperty(PropertyId::Height, Property(height, Unit::PX));
+	}
 }
 
-int TextureLayoutRectangle::GetTextureStride() const
+void ElementVirtualSpacer::OnLayout()
 {
-	return texture_stride;
+	if (view)
+		view->OnSpacerLayout();
 }
 
 } // namespace Rml
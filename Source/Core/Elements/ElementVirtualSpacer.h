@@ -26,50 +26,39 @@
  *
  */
 
-#ifndef TEXTURELAYOUTROW_H
-#define TEXTURELAYOUTROW_H
+#ifndef RMLUI_CORE_ELEMENTS_ELEMENTVIRTUALSPACER_H
+#define RMLUI_CORE_ELEMENTS_ELEMENTVIRTUALSPACER_H
 
-#include "TextureLayoutRectangle.h"
+#include "../../../Include/RmlUi/Core/Element.h"
 
 namespace Rml {
 
-class TextureLayout;
+class DataViewFor;
 
 /**
-    A texture layout row is a single row of rectangles positioned vertically within a texture.
-
-    @author Peter
+    A block element used by virtualized data-for views to stand in for the rows which are not instanced. The view is
+    notified whenever the spacer is laid out, so that it can re-evaluate which rows intersect the scroll viewport.
  */
 
-class TextureLayoutRow {
+class ElementVirtualSpacer : public Element {
 public:
-	TextureLayoutRow();
-	~TextureLayoutRow();
+	RMLUI_RTTI_DefineWithParent(ElementVirtualSpacer, Element)
 
-	/// Attempts to position unplaced rectangles from the layout into this row.
-	/// @param[in] layout The layout to position rectangles from.
-	/// @param[in] width The maximum width of this row.
-	/// @param[in] y The y-coordinate of this row.
-	/// @return The number of placed rectangles.
-	int Generate(TextureLayout& layout, int width, int y);
+	ElementVirtualSpacer(const String& tag);
+	virtual ~ElementVirtualSpacer();
 
-	/// Assigns allocated texture data to all rectangles in this row.
-	/// @param[in] texture_data The pointer to the beginning of the texture's data.
-	/// @param[in] stride The stride of the texture's surface, in bytes;
-	void Allocate(byte* texture_data, int stride);
+	/// Set the data view that this spacer was created for, or nullptr to detach it from the view.
+	void SetView(DataViewFor* view);
 
-	/// Returns the height of the row.
-	/// @return The row's height.
-	int GetHeight() const;
+	/// Set the height of the spacer, in pixels.
+	void SetHeight(float height);
 
-	/// Resets the placed status for all of the rectangles within this row.
-	void Unplace();
+protected:
+	void OnLayout() override;
 
 private:
-	using RectangleList = Vector<TextureLayoutRectangle*>;
-
-	int height;
-	RectangleList rectangles;
+	DataViewFor* view;
+	float height;
 };
 
 } // namespace Rml
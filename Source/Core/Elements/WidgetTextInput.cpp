@@ -452,6 +452,7 @@ void WidgetTextInput::OnUpdate()
 		{
 			cursor_timer += CURSOR_BLINK_TIME;
 			cursor_visible = !cursor_visible;
+			parent->DirtyRender();
 		}
 
 		if (parent->IsVisible(true))
@@ -1139,6 +1140,8 @@ int WidgetTextInput::CalculateCharacterIndex(int line_index, float position)
 
 void WidgetTextInput::ShowCursor(bool show, bool move_to_cursor)
 {
+	parent->DirtyRender();
+
 	if (show)
 	{
 		cursor_visible = true;
@@ -1397,6 +1400,7 @@ Vector2f WidgetTextInput::FormatText(float height_constraint)
 	absolute_cursor_index = Math::Min(absolute_cursor_index, (int)GetValue().size());
 
 	selection_composition_geometry = parent->GetRenderManager()->MakeGeometry(std::move(selection_composition_mesh));
+	parent->DirtyRender();
 
 	// Overflow is automatically caught by any text overflowing the content area. However, sometimes it is possible that
 	// the selection box extends beyond the text and outside the content area. This can even overflow the element
@@ -1431,6 +1435,7 @@ void WidgetTextInput::GenerateCursor()
 	Mesh mesh = cursor_geometry.Release(Geometry::ReleaseMode::ClearMesh);
 	MeshUtilities::GenerateQuad(mesh, Vector2f(0, 0), cursor_size, color.ToPremultiplied());
 	cursor_geometry = parent->GetRenderManager()->MakeGeometry(std::move(mesh));
+	parent->DirtyRender();
 }
 
 void WidgetTextInput::ForceFormattingOnNextLayout()
@@ -1462,6 +1467,8 @@ void WidgetTextInput::UpdateCursorPosition(bool update_ideal_cursor_position)
 
 	if (update_ideal_cursor_position)
 		ideal_cursor_position = cursor_position.x;
+
+	parent->DirtyRender();
 }
 
 bool WidgetTextInput::UpdateSelection(bool selecting)
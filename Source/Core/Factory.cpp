@@ -61,6 +61,7 @@
 #include "Elements/ElementImage.h"
 #include "Elements/ElementLabel.h"
 #include "Elements/ElementTextSelection.h"
+#include "Elements/ElementVirtualSpacer.h"
 #include "Elements/XMLNodeHandlerSelect.h"
 #include "Elements/XMLNodeHandlerTabSet.h"
 #include "Elements/XMLNodeHandlerTextArea.h"
@@ -106,6 +107,7 @@ struct DefaultInstancers {
 	ElementInstancerGeneric<ElementFormControlTextArea> textarea;
 	ElementInstancerGeneric<ElementTextSelection> selection;
 	ElementInstancerGeneric<ElementTabSet> tabset;
+	ElementInstancerGeneric<ElementVirtualSpacer> virtual_spacer;
 
 	ElementInstancerGeneric<ElementProgress> progress;
 
@@ -217,6 +219,7 @@ void Factory::Initialise()
 	RegisterElementInstancer("textarea", &default_instancers.textarea);
 	RegisterElementInstancer("#selection", &default_instancers.selection);
 	RegisterElementInstancer("tabset", &default_instancers.tabset);
+	RegisterElementInstancer("#spacer", &default_instancers.virtual_spacer);
 
 	RegisterElementInstancer("progress", &default_instancers.progress);
 	RegisterElementInstancer("progressbar", &default_instancers.progress);
@@ -276,6 +279,9 @@ void Factory::Initialise()
 	RegisterDataViewInstancer(&default_instancers.structural_data_view_for, "for",     true );
 	// clang-format on
 
+	// Virtualized 'data-for-virtual' loops are handled by the 'for' view too, their inner RML must be passed on to the view as well.
+	factory_data->structural_data_view_attribute_names.push_back("data-for-virtual");
+
 	// Data binding controllers
 	RegisterDataControllerInstancer(&default_instancers.data_controller_value, "checked");
 	RegisterDataControllerInstancer(&default_instancers.data_controller_event, "event");
@@ -114,6 +114,13 @@ void FontEffectBlur::GenerateGlyphTexture(byte* destination_data, const Vector2i
 	FillColorValuesFromAlpha(destination_data, destination_dimensions, destination_stride);
 }
 
+bool FontEffectBlur::GetDistanceFieldParameters(DistanceFieldParameters& parameters) const
+{
+	// A Gaussian blur of the given radius fades out over roughly twice its width.
+	parameters.softness = float(2 * width);
+	return true;
+}
+
 FontEffectBlurInstancer::FontEffectBlurInstancer() : id_width(PropertyId::Invalid), id_color(PropertyId::Invalid)
 {
 	id_width = RegisterProperty("width", "1px", true).AddParser("length").GetId();
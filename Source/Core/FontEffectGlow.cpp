@@ -144,6 +144,14 @@ void FontEffectGlow::GenerateGlyphTexture(byte* destination_data, const Vector2i
 	FillColorValuesFromAlpha(destination_data, destination_dimensions, destination_stride);
 }
 
+bool FontEffectGlow::GetDistanceFieldParameters(DistanceFieldParameters& parameters) const
+{
+	parameters.dilation = float(width_outline);
+	parameters.softness = float(2 * width_blur);
+	parameters.offset = Vector2f(offset);
+	return true;
+}
+
 FontEffectGlowInstancer::FontEffectGlowInstancer() :
 	id_width_outline(PropertyId::Invalid), id_width_blur(PropertyId::Invalid), id_color(PropertyId::Invalid)
 {
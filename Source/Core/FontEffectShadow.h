@@ -51,6 +51,8 @@ public:
 
 	bool GetGlyphMetrics(Vector2i& origin, Vector2i& dimensions, const FontGlyph& glyph) const override;
 
+	bool GetDistanceFieldParameters(DistanceFieldParameters& parameters) const override;
+
 private:
 	Vector2i offset;
 };
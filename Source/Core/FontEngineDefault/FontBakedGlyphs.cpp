@@ -0,0 +1,336 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "FontBakedGlyphs.h"
+#include "../../../Include/RmlUi/Core/Log.h"
+#include <algorithm>
+#include <string.h>
+#include <type_traits>
+
+namespace Rml {
+
+static constexpr char baked_glyphs_magic[8] = {'R', 'M', 'L', 'F', 'O', 'N', 'T', 'B'};
+static constexpr uint32_t baked_glyphs_version = 1;
+// Written in the native byte order, used to reject data baked on a platform of different endianness.
+static constexpr uint32_t baked_glyphs_byte_order = 0x01020304;
+
+namespace {
+	class BakedWriter {
+	public:
+		explicit BakedWriter(Vector<byte>& out) : out(out) {}
+
+		template <typename T>
+		void Write(const T& value)
+		{
+			static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable values can be written.");
+			WriteBytes(reinterpret_cast<const byte*>(&value), sizeof(T));
+		}
+		void WriteString(const String& value)
+		{
+			Write(uint32_t(value.size()));
+			WriteBytes(reinterpret_cast<const byte*>(value.data()), value.size());
+		}
+		void WriteBytes(const byte* data, size_t size)
+		{
+			if (size > 0)
+				out.insert(out.end(), data, data + size);
+		}
+
+	private:
+		Vector<byte>& out;
+	};
+
+	class BakedReader {
+	public:
+		BakedReader(const byte* data, size_t size) : data(data), size(size) {}
+
+		template <typename T>
+		bool Read(T& value)
+		{
+			static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable values can be read.");
+			const byte* source = ReadBytes(sizeof(T));
+			if (!source)
+				return false;
+			memcpy(&value, source, sizeof(T));
+			return true;
+		}
+		bool ReadString(String& value)
+		{
+			uint32_t length = 0;
+			const byte* source = (Read(length) ? ReadBytes(length) : nullptr);
+			if (!source)
+				return false;
+			value.assign(reinterpret_cast<const char*>(source), length);
+			return true;
+		}
+		// Returns true if the remaining data can hold the given number of records, each occupying at least the given number of bytes.
+		bool CanHold(size_t count, size_t record_size) const { return count <= (size - offset) / record_size; }
+		// Returns a pointer to the next bytes of the data, or nullptr if the data is too short.
+		const byte* ReadBytes(size_t num_bytes)
+		{
+			if (num_bytes > size - offset)
+				return nullptr;
+			const byte* result = data + offset;
+			offset += num_bytes;
+			return result;
+		}
+
+	private:
+		const byte* data;
+		size_t size;
+		size_t offset = 0;
+	};
+} // namespace
+
+static size_t GetBitmapSize(Vector2i dimensions, ColorFormat color_format)
+{
+	return size_t(dimensions.x) * size_t(dimensions.y) * (color_format == ColorFormat::RGBA8 ? 4 : 1);
+}
+
+static bool ReadHandle(BakedReader& reader, FontBakedGlyphs::Handle& handle)
+{
+	uint8_t style = 0;
+	uint16_t weight = 0;
+	uint32_t num_glyphs = 0;
+	if (!reader.ReadString(handle.family) || !reader.Read(style) || !reader.Read(weight) || !reader.Read(handle.metrics) ||
+		!reader.Read(num_glyphs))
+		return false;
+
+	handle.style = Style::FontStyle(style);
+	handle.weight = Style::FontWeight(weight);
+
+	const size_t glyph_record_size = sizeof(char32_t) + sizeof(FontGlyph::bearing) + sizeof(FontGlyph::advance) +
+		sizeof(FontGlyph::bitmap_dimensions) + sizeof(uint8_t);
+	if (!reader.CanHold(num_glyphs, glyph_record_size))
+		return false;
+
+	handle.glyphs.reserve(num_glyphs);
+	for (uint32_t i = 0; i < num_glyphs; i++)
+	{
+		char32_t character = 0;
+		uint8_t color_format = 0;
+		FontGlyph glyph;
+		if (!reader.Read(character) || !reader.Read(glyph.bearing) || !reader.Read(glyph.advance) || !reader.Read(glyph.bitmap_dimensions) ||
+			!reader.Read(color_format))
+			return false;
+
+		if (glyph.bitmap_dimensions.x < 0 || glyph.bitmap_dimensions.y < 0 || color_format > uint8_t(ColorFormat::A8))
+			return false;
+
+		glyph.color_format = ColorFormat(color_format);
+		const size_t bitmap_size = GetBitmapSize(glyph.bitmap_dimensions, glyph.color_format);
+		if (bitmap_size > 0)
+		{
+			// The glyph refers directly to the loaded data.
+			glyph.bitmap_data = reader.ReadBytes(bitmap_size);
+			if (!glyph.bitmap_data)
+				return false;
+		}
+
+		handle.glyphs[Character(character)] = std::move(glyph);
+	}
+
+	uint32_t num_kerning_pairs = 0;
+	if (!reader.Read(num_kerning_pairs))
+		return false;
+
+	if (!reader.CanHold(num_kerning_pairs, sizeof(uint16_t) + sizeof(int16_t)))
+		return false;
+
+	handle.kerning_pairs.reserve(num_kerning_pairs);
+	for (uint32_t i = 0; i < num_kerning_pairs; i++)
+	{
+		uint16_t pair = 0;
+		int16_t kerning = 0;
+		if (!reader.Read(pair) || !reader.Read(kerning))
+			return false;
+		handle.kerning_pairs[pair] = kerning;
+	}
+
+	uint32_t num_layers = 0;
+	if (!reader.Read(num_layers))
+		return false;
+
+	for (uint32_t i = 0; i < num_layers; i++)
+	{
+		uint64_t fingerprint = 0;
+		uint32_t num_layer_glyphs = 0;
+		if (!reader.Read(fingerprint) || !reader.Read(num_layer_glyphs))
+			return false;
+
+		const size_t layer_glyph_record_size =
+			sizeof(char32_t) + sizeof(FontBakedGlyphs::LayerGlyph::origin) + sizeof(FontBakedGlyphs::LayerGlyph::dimensions);
+		if (!reader.CanHold(num_layer_glyphs, layer_glyph_record_size))
+			return false;
+
+		FontBakedGlyphs::LayerGlyphMap& layer = handle.layers[fingerprint];
+		layer.reserve(num_layer_glyphs);
+		for (uint32_t j = 0; j < num_layer_glyphs; j++)
+		{
+			char32_t character = 0;
+			FontBakedGlyphs::LayerGlyph glyph;
+			if (!reader.Read(character) || !reader.Read(glyph.origin) || !reader.Read(glyph.dimensions))
+				return false;
+
+			if (glyph.dimensions.x < 0 || glyph.dimensions.y < 0)
+				return false;
+
+			glyph.stride = glyph.dimensions.x * 4;
+			glyph.data = reader.ReadBytes(GetBitmapSize(glyph.dimensions, ColorFormat::RGBA8));
+			if (!glyph.data)
+				return false;
+
+			layer[Character(character)] = glyph;
+		}
+	}
+
+	return true;
+}
+
+FontBakedGlyphs::FontBakedGlyphs() {}
+
+FontBakedGlyphs::~FontBakedGlyphs() {}
+
+bool FontBakedGlyphs::Load(UniquePtr<byte[]> _data, size_t size, const String& source)
+{
+	data = std::move(_data);
+	handles.clear();
+
+	BakedReader reader(data.get(), size);
+
+	const byte* magic = reader.ReadBytes(sizeof(baked_glyphs_magic));
+	uint32_t version = 0, byte_order = 0, num_handles = 0;
+	if (!magic || memcmp(magic, baked_glyphs_magic, sizeof(baked_glyphs_magic)) != 0 || !reader.Read(version) || !reader.Read(byte_order))
+	{
+		Log::Message(Log::LT_ERROR, "Failed to load baked font glyphs from '%s', the data is not in the baked glyphs format.", source.c_str());
+		return false;
+	}
+	if (version != baked_glyphs_version || byte_order != baked_glyphs_byte_order)
+	{
+		Log::Message(Log::LT_ERROR, "Failed to load baked font glyphs from '%s', the data was baked by an incompatible version or platform.",
+			source.c_str());
+		return false;
+	}
+
+	bool result = reader.Read(num_handles);
+	for (uint32_t i = 0; result && i < num_handles; i++)
+	{
+		handles.emplace_back();
+		result = ReadHandle(reader, handles.back());
+	}
+
+	if (!result)
+	{
+		Log::Message(Log::LT_ERROR, "Failed to load baked font glyphs from '%s', the data is truncated or corrupt.", source.c_str());
+		handles.clear();
+		return false;
+	}
+
+	return true;
+}
+
+const FontBakedGlyphs::Handle* FontBakedGlyphs::Find(const String& family, Style::FontStyle style, Style::FontWeight weight, int size) const
+{
+	for (const Handle& handle : handles)
+	{
+		if (handle.metrics.size == size && handle.style == style && handle.weight == weight && handle.family == family)
+			return &handle;
+	}
+	return nullptr;
+}
+
+void FontBakedGlyphs::Write(const Vector<Handle>& handles, Vector<byte>& out_data)
+{
+	BakedWriter writer(out_data);
+
+	writer.WriteBytes(reinterpret_cast<const byte*>(baked_glyphs_magic), sizeof(baked_glyphs_magic));
+	writer.Write(baked_glyphs_version);
+	writer.Write(baked_glyphs_byte_order);
+	writer.Write(uint32_t(handles.size()));
+
+	// Sort the glyphs by character, so that baking the same glyphs always produces the same data.
+	auto SortedKeys = [](const auto& map) {
+		using Key = typename std::decay<decltype(map)>::type::key_type;
+		Vector<Key> keys;
+		keys.reserve(map.size());
+		for (const auto& pair : map)
+			keys.push_back(pair.first);
+		std::sort(keys.begin(), keys.end());
+		return keys;
+	};
+
+	for (const Handle& handle : handles)
+	{
+		writer.WriteString(handle.family);
+		writer.Write(uint8_t(handle.style));
+		writer.Write(uint16_t(handle.weight));
+		writer.Write(handle.metrics);
+
+		writer.Write(uint32_t(handle.glyphs.size()));
+		for (Character character : SortedKeys(handle.glyphs))
+		{
+			const FontGlyph& glyph = handle.glyphs.find(character)->second;
+			const bool has_bitmap = (glyph.bitmap_data != nullptr);
+			const Vector2i dimensions = (has_bitmap ? glyph.bitmap_dimensions : Vector2i(0, 0));
+
+			writer.Write(char32_t(character));
+			writer.Write(glyph.bearing);
+			writer.Write(glyph.advance);
+			writer.Write(dimensions);
+			writer.Write(uint8_t(glyph.color_format));
+			if (has_bitmap)
+				writer.WriteBytes(glyph.bitmap_data, GetBitmapSize(dimensions, glyph.color_format));
+		}
+
+		writer.Write(uint32_t(handle.kerning_pairs.size()));
+		for (uint16_t pair : SortedKeys(handle.kerning_pairs))
+		{
+			writer.Write(pair);
+			writer.Write(handle.kerning_pairs.find(pair)->second);
+		}
+
+		writer.Write(uint32_t(handle.layers.size()));
+		for (uint64_t fingerprint : SortedKeys(handle.layers))
+		{
+			const LayerGlyphMap& layer = handle.layers.find(fingerprint)->second;
+			writer.Write(fingerprint);
+			writer.Write(uint32_t(layer.size()));
+			for (Character character : SortedKeys(layer))
+			{
+				const LayerGlyph& glyph = layer.find(character)->second;
+				writer.Write(char32_t(character));
+				writer.Write(glyph.origin);
+				writer.Write(glyph.dimensions);
+				for (int y = 0; y < glyph.dimensions.y; y++)
+					writer.WriteBytes(glyph.data + y * glyph.stride, size_t(glyph.dimensions.x) * 4);
+			}
+		}
+	}
+}
+
+} // namespace Rml
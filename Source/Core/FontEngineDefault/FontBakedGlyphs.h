@@ -0,0 +1,92 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef RMLUI_CORE_FONTENGINEDEFAULT_FONTBAKEDGLYPHS_H
+#define RMLUI_CORE_FONTENGINEDEFAULT_FONTBAKEDGLYPHS_H
+
+#include "../../../Include/RmlUi/Core/FontGlyph.h"
+#include "../../../Include/RmlUi/Core/FontMetrics.h"
+#include "../../../Include/RmlUi/Core/StyleTypes.h"
+#include "../../../Include/RmlUi/Core/Traits.h"
+#include "../../../Include/RmlUi/Core/Types.h"
+
+namespace Rml {
+
+/**
+    Glyphs of font face handles baked ahead of time, so that they can be used without rasterizing them again.
+
+    The baked data contains the metrics, glyphs, and kerning pairs of each handle, along with the texture data of its font effect layers. All
+    glyph data refers directly to the loaded data, which must thus be kept alive for as long as any handle uses it.
+ */
+class FontBakedGlyphs : NonCopyMoveable {
+public:
+	/// A glyph of a font effect layer.
+	struct LayerGlyph {
+		// The offset of the glyph's geometry from its position on the baseline.
+		Vector2f origin;
+		Vector2i dimensions;
+		// The texture data of the glyph in premultiplied RGBA8 format.
+		const byte* data = nullptr;
+		int stride = 0;
+	};
+	using LayerGlyphMap = UnorderedMap<Character, LayerGlyph>;
+	using KerningPairs = UnorderedMap<uint16_t, int16_t>;
+
+	/// The glyphs of a font face at a single size.
+	struct Handle {
+		String family;
+		Style::FontStyle style = Style::FontStyle::Normal;
+		Style::FontWeight weight = Style::FontWeight::Normal;
+		FontMetrics metrics = {};
+
+		FontGlyphMap glyphs;
+		KerningPairs kerning_pairs;
+		// The layers of font effects with unique textures, indexed by the fingerprint of their effect.
+		UnorderedMap<uint64_t, LayerGlyphMap> layers;
+	};
+
+	FontBakedGlyphs();
+	~FontBakedGlyphs();
+
+	/// Parses the baked data, taking ownership of it.
+	/// @return True if the data was parsed successfully, false otherwise.
+	bool Load(UniquePtr<byte[]> data, size_t size, const String& source);
+
+	/// Returns the baked handle of the given font face and size, or nullptr if none was baked.
+	const Handle* Find(const String& family, Style::FontStyle style, Style::FontWeight weight, int size) const;
+
+	/// Serializes the given handles into a form which can later be loaded.
+	static void Write(const Vector<Handle>& handles, Vector<byte>& out_data);
+
+private:
+	UniquePtr<byte[]> data;
+	Vector<Handle> handles;
+};
+
+} // namespace Rml
+#endif
@@ -33,13 +33,18 @@
 
 namespace Rml {
 
+// The instance which is initialized as the font engine in use, if any.
+static FontEngineInterfaceDefault* active_instance = nullptr;
+
 void FontEngineInterfaceDefault::Initialize()
 {
 	FontProvider::Initialise();
+	active_instance = this;
 }
 
 void FontEngineInterfaceDefault::Shutdown()
 {
+	active_instance = nullptr;
 	FontProvider::Shutdown();
 }
 
@@ -88,6 +93,15 @@ int FontEngineInterfaceDefault::GenerateString(RenderManager& render_manager, Fo
 		(int)font_effects_handle);
 }
 
+int FontEngineInterfaceDefault::GenerateString(RenderManager& render_manager, FontFaceHandle handle, FontEffectsHandle font_effects_handle,
+	StringView string, Vector2f position, ColourbPremultiplied colour, float opacity, const TextShapingContext& text_shaping_context,
+	TexturedMeshList& mesh_list, Vector<const CompiledShader*>& mesh_shaders, Vector<SharedPtr<const void>>& glyph_pins)
+{
+	auto handle_default = reinterpret_cast<FontFaceHandleDefault*>(handle);
+	return handle_default->GenerateString(render_manager, mesh_list, string, position, colour, opacity, text_shaping_context.letter_spacing,
+		(int)font_effects_handle, &mesh_shaders, &glyph_pins);
+}
+
 int FontEngineInterfaceDefault::GetVersion(FontFaceHandle handle)
 {
 	auto handle_default = reinterpret_cast<FontFaceHandleDefault*>(handle);
@@ -99,4 +113,9 @@ void FontEngineInterfaceDefault::ReleaseFontResources()
 	FontProvider::ReleaseFontResources();
 }
 
+FontEngineInterfaceDefault* FontEngineInterfaceDefault::GetActive()
+{
+	return active_instance;
+}
+
 } // namespace Rml
@@ -32,6 +32,8 @@
 
 namespace Rml {
 
+class CompiledShader;
+
 class RMLUICORE_API FontEngineInterfaceDefault : public FontEngineInterface {
 public:
 	/// Called when RmlUi is being initialized.
@@ -65,12 +67,21 @@ public:
 	int GenerateString(RenderManager& render_manager, FontFaceHandle face_handle, FontEffectsHandle effects_handle, StringView string,
 		Vector2f position, ColourbPremultiplied colour, float opacity, const TextShapingContext& text_shaping_context,
 		TexturedMeshList& mesh_list) override;
+	/// Generates the geometry of a single line of text, along with the shader to render each mesh with, or nullptr for meshes rendered without
+	/// one. Glyphs rendered from distance fields can only be displayed using their shader. The glyph pins protect the glyphs used by the meshes
+	/// from being evicted from the glyph atlas, and should be held for as long as the meshes may be rendered.
+	int GenerateString(RenderManager& render_manager, FontFaceHandle face_handle, FontEffectsHandle effects_handle, StringView string,
+		Vector2f position, ColourbPremultiplied colour, float opacity, const TextShapingContext& text_shaping_context, TexturedMeshList& mesh_list,
+		Vector<const CompiledShader*>& mesh_shaders, Vector<SharedPtr<const void>>& glyph_pins);
 
 	/// Returns the current version of the font face.
 	int GetVersion(FontFaceHandle handle) override;
 
 	/// Releases resources owned by sized font faces, including their textures and rendered glyphs.
 	void ReleaseFontResources() override;
+
+	/// Returns the default font engine if it is the one in use, otherwise nullptr.
+	static FontEngineInterfaceDefault* GetActive();
 };
 
 } // namespace Rml
@@ -28,13 +28,17 @@
 
 #include "FontFace.h"
 #include "../../../Include/RmlUi/Core/Log.h"
+#include "FontFaceDistanceField.h"
 #include "FontFaceHandleDefault.h"
+#include "FontProvider.h"
 #include "FreeTypeInterface.h"
+#include <algorithm>
 
 namespace Rml {
 
-FontFace::FontFace(FontFaceHandleFreetype _face, Style::FontStyle _style, Style::FontWeight _weight)
+FontFace::FontFace(FontFaceHandleFreetype _face, const String& _family, Style::FontStyle _style, Style::FontWeight _weight)
 {
+	family = _family;
 	style = _style;
 	weight = _weight;
 	face = _face;
@@ -69,9 +73,14 @@ FontFaceHandleDefault* FontFace::GetHandle(int size, bool load_default_glyphs)
 		return nullptr;
 	}
 
-	// Construct and initialise the new handle.
+	// Glyphs of all sizes are rendered from the same distance fields, when enabled and supported by the face.
+	if (!distance_field && FontProvider::UsesDistanceFieldRendering() && FreeType::HasMonochromeOutlines(face))
+		distance_field = MakeUnique<FontFaceDistanceField>(face);
+
+	// Construct and initialise the new handle, from the baked glyphs of this size if available.
+	const FontBakedGlyphs::Handle* baked = FontProvider::FindBakedHandle(family, style, weight, size);
 	auto handle = MakeUnique<FontFaceHandleDefault>();
-	if (!handle->Initialize(face, size, load_default_glyphs))
+	if (!handle->Initialize(face, size, load_default_glyphs, distance_field.get(), baked))
 	{
 		handles[size] = nullptr;
 		return nullptr;
@@ -88,6 +97,29 @@ FontFaceHandleDefault* FontFace::GetHandle(int size, bool load_default_glyphs)
 void FontFace::ReleaseFontResources()
 {
 	HandleMap().swap(handles);
+	distance_field.reset();
+}
+
+void FontFace::Bake(Vector<FontBakedGlyphs::Handle>& baked_handles)
+{
+	// Bake the handles in order of size, so that baking the same handles always produces the same data.
+	Vector<int> sizes;
+	for (const auto& pair : handles)
+	{
+		if (pair.second)
+			sizes.push_back(pair.first);
+	}
+	std::sort(sizes.begin(), sizes.end());
+
+	for (int size : sizes)
+	{
+		FontBakedGlyphs::Handle baked_handle;
+		baked_handle.family = family;
+		baked_handle.style = style;
+		baked_handle.weight = weight;
+		if (handles[size]->Bake(baked_handle))
+			baked_handles.push_back(std::move(baked_handle));
+	}
 }
 
 } // namespace Rml
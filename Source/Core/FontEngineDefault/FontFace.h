@@ -30,10 +30,12 @@
 #define RMLUI_CORE_FONTENGINEDEFAULT_FONTFACE_H
 
 #include "../../../Include/RmlUi/Core/StyleTypes.h"
+#include "FontBakedGlyphs.h"
 #include "FontTypes.h"
 
 namespace Rml {
 
+class FontFaceDistanceField;
 class FontFaceHandleDefault;
 
 /**
@@ -42,7 +44,7 @@ class FontFaceHandleDefault;
 
 class FontFace {
 public:
-	FontFace(FontFaceHandleFreetype face, Style::FontStyle style, Style::FontWeight weight);
+	FontFace(FontFaceHandleFreetype face, const String& family, Style::FontStyle style, Style::FontWeight weight);
 	~FontFace();
 
 	Style::FontStyle GetStyle() const;
@@ -57,10 +59,18 @@ public:
 	/// Releases resources owned by sized font faces, including their textures and rendered glyphs.
 	void ReleaseFontResources();
 
+	/// Adds the glyphs of all handles of this face to the list of baked handles.
+	void Bake(Vector<FontBakedGlyphs::Handle>& baked_handles);
+
 private:
+	String family;
 	Style::FontStyle style;
 	Style::FontWeight weight;
 
+	// The distance fields shared by all handles, when glyphs are rendered from distance fields. Declared before the handles, so that it
+	// outlives them.
+	UniquePtr<FontFaceDistanceField> distance_field;
+
 	// Key is font size
 	using HandleMap = UnorderedMap<int, UniquePtr<FontFaceHandleDefault>>;
 	HandleMap handles;
@@ -0,0 +1,230 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "FontFaceDistanceField.h"
+#include "../../../Include/RmlUi/Core/FontGlyph.h"
+#include "../../../Include/RmlUi/Core/FontMetrics.h"
+#include "../../../Include/RmlUi/Core/Math.h"
+#include "FontProvider.h"
+#include "FreeTypeInterface.h"
+
+namespace Rml {
+
+static constexpr float distance_infinity = 1e20f;
+
+// Computes the one-dimensional squared Euclidean distance transform of 'grid' in-place, along 'length' elements separated by 'step'.
+// Based on "Distance Transforms of Sampled Functions" by Felzenszwalb and Huttenlocher.
+static void DistanceTransform1D(float* grid, int offset, int step, int length, float* f, float* z, int* v)
+{
+	for (int q = 0; q < length; q++)
+		f[q] = grid[offset + q * step];
+
+	int k = 0;
+	v[0] = 0;
+	z[0] = -distance_infinity;
+	z[1] = distance_infinity;
+
+	// Returns the intersection between the parabolas rooted at 'q' and 'r'.
+	auto Intersection = [f](int q, int r) { return (f[q] - f[r] + float(q * q - r * r)) / float(2 * (q - r)); };
+
+	for (int q = 1; q < length; q++)
+	{
+		float s = Intersection(q, v[k]);
+		while (s <= z[k])
+		{
+			k -= 1;
+			s = Intersection(q, v[k]);
+		}
+
+		k += 1;
+		v[k] = q;
+		z[k] = s;
+		z[k + 1] = distance_infinity;
+	}
+
+	k = 0;
+	for (int q = 0; q < length; q++)
+	{
+		while (z[k + 1] < float(q))
+			k += 1;
+		const int r = v[k];
+		grid[offset + q * step] = f[r] + float((q - r) * (q - r));
+	}
+}
+
+// Computes the two-dimensional squared Euclidean distance transform of 'grid' in-place.
+static void DistanceTransform2D(Vector<float>& grid, Vector2i dimensions)
+{
+	const int max_length = Math::Max(dimensions.x, dimensions.y);
+	Vector<float> f(max_length);
+	Vector<float> z(max_length + 1);
+	Vector<int> v(max_length);
+
+	for (int x = 0; x < dimensions.x; x++)
+		DistanceTransform1D(grid.data(), x, dimensions.x, dimensions.y, f.data(), z.data(), v.data());
+	for (int y = 0; y < dimensions.y; y++)
+		DistanceTransform1D(grid.data(), y * dimensions.x, 1, dimensions.x, f.data(), z.data(), v.data());
+}
+
+// Generates the distance field of the glyph's coverage bitmap, padded by the spread on all sides. The distances are encoded into all channels
+// of the destination, with the glyph edge at the middle value, and inner distances above it.
+static void GenerateDistanceField(byte* destination, int destination_stride, Vector2i dimensions, const FontGlyph& glyph, int spread)
+{
+	const int num_pixels = dimensions.x * dimensions.y;
+	// Squared distances to the nearest pixel inside and outside the glyph, respectively.
+	Vector<float> grid_outer(num_pixels, distance_infinity);
+	Vector<float> grid_inner(num_pixels, 0.f);
+
+	if (glyph.bitmap_data)
+	{
+		for (int y = 0; y < glyph.bitmap_dimensions.y; y++)
+		{
+			for (int x = 0; x < glyph.bitmap_dimensions.x; x++)
+			{
+				const float coverage = float(glyph.bitmap_data[y * glyph.bitmap_dimensions.x + x]) / 255.f;
+				const int i = (y + spread) * dimensions.x + (x + spread);
+
+				if (coverage >= 1.f)
+				{
+					grid_outer[i] = 0.f;
+					grid_inner[i] = distance_infinity;
+				}
+				else if (coverage > 0.f)
+				{
+					// Approximate the sub-pixel position of the edge from the pixel coverage.
+					const float d = 0.5f - coverage;
+					grid_outer[i] = (d > 0.f ? d * d : 0.f);
+					grid_inner[i] = (d < 0.f ? d * d : 0.f);
+				}
+			}
+		}
+	}
+
+	DistanceTransform2D(grid_outer, dimensions);
+	DistanceTransform2D(grid_inner, dimensions);
+
+	const float scale = 1.f / float(2 * spread);
+	for (int y = 0; y < dimensions.y; y++)
+	{
+		byte* row = destination + y * destination_stride;
+		for (int x = 0; x < dimensions.x; x++)
+		{
+			const int i = y * dimensions.x + x;
+			const float distance = Math::SquareRoot(grid_outer[i]) - Math::SquareRoot(grid_inner[i]);
+			const float value = Math::Clamp(0.5f - distance * scale, 0.f, 1.f);
+			const byte encoded = byte(value * 255.f + 0.5f);
+
+			for (int c = 0; c < 4; c++)
+				row[x * 4 + c] = encoded;
+		}
+	}
+}
+
+FontFaceDistanceField::FontFaceDistanceField(FontFaceHandleFreetype face) : face(face) {}
+
+FontFaceDistanceField::~FontFaceDistanceField()
+{
+	ReleaseGlyphs();
+	FontProvider::GetGlyphAtlas().RemoveOwner(this);
+}
+
+const FontFaceDistanceField::Glyph* FontFaceDistanceField::GetOrCreateGlyph(Character character)
+{
+	auto it = glyphs.find(character);
+	if (it != glyphs.end())
+		return &it->second;
+
+	// Render the glyph's coverage at the reference size, as the source of its distance field.
+	FontGlyphMap coverage_glyphs;
+	if (!FreeType::AppendGlyph(face, reference_size, character, coverage_glyphs))
+	{
+		// Fonts without a replacement character have one generated for them.
+		if (character != Character::Replacement)
+			return nullptr;
+
+		FontMetrics metrics;
+		if (!FreeType::InitialiseFaceHandle(face, reference_size, coverage_glyphs, metrics, false))
+			return nullptr;
+	}
+
+	auto it_coverage = coverage_glyphs.find(character);
+	if (it_coverage == coverage_glyphs.end() || it_coverage->second.color_format != ColorFormat::A8)
+		return nullptr;
+
+	const FontGlyph& coverage_glyph = it_coverage->second;
+
+	Glyph& glyph = glyphs[character];
+	if (coverage_glyph.bitmap_dimensions.x <= 0 || coverage_glyph.bitmap_dimensions.y <= 0)
+		return &glyph;
+
+	const Vector2i dimensions = coverage_glyph.bitmap_dimensions + Vector2i(2 * spread);
+	glyph.origin = Vector2f(float(coverage_glyph.bearing.x - spread), float(-coverage_glyph.bearing.y - spread));
+	glyph.dimensions = Vector2f(dimensions);
+
+	FontGlyphAtlas& atlas = FontProvider::GetGlyphAtlas();
+	glyph.allocation = atlas.Allocate(this, dimensions);
+	if (!glyph.allocation)
+		return &glyph;
+
+	int stride = 0;
+	byte* destination = atlas.GetTextureData(glyph.allocation, stride);
+	GenerateDistanceField(destination, stride, dimensions, coverage_glyph, spread);
+	atlas.MarkDirty(glyph.allocation);
+
+	return &glyph;
+}
+
+void FontFaceDistanceField::Touch()
+{
+	FontProvider::GetGlyphAtlas().Touch(this);
+}
+
+int FontFaceDistanceField::GetVersion() const
+{
+	return version;
+}
+
+void FontFaceDistanceField::OnAtlasEvicted()
+{
+	ReleaseGlyphs();
+}
+
+void FontFaceDistanceField::ReleaseGlyphs()
+{
+	FontGlyphAtlas& atlas = FontProvider::GetGlyphAtlas();
+	for (auto& pair : glyphs)
+	{
+		if (pair.second.allocation)
+			atlas.Release(this, pair.second.allocation);
+	}
+
+	glyphs.clear();
+	version += 1;
+}
+
+} // namespace Rml
@@ -0,0 +1,85 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef RMLUI_CORE_FONTENGINEDEFAULT_FONTFACEDISTANCEFIELD_H
+#define RMLUI_CORE_FONTENGINEDEFAULT_FONTFACEDISTANCEFIELD_H
+
+#include "../../../Include/RmlUi/Core/Traits.h"
+#include "../../../Include/RmlUi/Core/Types.h"
+#include "FontGlyphAtlas.h"
+#include "FontTypes.h"
+
+namespace Rml {
+
+/**
+    Signed distance fields of the glyphs of a font face, shared by the handles of the face at all font sizes.
+
+    Each glyph is rendered once at a fixed reference size and stored as a distance field in the glyph atlas. The handles scale the glyphs to
+    their own size, and the text is rendered with a shader which reconstructs the glyph edges and any font effects from the distance field.
+ */
+class FontFaceDistanceField final : public FontGlyphAtlas::Owner, NonCopyMoveable {
+public:
+	// The font size the glyphs are rendered at.
+	static constexpr int reference_size = 32;
+	// The maximum distance, in pixels at the reference size, encoded in the distance fields around each glyph.
+	static constexpr int spread = 8;
+
+	struct Glyph {
+		// The atlas region of the distance field, invalid for empty glyphs.
+		FontGlyphAtlas::Allocation allocation;
+		// The offset of the distance field from the glyph's origin on the baseline, at the reference size.
+		Vector2f origin;
+		// The dimensions of the distance field, at the reference size.
+		Vector2f dimensions;
+	};
+
+	FontFaceDistanceField(FontFaceHandleFreetype face);
+	~FontFaceDistanceField();
+
+	/// Returns the distance field of the given character, generating it if necessary.
+	/// @return The glyph, or nullptr if the character is not available in the font face.
+	const Glyph* GetOrCreateGlyph(Character character);
+
+	/// Marks the distance fields as being in use, protecting them from being evicted from the atlas.
+	void Touch();
+
+	/// Version is changed whenever the glyphs are released, invalidating all glyphs previously returned.
+	int GetVersion() const;
+
+	void OnAtlasEvicted() override;
+
+private:
+	void ReleaseGlyphs();
+
+	FontFaceHandleFreetype face;
+	UnorderedMap<Character, Glyph> glyphs;
+	int version = 0;
+};
+
+} // namespace Rml
+#endif
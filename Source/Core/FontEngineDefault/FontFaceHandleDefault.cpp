@@ -29,7 +29,8 @@
 #include "FontFaceHandleDefault.h"
 #include "../../../Include/RmlUi/Core/Profiling.h"
 #include "../../../Include/RmlUi/Core/StringUtilities.h"
-#include "../TextureLayout.h"
+#include "../../../Include/RmlUi/Core/Log.h"
+#include "FontFaceDistanceField.h"
 #include "FontFaceLayer.h"
 #include "FontProvider.h"
 #include "FreeTypeInterface.h"
@@ -40,6 +41,13 @@ namespace Rml {
 
 static constexpr char32_t KerningCache_AsciiSubsetBegin = 32;
 static constexpr char32_t KerningCache_AsciiSubsetLast = 126;
+static constexpr size_t KerningCache_InitialCapacity = 256;
+
+static inline size_t GetKerningCacheIndex(uint64_t pair, size_t mask)
+{
+	// Fibonacci hashing, spreading the bits of both characters over the index.
+	return size_t((pair * 0x9E3779B97F4A7C15ull) >> 32) & mask;
+}
 
 FontFaceHandleDefault::FontFaceHandleDefault()
 {
@@ -54,17 +62,40 @@ FontFaceHandleDefault::~FontFaceHandleDefault()
 	layers.clear();
 }
 
-bool FontFaceHandleDefault::Initialize(FontFaceHandleFreetype face, int font_size, bool load_default_glyphs)
+bool FontFaceHandleDefault::Initialize(FontFaceHandleFreetype face, int font_size, bool load_default_glyphs, FontFaceDistanceField* _distance_field,
+	const FontBakedGlyphs::Handle* _baked)
 {
 	ft_face = face;
+	distance_field = _distance_field;
+	if (distance_field)
+		distance_fields.push_back(distance_field);
 
-	RMLUI_ASSERTMSG(layer_configurations.empty(), "Initialize must only be called once.");
+	// Glyphs are only baked from bitmaps, they can't be used with distance fields.
+	baked = (distance_field ? nullptr : _baked);
 
-	if (!FreeType::InitialiseFaceHandle(ft_face, font_size, glyphs, metrics, load_default_glyphs))
-		return false;
+	RMLUI_ASSERTMSG(layer_configurations.empty(), "Initialize must only be called once.");
 
 	has_kerning = FreeType::HasKerning(ft_face);
-	FillKerningPairCache();
+
+	if (baked)
+	{
+		// Use the baked glyphs directly, glyphs missing from the baked data are still rasterized when encountered.
+		metrics = baked->metrics;
+		glyphs.reserve(baked->glyphs.size());
+		for (const auto& pair : baked->glyphs)
+			glyphs.emplace(pair.first, pair.second.WeakCopy());
+		if (has_kerning)
+			kerning_pair_cache = baked->kerning_pairs;
+	}
+	else
+	{
+		// Glyphs rendered from distance fields only need their metrics at this size.
+		if (!FreeType::InitialiseFaceHandle(ft_face, font_size, glyphs, metrics, load_default_glyphs, !distance_field,
+				FontProvider::UsesParallelGlyphGeneration()))
+			return false;
+
+		FillKerningPairCache();
+	}
 
 	// Generate the default layer and layer configuration.
 	base_layer = GetOrCreateLayer(nullptr);
@@ -173,28 +204,9 @@ int FontFaceHandleDefault::GenerateLayerConfiguration(const FontEffectList& font
 	return (int)(layer_configurations.size() - 1);
 }
 
-bool FontFaceHandleDefault::GenerateLayerTexture(Vector<byte>& texture_data, Vector2i& texture_dimensions, const FontEffect* font_effect,
-	int texture_id, int handle_version) const
-{
-	if (handle_version != version)
-	{
-		RMLUI_ERRORMSG("While generating font layer texture: Handle version mismatch in texture vs font-face.");
-		return false;
-	}
-
-	auto it = std::find_if(layers.begin(), layers.end(), [font_effect](const EffectLayerPair& pair) { return pair.font_effect == font_effect; });
-
-	if (it == layers.end())
-	{
-		RMLUI_ERRORMSG("While generating font layer texture: Layer id not found.");
-		return false;
-	}
-
-	return it->layer->GenerateTexture(texture_data, texture_dimensions, texture_id, glyphs);
-}
-
 int FontFaceHandleDefault::GenerateString(RenderManager& render_manager, TexturedMeshList& mesh_list, StringView string, const Vector2f position,
-	const ColourbPremultiplied colour, const float opacity, const float letter_spacing, const int layer_configuration_index)
+	const ColourbPremultiplied colour, const float opacity, const float letter_spacing, const int layer_configuration_index,
+	Vector<const CompiledShader*>* mesh_shaders, Vector<SharedPtr<const void>>* glyph_pins)
 {
 	RMLUI_ASSERT(layer_configuration_index >= 0);
 	RMLUI_ASSERT(layer_configuration_index < (int)layer_configurations.size());
@@ -203,6 +215,10 @@ int FontFaceHandleDefault::GenerateString(RenderManager& render_manager, Texture
 	int line_width = 0;
 	bool has_set_size = false;
 
+	// Protect the distance fields from eviction while their glyphs are used by the layers.
+	for (FontFaceDistanceField* field : distance_fields)
+		field->Touch();
+
 	UpdateLayersOnDirty();
 
 	// Fetch the requested configuration and generate the geometry for each one.
@@ -213,10 +229,22 @@ int FontFaceHandleDefault::GenerateString(RenderManager& render_manager, Texture
 		[](int sum, const FontFaceLayer* layer) { return sum + layer->GetNumTextures(); });
 
 	mesh_list.resize(num_geometries);
+	if (mesh_shaders)
+		mesh_shaders->assign(num_geometries, nullptr);
+
+	if (glyph_pins)
+	{
+		glyph_pins->clear();
+		for (FontFaceDistanceField* field : distance_fields)
+			glyph_pins->push_back(field->GetPin());
+		for (const FontFaceLayer* layer : layer_configuration)
+			glyph_pins->push_back(layer->GetGlyphPin());
+	}
 
 	for (size_t layer_index = 0; layer_index < layer_configuration.size(); ++layer_index)
 	{
 		FontFaceLayer* layer = layer_configuration[layer_index];
+		layer->Touch();
 
 		ColourbPremultiplied layer_colour;
 		if (layer == base_layer)
@@ -234,8 +262,13 @@ int FontFaceHandleDefault::GenerateString(RenderManager& render_manager, Texture
 		Character prior_character = Character::Null;
 
 		// Set the mesh and textures to the geometries.
+		const CompiledShader* shader = (mesh_shaders ? layer->GetShader(render_manager) : nullptr);
 		for (int tex_index = 0; tex_index < num_textures; ++tex_index)
+		{
 			mesh_list[geometry_index + tex_index].texture = layer->GetTexture(render_manager, tex_index);
+			if (mesh_shaders)
+				(*mesh_shaders)[geometry_index + tex_index] = shader;
+		}
 
 		mesh_list[geometry_index].mesh.indices.reserve(string.size() * 6);
 		mesh_list[geometry_index].mesh.vertices.reserve(string.size() * 4);
@@ -266,6 +299,10 @@ int FontFaceHandleDefault::GenerateString(RenderManager& render_manager, Texture
 		geometry_index += num_textures;
 	}
 
+	// Glyphs appended while generating the string are not yet part of the layers, signal that the string needs to be generated again.
+	if (is_layers_dirty)
+		++version;
+
 	return Math::Max(line_width, 0);
 }
 
@@ -273,13 +310,21 @@ bool FontFaceHandleDefault::UpdateLayersOnDirty()
 {
 	bool result = false;
 
-	// If we are dirty, regenerate all the layers and increment the version
+	// Regenerate the layers if any of the distance fields have released their glyphs.
+	const int distance_field_version = GetDistanceFieldVersion();
+	if (layers_distance_field_version != distance_field_version)
+	{
+		layers_distance_field_version = distance_field_version;
+		is_layers_dirty = true;
+	}
+
+	// If we are dirty, regenerate all the layers. Existing glyphs keep their place in the glyph atlas, thus the version is left unchanged
+	// so that geometry previously generated from the layers remains valid.
 	if (is_layers_dirty && base_layer)
 	{
 		is_layers_dirty = false;
-		++version;
 
-		// Regenerate all the layers.
+		// Regenerate all the layers, which adds any new glyphs to the layers.
 		// Note: The layer regeneration needs to happen in the order in which the layers were created,
 		// otherwise we may end up cloning a layer which has not yet been regenerated. This means trouble!
 		for (auto& pair : layers)
@@ -295,12 +340,81 @@ bool FontFaceHandleDefault::UpdateLayersOnDirty()
 
 int FontFaceHandleDefault::GetVersion() const
 {
-	return version;
+	return version + GetDistanceFieldVersion();
+}
+
+void FontFaceHandleDefault::DirtyLayers()
+{
+	is_layers_dirty = true;
+	++version;
+}
+
+bool FontFaceHandleDefault::UsesDistanceFields() const
+{
+	return distance_field != nullptr;
+}
+
+FontFaceDistanceField* FontFaceHandleDefault::GetDistanceField(Character character) const
+{
+	auto it = fallback_distance_fields.find(character);
+	if (it != fallback_distance_fields.end())
+		return it->second;
+	return distance_field;
+}
+
+int FontFaceHandleDefault::GetDistanceFieldVersion() const
+{
+	int result = 0;
+	for (const FontFaceDistanceField* field : distance_fields)
+		result += field->GetVersion();
+	return result;
+}
+
+const FontBakedGlyphs::LayerGlyphMap* FontFaceHandleDefault::GetBakedLayer(size_t fingerprint) const
+{
+	if (!baked)
+		return nullptr;
+
+	auto it = baked->layers.find(uint64_t(fingerprint));
+	if (it == baked->layers.end())
+		return nullptr;
+
+	return &it->second;
+}
+
+bool FontFaceHandleDefault::Bake(FontBakedGlyphs::Handle& baked_handle)
+{
+	if (distance_field)
+		return false;
+
+	UpdateLayersOnDirty();
+
+	baked_handle.metrics = metrics;
+	baked_handle.kerning_pairs = kerning_pair_cache;
+	baked_handle.glyphs.reserve(glyphs.size());
+	for (const auto& pair : glyphs)
+		baked_handle.glyphs.emplace(pair.first, pair.second.WeakCopy());
+
+	// Only layers generating their own textures from the effect need to be baked, the other layers are derived from the baked glyphs.
+	for (const auto& pair : layers)
+	{
+		const FontEffect* font_effect = pair.font_effect;
+		if (!font_effect || !font_effect->HasUniqueTexture())
+			continue;
+
+		auto it = layer_cache.find(font_effect->GetFingerprint());
+		if (it == layer_cache.end() || it->second != pair.layer.get())
+			continue;
+
+		pair.layer->Bake(baked_handle.layers[uint64_t(font_effect->GetFingerprint())]);
+	}
+
+	return true;
 }
 
 bool FontFaceHandleDefault::AppendGlyph(Character character)
 {
-	bool result = FreeType::AppendGlyph(ft_face, metrics.size, character, glyphs);
+	bool result = FreeType::AppendGlyph(ft_face, metrics.size, character, glyphs, !distance_field);
 	return result;
 }
 
@@ -349,15 +463,70 @@ int FontFaceHandleDefault::GetKerning(Character lhs, Character rhs, bool& has_se
 		return 0;
 	}
 
+	const uint64_t pair = (uint64_t(lhs) << 32) | uint64_t(rhs);
+	int result = 0;
+	if (FindCachedKerning(pair, result))
+		return result;
+
 	// Fetch it from the font face instead.
-	const int result = FreeType::GetKerning(ft_face, has_set_size ? 0 : metrics.size, lhs, rhs);
+	result = FreeType::GetKerning(ft_face, has_set_size ? 0 : metrics.size, lhs, rhs);
 
 	// This is purely an optimization to avoid repeatedly setting the font size in FreeType, which can be a measurable performance hit.
 	has_set_size = true;
 
+	CacheKerning(pair, result);
+
 	return result;
 }
 
+bool FontFaceHandleDefault::FindCachedKerning(uint64_t pair, int& kerning) const
+{
+	if (kerning_cache.empty())
+		return false;
+
+	const size_t mask = kerning_cache.size() - 1;
+	for (size_t i = GetKerningCacheIndex(pair, mask);; i = (i + 1) & mask)
+	{
+		const KerningCacheEntry& entry = kerning_cache[i];
+		if (entry.pair == pair)
+		{
+			kerning = entry.kerning;
+			return true;
+		}
+		if (entry.pair == 0)
+			return false;
+	}
+}
+
+void FontFaceHandleDefault::CacheKerning(uint64_t pair, int kerning) const
+{
+	RMLUI_ASSERT(pair != 0);
+
+	// Keep the load factor at or below one half, so that probe sequences stay short and always find an empty entry.
+	if (size_t(kerning_cache_num_entries + 1) * 2 > kerning_cache.size())
+	{
+		Vector<KerningCacheEntry> entries(Math::Max(kerning_cache.size() * 2, KerningCache_InitialCapacity), KerningCacheEntry{0, 0});
+		entries.swap(kerning_cache);
+		kerning_cache_num_entries = 0;
+
+		for (const KerningCacheEntry& entry : entries)
+		{
+			if (entry.pair != 0)
+				CacheKerning(entry.pair, entry.kerning);
+		}
+	}
+
+	const size_t mask = kerning_cache.size() - 1;
+	size_t i = GetKerningCacheIndex(pair, mask);
+	while (kerning_cache[i].pair != 0 && kerning_cache[i].pair != pair)
+		i = (i + 1) & mask;
+
+	if (kerning_cache[i].pair == 0)
+		kerning_cache_num_entries += 1;
+
+	kerning_cache[i] = KerningCacheEntry{pair, KerningIntType(kerning)};
+}
+
 const FontGlyph* FontFaceHandleDefault::GetOrAppendGlyph(Character& character, bool look_in_fallback_fonts)
 {
 	// Don't try to render control characters
@@ -386,7 +555,8 @@ const FontGlyph* FontFaceHandleDefault::GetOrAppendGlyph(Character& character, b
 			for (int i = 0; i < num_fallback_faces; i++)
 			{
 				FontFaceHandleDefault* fallback_face = FontProvider::GetFallbackFontFace(i, metrics.size);
-				if (!fallback_face || fallback_face == this)
+				// Glyphs can only be rendered from fallback faces using the same kind of glyphs as ourself.
+				if (!fallback_face || fallback_face == this || fallback_face->UsesDistanceFields() != UsesDistanceFields())
 					continue;
 
 				const FontGlyph* glyph = fallback_face->GetOrAppendGlyph(character, false);
@@ -397,6 +567,13 @@ const FontGlyph* FontFaceHandleDefault::GetOrAppendGlyph(Character& character, b
 					it_glyph = pair.first;
 					if (pair.second)
 						is_layers_dirty = true;
+
+					if (FontFaceDistanceField* fallback_field = fallback_face->GetDistanceField(character))
+					{
+						fallback_distance_fields[character] = fallback_field;
+						if (std::find(distance_fields.begin(), distance_fields.end(), fallback_field) == distance_fields.end())
+							distance_fields.push_back(fallback_field);
+					}
 					break;
 				}
 			}
@@ -434,6 +611,13 @@ FontFaceLayer* FontFaceHandleDefault::GetOrCreateLayer(const SharedPtr<const Fon
 	layers.push_back(EffectLayerPair{font_effect_ptr, nullptr});
 	auto& layer = layers.back().layer;
 
+	if (distance_field && font_effect)
+	{
+		FontEffect::DistanceFieldParameters parameters;
+		if (!font_effect->GetDistanceFieldParameters(parameters))
+			Log::Message(Log::LT_WARNING, "Font effect does not support rendering from distance fields, the effect will not be rendered.");
+	}
+
 	layer = MakeUnique<FontFaceLayer>(font_effect);
 	GenerateLayer(layer.get());
 
@@ -446,8 +630,9 @@ bool FontFaceHandleDefault::GenerateLayer(FontFaceLayer* layer)
 	const FontEffect* font_effect = layer->GetFontEffect();
 	bool result = false;
 
-	if (!font_effect)
+	if (!font_effect || distance_field)
 	{
+		// Layers rendered from distance fields refer directly to the glyphs of the distance fields, there is nothing to clone.
 		result = layer->Generate(this);
 	}
 	else
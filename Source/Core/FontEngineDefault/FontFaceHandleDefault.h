@@ -35,10 +35,13 @@
 #include "../../../Include/RmlUi/Core/Geometry.h"
 #include "../../../Include/RmlUi/Core/Texture.h"
 #include "../../../Include/RmlUi/Core/Traits.h"
+#include "FontBakedGlyphs.h"
 #include "FontTypes.h"
 
 namespace Rml {
 
+class CompiledShader;
+class FontFaceDistanceField;
 class FontFaceLayer;
 
 /**
@@ -50,7 +53,11 @@ public:
 	FontFaceHandleDefault();
 	~FontFaceHandleDefault();
 
-	bool Initialize(FontFaceHandleFreetype face, int font_size, bool load_default_glyphs);
+	/// Initializes the handle for the given font size.
+	/// @param[in] distance_field The distance fields of the face to render glyphs from, or nullptr to render glyphs from bitmaps of this size.
+	/// @param[in] baked The glyphs of this handle baked ahead of time, used instead of rasterizing the glyphs, or nullptr to rasterize them.
+	bool Initialize(FontFaceHandleFreetype face, int font_size, bool load_default_glyphs, FontFaceDistanceField* distance_field = nullptr,
+		const FontBakedGlyphs::Handle* baked = nullptr);
 
 	const FontMetrics& GetFontMetrics() const;
 
@@ -67,14 +74,6 @@ public:
 	/// @param[in] font_effects The list of font effects to generate the configuration for.
 	/// @return The index to use when generating geometry using this configuration.
 	int GenerateLayerConfiguration(const FontEffectList& font_effects);
-	/// Generates the texture data for a layer (for the texture database).
-	/// @param[out] texture_data The generated texture data.
-	/// @param[out] texture_dimensions The dimensions of the texture.
-	/// @param[in] font_effect The font effect used for the layer.
-	/// @param[in] texture_id The index of the texture within the layer to generate.
-	/// @param[in] handle_version The version of the handle data. Function returns false if out of date.
-	bool GenerateLayerTexture(Vector<byte>& texture_data, Vector2i& texture_dimensions, const FontEffect* font_effect, int texture_id,
-		int handle_version) const;
 
 	/// Generates the geometry required to render a single line of text.
 	/// @param[in] render_manager The render manager responsible for rendering the string.
@@ -85,13 +84,32 @@ public:
 	/// @param[in] opacity The opacity of the text, should be applied to font effects.
 	/// @param[in] letter_spacing The letter spacing size in pixels.
 	/// @param[in] layer_configuration Face configuration index to use for generating string.
+	/// @param[out] mesh_shaders Optionally receives the shader to render each mesh with, or nullptr for meshes rendered without one.
+	/// @param[out] glyph_pins Optionally receives pins protecting the glyphs used by the meshes from eviction, to be held along with the meshes.
 	/// @return The width, in pixels, of the string geometry.
 	int GenerateString(RenderManager& render_manager, TexturedMeshList& mesh_list, StringView string, Vector2f position, ColourbPremultiplied colour,
-		float opacity, float letter_spacing, int layer_configuration);
+		float opacity, float letter_spacing, int layer_configuration, Vector<const CompiledShader*>* mesh_shaders = nullptr,
+		Vector<SharedPtr<const void>>* glyph_pins = nullptr);
 
 	/// Version is changed whenever the layers are dirtied, requiring regeneration of string geometry.
 	int GetVersion() const;
 
+	/// Marks the layers for regeneration, such as after their glyphs have been evicted from the glyph atlas.
+	void DirtyLayers();
+
+	/// Returns true if the glyphs of this handle are rendered from signed distance fields.
+	bool UsesDistanceFields() const;
+	/// Returns the distance fields to render the given character from, which may belong to a fallback font face.
+	FontFaceDistanceField* GetDistanceField(Character character) const;
+	/// Returns a number which changes whenever any of the distance fields used by this handle have released their glyphs.
+	int GetDistanceFieldVersion() const;
+
+	/// Returns the baked glyphs of the layer generated by the font effect with the given fingerprint, or nullptr if none were baked.
+	const FontBakedGlyphs::LayerGlyphMap* GetBakedLayer(size_t fingerprint) const;
+	/// Adds the glyphs, kerning pairs, and layer textures generated by this handle to the given baked handle.
+	/// @return False if the handle can not be baked, such as when rendering glyphs from distance fields.
+	bool Bake(FontBakedGlyphs::Handle& baked_handle);
+
 private:
 	// Build and append glyph to 'glyphs'
 	bool AppendGlyph(Character character);
@@ -102,6 +120,11 @@ private:
 	// Return the kerning for a character pair.
 	int GetKerning(Character lhs, Character rhs, bool& has_set_size) const;
 
+	// Look up the kerning of a character pair outside the ASCII subset in the kerning cache.
+	bool FindCachedKerning(uint64_t pair, int& kerning) const;
+	// Insert the kerning of a character pair outside the ASCII subset into the kerning cache.
+	void CacheKerning(uint64_t pair, int kerning) const;
+
 	/// Retrieve a glyph from the given code point, building and appending a new glyph if not already built.
 	/// @param[in-out] character  The character, can be changed e.g. to the replacement character if no glyph is found.
 	/// @param[in] look_in_fallback_fonts  Look for the glyph in fallback fonts if not found locally, adding it to our glyphs.
@@ -140,10 +163,29 @@ private:
 	using KerningPairs = UnorderedMap<AsciiPair, KerningIntType>;
 	KerningPairs kerning_pair_cache;
 
+	// Kerning of all other character pairs, filled lazily as they are encountered. Open addressing with linear probing, keyed by the
+	// character pair, where a zero key denotes an empty entry.
+	struct KerningCacheEntry {
+		uint64_t pair;
+		KerningIntType kerning;
+	};
+	mutable Vector<KerningCacheEntry> kerning_cache;
+	mutable int kerning_cache_num_entries = 0;
+
 	bool has_kerning = false;
 	bool is_layers_dirty = false;
 	int version = 0;
 
+	// The distance fields of our own face, and of any fallback faces we have taken glyphs from.
+	FontFaceDistanceField* distance_field = nullptr;
+	Vector<FontFaceDistanceField*> distance_fields;
+	SmallUnorderedMap<Character, FontFaceDistanceField*> fallback_distance_fields;
+	// The distance field version the layers were last generated with.
+	int layers_distance_field_version = 0;
+
+	// The glyphs of this handle baked ahead of time, if any.
+	const FontBakedGlyphs::Handle* baked = nullptr;
+
 	// All configurations currently in use on this handle. New configurations will be generated as required.
 	LayerConfigurationList layer_configurations;
 
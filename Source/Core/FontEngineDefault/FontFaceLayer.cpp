@@ -25,12 +25,15 @@
  * THE SOFTWARE.
  *
  */
-
 #include "FontFaceLayer.h"
+#include "../../../Include/RmlUi/Core/Core.h"
 #include "../../../Include/RmlUi/Core/RenderManager.h"
+#include "../../../Include/RmlUi/Core/SystemInterface.h"
+#include "FontFaceDistanceField.h"
 #include "FontFaceHandleDefault.h"
+#include "FontProvider.h"
+#include <algorithm>
 #include <string.h>
-#include <type_traits>
 
 namespace Rml {
 
@@ -41,30 +44,30 @@ FontFaceLayer::FontFaceLayer(const SharedPtr<const FontEffect>& _effect) : colou
 		colour = effect->GetColour();
 }
 
-FontFaceLayer::~FontFaceLayer() {}
+FontFaceLayer::~FontFaceLayer()
+{
+	ReleaseGlyphs();
+	FontProvider::GetGlyphAtlas().RemoveOwner(this);
+}
 
-bool FontFaceLayer::Generate(const FontFaceHandleDefault* handle, const FontFaceLayer* clone, bool clone_glyph_origins)
+bool FontFaceLayer::Generate(FontFaceHandleDefault* _handle, const FontFaceLayer* clone, bool clone_glyph_origins)
 {
-	// Clear the old layout if it exists.
-	{
-		// @performance: We could be much smarter about this, e.g. such as adding new glyphs to the existing texture layout and textures.
-		// Right now we re-generate the whole thing, including textures.
-		texture_layout = TextureLayout{};
-		character_boxes.clear();
-		textures_owned.clear();
-		textures_ptr = &textures_owned;
-	}
+	handle = _handle;
 
 	const FontGlyphMap& glyphs = handle->GetGlyphs();
 
 	// Generate the new layout.
-	if (clone)
+	if (handle->UsesDistanceFields())
+	{
+		GenerateFromDistanceFields();
+	}
+	else if (clone)
 	{
 		// Clone the geometry and textures from the clone layer.
+		ReleaseGlyphs();
+		clone_source = clone;
 		character_boxes = clone->character_boxes;
-
-		// Point our textures to the cloned layer's textures.
-		textures_ptr = clone->textures_ptr;
+		texture_pages = clone->texture_pages;
 
 		// Request the effect (if we have one) and adjust the origins as appropriate.
 		if (effect && !clone_glyph_origins)
@@ -96,157 +99,155 @@ bool FontFaceLayer::Generate(const FontFaceHandleDefault* handle, const FontFace
 	}
 	else
 	{
-		// Initialise the texture layout for the glyphs.
+		if (clone_source)
+		{
+			clone_source = nullptr;
+			character_boxes.clear();
+			texture_pages.clear();
+		}
+
+		FontGlyphAtlas& atlas = FontProvider::GetGlyphAtlas();
+
+		// Glyphs baked ahead of time are copied from the baked data instead of being generated by the effect.
+		const FontBakedGlyphs::LayerGlyphMap* baked_layer = (effect ? handle->GetBakedLayer(effect->GetFingerprint()) : nullptr);
+
+		// Add all glyphs not already in the layer, those already added are kept in place in the atlas.
+		Vector<GlyphJob> glyph_jobs;
 		character_boxes.reserve(glyphs.size());
 		for (auto& pair : glyphs)
 		{
 			Character character = pair.first;
 			const FontGlyph& glyph = pair.second;
 
+			if (character_boxes.find(character) != character_boxes.end())
+				continue;
+
+			TextureBox& box = character_boxes[character];
+
 			Vector2i glyph_origin(0, 0);
 			Vector2i glyph_dimensions = glyph.bitmap_dimensions;
+			const FontBakedGlyphs::LayerGlyph* baked_glyph = nullptr;
 
-			// Adjust glyph origin / dimensions for the font effect.
-			if (effect)
+			if (baked_layer)
 			{
-				if (!effect->GetGlyphMetrics(glyph_origin, glyph_dimensions, glyph))
-					continue;
+				auto it_baked = baked_layer->find(character);
+				if (it_baked != baked_layer->end())
+					baked_glyph = &it_baked->second;
+			}
+
+			if (baked_glyph)
+			{
+				glyph_dimensions = baked_glyph->dimensions;
+				box.origin = baked_glyph->origin;
 			}
+			else
+			{
+				// Adjust glyph origin / dimensions for the font effect.
+				if (effect)
+				{
+					if (!effect->GetGlyphMetrics(glyph_origin, glyph_dimensions, glyph))
+						continue;
+				}
 
-			TextureBox box;
-			box.origin = Vector2f(float(glyph_origin.x + glyph.bearing.x), float(glyph_origin.y - glyph.bearing.y));
+				box.origin = Vector2f(float(glyph_origin.x + glyph.bearing.x), float(glyph_origin.y - glyph.bearing.y));
+			}
 			box.dimensions = Vector2f(glyph_dimensions);
 
 			RMLUI_ASSERT(box.dimensions.x >= 0 && box.dimensions.y >= 0);
 
-			character_boxes[character] = box;
-
-			// Add the character's dimensions into the texture layout engine.
-			texture_layout.AddRectangle((int)character, glyph_dimensions);
+			const FontGlyphAtlas::Allocation allocation = atlas.Allocate(this, glyph_dimensions);
+			if (!allocation)
+				continue;
+
+			allocations.push_back(allocation);
+			box.allocation = allocation;
+
+			// Set the character's texture index and coordinates.
+			const Vector2f page_dimensions = Vector2f(atlas.GetPageDimensions(allocation.page_index));
+			box.texture_index = GetTextureIndex(allocation.page_index);
+			box.texcoords[0].x = float(allocation.rectangle.Left()) / page_dimensions.x;
+			box.texcoords[0].y = float(allocation.rectangle.Top()) / page_dimensions.y;
+			box.texcoords[1].x = float(allocation.rectangle.Right()) / page_dimensions.x;
+			box.texcoords[1].y = float(allocation.rectangle.Bottom()) / page_dimensions.y;
+
+			// The texture data is generated afterward, once the atlas is no longer modified.
+			int stride = 0;
+			byte* destination = atlas.GetTextureData(allocation, stride);
+			glyph_jobs.push_back(GlyphJob{&glyph, baked_glyph, allocation, destination, glyph_dimensions, stride});
 		}
 
-		constexpr int max_texture_dimensions = 1024;
-
-		// Generate the texture layout; this will position the glyph rectangles efficiently and
-		// allocate the texture data ready for writing.
-		if (!texture_layout.GenerateLayout(max_texture_dimensions))
-			return false;
-
-		// Iterate over each rectangle in the layout, copying the glyph data into the rectangle as
-		// appropriate and generating geometry.
-		for (int i = 0; i < texture_layout.GetNumRectangles(); ++i)
+		// Generate the glyphs' texture data directly into their regions of the atlas. Each glyph writes to its own region, thus they can be
+		// generated in parallel.
+		constexpr int batch_size = 8;
+		const int num_jobs = (int)glyph_jobs.size();
+		if (FontProvider::UsesParallelGlyphGeneration() && num_jobs > batch_size)
 		{
-			TextureLayoutRectangle& rectangle = texture_layout.GetRectangle(i);
-			const TextureLayoutTexture& texture = texture_layout.GetTexture(rectangle.GetTextureIndex());
-			Character character = (Character)rectangle.GetId();
-			RMLUI_ASSERT(character_boxes.find(character) != character_boxes.end());
-			TextureBox& box = character_boxes[character];
-
-			// Set the character's texture index.
-			box.texture_index = rectangle.GetTextureIndex();
-
-			// Generate the character's texture coordinates.
-			box.texcoords[0].x = float(rectangle.GetPosition().x) / float(texture.GetDimensions().x);
-			box.texcoords[0].y = float(rectangle.GetPosition().y) / float(texture.GetDimensions().y);
-			box.texcoords[1].x = float(rectangle.GetPosition().x + rectangle.GetDimensions().x) / float(texture.GetDimensions().x);
-			box.texcoords[1].y = float(rectangle.GetPosition().y + rectangle.GetDimensions().y) / float(texture.GetDimensions().y);
+			GetSystemInterface()->ExecuteParallel((num_jobs + batch_size - 1) / batch_size, [&](int batch_index) {
+				const int end = Math::Min((batch_index + 1) * batch_size, num_jobs);
+				for (int i = batch_index * batch_size; i < end; i++)
+					GenerateGlyphTexture(glyph_jobs[i]);
+			});
 		}
-
-		const FontEffect* effect_ptr = effect.get();
-		const int handle_version = handle->GetVersion();
-
-		// Generate the textures.
-		for (int i = 0; i < texture_layout.GetNumTextures(); ++i)
+		else
 		{
-			const int texture_id = i;
-
-			CallbackTextureFunction texture_callback = [handle, effect_ptr, texture_id, handle_version](
-														   const CallbackTextureInterface& texture_interface) -> bool {
-				Vector2i dimensions;
-				Vector<byte> data;
-				if (!handle->GenerateLayerTexture(data, dimensions, effect_ptr, texture_id, handle_version) || data.empty())
-					return false;
-				if (!texture_interface.GenerateTexture(data, dimensions))
-					return false;
-				return true;
-			};
-
-			static_assert(std::is_nothrow_move_constructible<CallbackTextureSource>::value,
-				"CallbackTextureSource must be nothrow move constructible so that it can be placed in the vector below.");
-
-			textures_owned.emplace_back(std::move(texture_callback));
+			for (const GlyphJob& job : glyph_jobs)
+				GenerateGlyphTexture(job);
 		}
+
+		for (const GlyphJob& job : glyph_jobs)
+			atlas.MarkDirty(job.allocation);
 	}
 
 	return true;
 }
 
-bool FontFaceLayer::GenerateTexture(Vector<byte>& texture_data, Vector2i& texture_dimensions, int texture_id, const FontGlyphMap& glyphs)
+void FontFaceLayer::GenerateGlyphTexture(const GlyphJob& job) const
 {
-	if (texture_id < 0 || texture_id > texture_layout.GetNumTextures())
-		return false;
+	const FontGlyph& glyph = *job.glyph;
+	byte* destination = job.destination;
 
-	// Generate the texture data.
-	texture_data = texture_layout.GetTexture(texture_id).AllocateTexture();
-	texture_dimensions = texture_layout.GetTexture(texture_id).GetDimensions();
-
-	for (int i = 0; i < texture_layout.GetNumRectangles(); ++i)
+	if (job.baked)
 	{
-		TextureLayoutRectangle& rectangle = texture_layout.GetRectangle(i);
-		Character character = (Character)rectangle.GetId();
-		RMLUI_ASSERT(character_boxes.find(character) != character_boxes.end());
-
-		TextureBox& box = character_boxes[character];
-
-		if (box.texture_index != texture_id)
-			continue;
-
-		auto it = glyphs.find((Character)rectangle.GetId());
-		if (it == glyphs.end())
-			continue;
-
-		const FontGlyph& glyph = it->second;
-
-		if (effect == nullptr)
+		const FontBakedGlyphs::LayerGlyph& baked = *job.baked;
+		for (int j = 0; j < baked.dimensions.y; ++j)
+			memcpy(destination + j * job.stride, baked.data + j * baked.stride, size_t(baked.dimensions.x) * 4);
+	}
+	else if (effect == nullptr)
+	{
+		// Copy the glyph's bitmap data into its allocated texture.
+		if (glyph.bitmap_data)
 		{
-			// Copy the glyph's bitmap data into its allocated texture.
-			if (glyph.bitmap_data)
-			{
-				byte* destination = rectangle.GetTextureData();
-				const byte* source = glyph.bitmap_data;
-				const int num_bytes_per_line = glyph.bitmap_dimensions.x * (glyph.color_format == ColorFormat::RGBA8 ? 4 : 1);
+			const byte* source = glyph.bitmap_data;
+			const int num_bytes_per_line = glyph.bitmap_dimensions.x * (glyph.color_format == ColorFormat::RGBA8 ? 4 : 1);
 
-				for (int j = 0; j < glyph.bitmap_dimensions.y; ++j)
+			for (int j = 0; j < glyph.bitmap_dimensions.y; ++j)
+			{
+				switch (glyph.color_format)
+				{
+				case ColorFormat::A8:
 				{
-					switch (glyph.color_format)
-					{
-					case ColorFormat::A8:
-					{
-						// We use premultiplied alpha, so copy the alpha into all four channels.
-						for (int k = 0; k < num_bytes_per_line; ++k)
-							for (int c = 0; c < 4; ++c)
-								destination[k * 4 + c] = source[k];
-					}
-					break;
-					case ColorFormat::RGBA8:
-					{
-						memcpy(destination, source, num_bytes_per_line);
-					}
-					break;
-					}
-
-					destination += rectangle.GetTextureStride();
-					source += num_bytes_per_line;
+					// We use premultiplied alpha, so copy the alpha into all four channels.
+					for (int k = 0; k < num_bytes_per_line; ++k)
+						for (int c = 0; c < 4; ++c)
+							destination[k * 4 + c] = source[k];
 				}
+				break;
+				case ColorFormat::RGBA8:
+				{
+					memcpy(destination, source, num_bytes_per_line);
+				}
+				break;
+				}
+
+				destination += job.stride;
+				source += num_bytes_per_line;
 			}
 		}
-		else
-		{
-			effect->GenerateGlyphTexture(rectangle.GetTextureData(), Vector2i(box.dimensions), rectangle.GetTextureStride(), glyph);
-		}
 	}
-
-	return true;
+	else
+	{
+		effect->GenerateGlyphTexture(destination, job.dimensions, job.stride, glyph);
+	}
 }
 
 const FontEffect* FontFaceLayer::GetFontEffect() const
@@ -259,12 +260,24 @@ Texture FontFaceLayer::GetTexture(RenderManager& render_manager, int index)
 	RMLUI_ASSERT(index >= 0);
 	RMLUI_ASSERT(index < GetNumTextures());
 
-	return (*textures_ptr)[index].GetTexture(render_manager);
+	return FontProvider::GetGlyphAtlas().GetTexture(render_manager, texture_pages[index]);
 }
 
 int FontFaceLayer::GetNumTextures() const
 {
-	return (int)textures_ptr->size();
+	return (int)texture_pages.size();
+}
+
+const CompiledShader* FontFaceLayer::GetShader(RenderManager& render_manager)
+{
+	if (shader_parameters.empty())
+		return nullptr;
+
+	UniquePtr<CompiledShader>& shader = shaders[&render_manager];
+	if (!shader)
+		shader = MakeUnique<CompiledShader>(render_manager.CompileShader("sdf-text", shader_parameters));
+
+	return *shader ? shader.get() : nullptr;
 }
 
 ColourbPremultiplied FontFaceLayer::GetColour(float opacity) const
@@ -272,4 +285,114 @@ ColourbPremultiplied FontFaceLayer::GetColour(float opacity) const
 	return colour.ToPremultiplied(opacity);
 }
 
+void FontFaceLayer::Touch()
+{
+	// Cloned layers render from the glyphs of their source layer, which must then be protected instead.
+	FontProvider::GetGlyphAtlas().Touch(clone_source ? clone_source : this);
+}
+
+SharedPtr<const void> FontFaceLayer::GetGlyphPin() const
+{
+	return (clone_source ? clone_source : this)->GetPin();
+}
+
+void FontFaceLayer::OnAtlasEvicted()
+{
+	ReleaseGlyphs();
+	character_boxes.clear();
+	texture_pages.clear();
+
+	// Our glyphs are no longer available, have the handle regenerate its layers and any geometry using them.
+	if (handle)
+		handle->DirtyLayers();
+}
+
+void FontFaceLayer::Bake(FontBakedGlyphs::LayerGlyphMap& baked_layer)
+{
+	FontGlyphAtlas& atlas = FontProvider::GetGlyphAtlas();
+
+	for (const auto& pair : character_boxes)
+	{
+		const TextureBox& box = pair.second;
+		if (box.texture_index < 0 || !box.allocation)
+			continue;
+
+		FontBakedGlyphs::LayerGlyph& glyph = baked_layer[pair.first];
+		glyph.origin = box.origin;
+		glyph.dimensions = Vector2i(box.dimensions);
+		glyph.data = atlas.GetTextureData(box.allocation, glyph.stride);
+	}
+}
+
+void FontFaceLayer::GenerateFromDistanceFields()
+{
+	// Our character boxes refer to the glyphs of the distance fields, these are invalidated when the distance fields release their glyphs.
+	const int version = handle->GetDistanceFieldVersion();
+	if (version != distance_field_version)
+	{
+		character_boxes.clear();
+		texture_pages.clear();
+		distance_field_version = version;
+	}
+
+	FontEffect::DistanceFieldParameters parameters;
+	if (effect && !effect->GetDistanceFieldParameters(parameters))
+		return;
+
+	// Convert the parameters from pixels at our font size to the encoding of the distance fields.
+	const float size = float(handle->GetFontMetrics().size);
+	const float scale = size / float(FontFaceDistanceField::reference_size);
+	const float distance_scale = 1.f / (scale * float(2 * FontFaceDistanceField::spread));
+	// Dilations beyond the encoded spread can't be represented, keep the edge slightly above the minimum value.
+	const float edge = Math::Max(0.5f - parameters.dilation * distance_scale, 0.02f);
+	const float softness = parameters.softness * distance_scale;
+	shader_parameters = Dictionary{{"edge", Variant(edge)}, {"softness", Variant(softness)}};
+
+	FontGlyphAtlas& atlas = FontProvider::GetGlyphAtlas();
+
+	for (auto& pair : handle->GetGlyphs())
+	{
+		const Character character = pair.first;
+		if (character_boxes.find(character) != character_boxes.end())
+			continue;
+
+		TextureBox& box = character_boxes[character];
+
+		FontFaceDistanceField* distance_field = handle->GetDistanceField(character);
+		const FontFaceDistanceField::Glyph* glyph = (distance_field ? distance_field->GetOrCreateGlyph(character) : nullptr);
+		if (!glyph || !glyph->allocation)
+			continue;
+
+		box.origin = glyph->origin * scale + parameters.offset;
+		box.dimensions = glyph->dimensions * scale;
+
+		const Vector2f page_dimensions = Vector2f(atlas.GetPageDimensions(glyph->allocation.page_index));
+		box.texture_index = GetTextureIndex(glyph->allocation.page_index);
+		box.texcoords[0] = Vector2f(glyph->allocation.rectangle.TopLeft()) / page_dimensions;
+		box.texcoords[1] = Vector2f(glyph->allocation.rectangle.BottomRight()) / page_dimensions;
+	}
+}
+
+void FontFaceLayer::ReleaseGlyphs()
+{
+	if (allocations.empty())
+		return;
+
+	FontGlyphAtlas& atlas = FontProvider::GetGlyphAtlas();
+	for (const FontGlyphAtlas::Allocation& allocation : allocations)
+		atlas.Release(this, allocation);
+
+	allocations.clear();
+}
+
+int FontFaceLayer::GetTextureIndex(int page_index)
+{
+	auto it = std::find(texture_pages.begin(), texture_pages.end(), page_index);
+	if (it != texture_pages.end())
+		return int(it - texture_pages.begin());
+
+	texture_pages.push_back(page_index);
+	return (int)texture_pages.size() - 1;
+}
+
 } // namespace Rml
@@ -29,11 +29,13 @@
 #ifndef RMLUI_CORE_FONTENGINEDEFAULT_FONTFACELAYER_H
 #define RMLUI_CORE_FONTENGINEDEFAULT_FONTFACELAYER_H
 
-#include "../../../Include/RmlUi/Core/CallbackTexture.h"
+#include "../../../Include/RmlUi/Core/CompiledFilterShader.h"
+#include "../../../Include/RmlUi/Core/Dictionary.h"
 #include "../../../Include/RmlUi/Core/FontGlyph.h"
 #include "../../../Include/RmlUi/Core/Geometry.h"
 #include "../../../Include/RmlUi/Core/MeshUtilities.h"
-#include "../TextureLayout.h"
+#include "FontBakedGlyphs.h"
+#include "FontGlyphAtlas.h"
 
 namespace Rml {
 
@@ -44,27 +46,23 @@ class FontFaceHandleDefault;
     A textured layer stored as part of a font face handle. Each handle will have at least a base
     layer for the standard font. Further layers can be added to allow rendering of text effects.
 
+    The glyphs of the layer are stored in the glyph atlas shared by all font face handles. When the handle renders glyphs from distance
+    fields, the layer instead refers to the glyphs of the distance fields, and its effect is applied by the shader used to render them.
+
     @author Peter Curry
  */
 
-class FontFaceLayer {
+class FontFaceLayer final : public FontGlyphAtlas::Owner {
 public:
 	FontFaceLayer(const SharedPtr<const FontEffect>& _effect);
 	~FontFaceLayer();
 
-	/// Generates or re-generates the character and texture data for the layer.
+	/// Generates the character and texture data for the layer. Glyphs already generated by the layer are kept, only new glyphs are added.
 	/// @param[in] handle The handle generating this layer.
 	/// @param[in] clone The layer to optionally clone geometry and texture data from.
 	/// @param[in] clone_glyph_origins True to keep the character origins from the cloned layer, false to generate new ones.
 	/// @return True if the layer was generated successfully, false if not.
-	bool Generate(const FontFaceHandleDefault* handle, const FontFaceLayer* clone = nullptr, bool clone_glyph_origins = false);
-
-	/// Generates the texture data for a layer (for the texture database).
-	/// @param[out] texture_data The generated texture data.
-	/// @param[out] texture_dimensions The dimensions of the texture.
-	/// @param[in] texture_id The index of the texture within the layer to generate.
-	/// @param[in] glyphs The glyphs required by the font face handle.
-	bool GenerateTexture(Vector<byte>& texture_data, Vector2i& texture_dimensions, int texture_id, const FontGlyphMap& glyphs);
+	bool Generate(FontFaceHandleDefault* handle, const FontFaceLayer* clone = nullptr, bool clone_glyph_origins = false);
 
 	/// Generates the geometry required to render a single character.
 	/// @param[out] mesh_list An array of meshes this layer will write to. It must be at least as big as the number of textures in this layer.
@@ -95,10 +93,22 @@ public:
 	Texture GetTexture(RenderManager& render_manager, int index);
 	/// Returns the number of textures employed by this layer.
 	int GetNumTextures() const;
+	/// Returns the shader to render the layer's textures with, or nullptr to render them directly.
+	const CompiledShader* GetShader(RenderManager& render_manager);
 
 	/// Returns the layer's colour after applying the given opacity.
 	ColourbPremultiplied GetColour(float opacity) const;
 
+	/// Marks the layer as being in use, protecting its glyphs from being evicted from the atlas.
+	void Touch();
+	/// Returns a pin protecting the glyphs rendered by this layer from being evicted from the atlas for as long as it is held.
+	SharedPtr<const void> GetGlyphPin() const;
+
+	void OnAtlasEvicted() override;
+
+	/// Adds the texture data of all glyphs generated by this layer to the given baked layer.
+	void Bake(FontBakedGlyphs::LayerGlyphMap& baked_layer);
+
 private:
 	struct TextureBox {
 		// The offset, in pixels, of the baseline from the start of this character's geometry.
@@ -110,18 +120,51 @@ private:
 
 		// The texture this character renders from.
 		int texture_index = -1;
+		// The region of the glyph atlas the character renders from.
+		FontGlyphAtlas::Allocation allocation;
+	};
+
+	struct GlyphJob {
+		const FontGlyph* glyph;
+		// The baked texture data of the glyph, or nullptr to generate it.
+		const FontBakedGlyphs::LayerGlyph* baked;
+		FontGlyphAtlas::Allocation allocation;
+		byte* destination;
+		Vector2i dimensions;
+		int stride;
 	};
 
+	// Generates the texture data of a single glyph into its region of the atlas.
+	void GenerateGlyphTexture(const GlyphJob& job) const;
+
+	// Generates the character boxes from the distance fields of the glyphs.
+	void GenerateFromDistanceFields();
+
+	// Releases all glyphs owned by this layer from the atlas.
+	void ReleaseGlyphs();
+
+	// Returns the index of the given atlas page within our textures, adding it if necessary.
+	int GetTextureIndex(int page_index);
+
 	using CharacterMap = UnorderedMap<Character, TextureBox>;
-	using TextureList = Vector<CallbackTextureSource>;
 
 	SharedPtr<const FontEffect> effect;
+	FontFaceHandleDefault* handle = nullptr;
 
-	TextureList textures_owned;
-	TextureList* textures_ptr = &textures_owned;
-
-	TextureLayout texture_layout;
 	CharacterMap character_boxes;
+	// The atlas page of each texture used by the layer.
+	Vector<int> texture_pages;
+	// The atlas allocations owned by this layer, empty if the layer is cloned from another layer.
+	Vector<FontGlyphAtlas::Allocation> allocations;
+	// The layer we render the glyphs of, if cloned from another layer.
+	const FontFaceLayer* clone_source = nullptr;
+
+	// The distance field version the character boxes were generated from.
+	int distance_field_version = 0;
+	// The parameters of the distance field shader, and its compiled shader for each render manager.
+	Dictionary shader_parameters;
+	SmallUnorderedMap<RenderManager*, UniquePtr<CompiledShader>> shaders;
+
 	Colourb colour;
 };
 
@@ -29,6 +29,7 @@
 #ifndef RMLUI_CORE_FONTENGINEDEFAULT_FONTFAMILY_H
 #define RMLUI_CORE_FONTENGINEDEFAULT_FONTFAMILY_H
 
+#include "FontBakedGlyphs.h"
 #include "FontTypes.h"
 
 namespace Rml {
@@ -63,6 +64,9 @@ public:
 	/// Releases resources owned by sized font faces, including their textures and rendered glyphs.
 	void ReleaseFontResources();
 
+	/// Adds the glyphs of all font face handles in use by the family to the list of baked handles.
+	void Bake(Vector<FontBakedGlyphs::Handle>& baked_handles);
+
 protected:
 	String name;
 
@@ -0,0 +1,375 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+#include "FontGlyphAtlas.h"
+#include "../../../Include/RmlUi/Core/Core.h"
+#include "../../../Include/RmlUi/Core/SystemInterface.h"
+#include "../../../Include/RmlUi/Core/Texture.h"
+#include <algorithm>
+#include <string.h>
+
+namespace Rml {
+
+static constexpr int page_size = 512;
+// Empty space to the right and bottom of each glyph, to avoid neighboring glyphs bleeding into each other during texture filtering.
+static constexpr int glyph_padding = 1;
+// Beyond this number of shared pages, glyphs of the least recently used owners are evicted before new pages are created.
+static constexpr int max_shared_pages = 8;
+// Owners used within this many seconds are never evicted, to avoid repeatedly evicting glyphs in active use.
+static constexpr double min_eviction_idle_time = 1.0;
+
+SharedPtr<const void> FontGlyphAtlas::Owner::GetPin() const
+{
+	if (!pin)
+		pin = MakeShared<const int>(0);
+	return pin;
+}
+
+bool FontGlyphAtlas::Owner::IsPinned() const
+{
+	// The owner keeps one reference itself, any further references are held by its users.
+	return pin && pin.use_count() > 1;
+}
+
+FontGlyphAtlas::FontGlyphAtlas() {}
+
+FontGlyphAtlas::~FontGlyphAtlas()
+{
+	RMLUI_ASSERTMSG(owners.empty(), "Glyph atlas destroyed with outstanding allocations.");
+}
+
+FontGlyphAtlas::Allocation FontGlyphAtlas::Allocate(Owner* owner, Vector2i dimensions)
+{
+	RMLUI_ASSERT(owner);
+	if (dimensions.x <= 0 || dimensions.y <= 0)
+		return {};
+
+	Touch(owner);
+
+	const Vector2i padded_dimensions = dimensions + Vector2i(glyph_padding);
+	Allocation allocation;
+	Vector2i position;
+
+	if (padded_dimensions.x > page_size || padded_dimensions.y > page_size)
+	{
+		// Glyphs too large for the shared pages get a page of their own.
+		allocation.page_index = CreatePage(padded_dimensions, true);
+		AllocateInPage(*pages[allocation.page_index], padded_dimensions, position);
+	}
+	else
+	{
+		auto TryAllocate = [&]() {
+			for (int i = 0; i < (int)pages.size(); i++)
+			{
+				if (pages[i] && !pages[i]->dedicated && AllocateInPage(*pages[i], padded_dimensions, position))
+				{
+					allocation.page_index = i;
+					return true;
+				}
+			}
+			return false;
+		};
+
+		bool success = TryAllocate();
+
+		const int num_shared_pages =
+			(int)std::count_if(pages.begin(), pages.end(), [](const UniquePtr<Page>& page) { return page && !page->dedicated; });
+
+		while (!success && num_shared_pages >= max_shared_pages)
+		{
+			Owner* candidate = FindEvictionCandidate(owner);
+			if (!candidate)
+				break;
+
+			candidate->OnAtlasEvicted();
+			if (candidate->num_allocations != 0)
+			{
+				RMLUI_ERRORMSG("Glyph atlas owner did not release its allocations on eviction.");
+				break;
+			}
+
+			success = TryAllocate();
+		}
+
+		if (!success)
+		{
+			allocation.page_index = CreatePage(Vector2i(page_size), false);
+			success = AllocateInPage(*pages[allocation.page_index], padded_dimensions, position);
+			RMLUI_ASSERT(success);
+		}
+	}
+
+	allocation.rectangle = Rectanglei::FromPositionSize(position, dimensions);
+	pages[allocation.page_index]->num_allocations += 1;
+
+	if (owner->num_allocations == 0)
+		owners.push_back(owner);
+	owner->num_allocations += 1;
+
+	return allocation;
+}
+
+void FontGlyphAtlas::Release(Owner* owner, const Allocation& allocation)
+{
+	RMLUI_ASSERT(owner && owner->num_allocations > 0);
+	if (!allocation)
+		return;
+
+	Page& page = *pages[allocation.page_index];
+
+	// Clear the glyph, so that it doesn't bleed into any glyphs placed next to this region later on.
+	const int stride = page.dimensions.x * 4;
+	byte* data = page.data.data() + allocation.rectangle.Top() * stride + allocation.rectangle.Left() * 4;
+	for (int y = 0; y < allocation.rectangle.Height(); y++)
+		memset(data + y * stride, 0, allocation.rectangle.Width() * 4);
+	AddDirtyRegion(page, allocation.rectangle);
+
+	ReleaseInPage(page, Rectanglei::FromPositionSize(allocation.rectangle.Position(), allocation.rectangle.Size() + Vector2i(glyph_padding)));
+
+	page.num_allocations -= 1;
+	if (page.dedicated && page.num_allocations == 0)
+		pages[allocation.page_index].reset();
+
+	owner->num_allocations -= 1;
+	if (owner->num_allocations == 0)
+		owners.erase(std::find(owners.begin(), owners.end(), owner));
+}
+
+void FontGlyphAtlas::Touch(const Owner* owner)
+{
+	owner->last_use_time = GetSystemInterface()->GetElapsedTime();
+}
+
+void FontGlyphAtlas::RemoveOwner(Owner* owner)
+{
+	RMLUI_ASSERTMSG(owner->num_allocations == 0, "Owner removed from the glyph atlas while still having allocations.");
+	auto it = std::find(owners.begin(), owners.end(), owner);
+	if (it != owners.end())
+		owners.erase(it);
+}
+
+byte* FontGlyphAtlas::GetTextureData(const Allocation& allocation, int& stride)
+{
+	RMLUI_ASSERT(allocation);
+	Page& page = *pages[allocation.page_index];
+	stride = page.dimensions.x * 4;
+	return page.data.data() + allocation.rectangle.Top() * stride + allocation.rectangle.Left() * 4;
+}
+
+void FontGlyphAtlas::MarkDirty(const Allocation& allocation)
+{
+	RMLUI_ASSERT(allocation);
+	AddDirtyRegion(*pages[allocation.page_index], allocation.rectangle);
+}
+
+Vector2i FontGlyphAtlas::GetPageDimensions(int page_index) const
+{
+	return pages[page_index]->dimensions;
+}
+
+Texture FontGlyphAtlas::GetTexture(RenderManager& render_manager, int page_index)
+{
+	Page& page = *pages[page_index];
+	if (page.dirty_region.Valid())
+		UpdateTexture(page);
+	return page.texture.GetTexture(render_manager);
+}
+
+int FontGlyphAtlas::GetNumPages() const
+{
+	return (int)std::count_if(pages.begin(), pages.end(), [](const UniquePtr<Page>& page) { return page != nullptr; });
+}
+
+void FontGlyphAtlas::ReleaseUnusedPages()
+{
+	for (UniquePtr<Page>& page : pages)
+	{
+		if (page && page->num_allocations == 0)
+			page.reset();
+	}
+
+	while (!pages.empty() && !pages.back())
+		pages.pop_back();
+}
+
+int FontGlyphAtlas::CreatePage(Vector2i dimensions, bool dedicated)
+{
+	auto it = std::find(pages.begin(), pages.end(), nullptr);
+	if (it == pages.end())
+		it = pages.insert(pages.end(), nullptr);
+
+	*it = MakeUnique<Page>();
+	Page* page = it->get();
+	page->dimensions = dimensions;
+	page->data.resize(size_t(dimensions.x * dimensions.y * 4), 0);
+	page->dedicated = dedicated;
+	page->texture = CallbackTextureSource([page](const CallbackTextureInterface& texture_interface) -> bool {
+		return texture_interface.GenerateTexture(page->data, page->dimensions);
+	});
+
+	return int(it - pages.begin());
+}
+
+bool FontGlyphAtlas::AllocateInPage(Page& page, Vector2i padded_dimensions, Vector2i& position)
+{
+	const int width = padded_dimensions.x;
+	const int height = padded_dimensions.y;
+
+	for (Shelf& shelf : page.shelves)
+	{
+		// Avoid placing glyphs on shelves much taller than themselves, unless the shelf is currently unused.
+		if (height > shelf.height || (shelf.num_allocations > 0 && height * 4 < shelf.height * 3))
+			continue;
+
+		for (auto it = shelf.free_spans.begin(); it != shelf.free_spans.end(); ++it)
+		{
+			if (it->width >= width)
+			{
+				position = Vector2i(it->x, shelf.y);
+				it->x += width;
+				it->width -= width;
+				if (it->width == 0)
+					shelf.free_spans.erase(it);
+				shelf.num_allocations += 1;
+				return true;
+			}
+		}
+
+		if (shelf.x_end + width <= page.dimensions.x)
+		{
+			position = Vector2i(shelf.x_end, shelf.y);
+			shelf.x_end += width;
+			shelf.num_allocations += 1;
+			return true;
+		}
+	}
+
+	if (page.shelves_end + height <= page.dimensions.y && width <= page.dimensions.x)
+	{
+		Shelf shelf;
+		shelf.y = page.shelves_end;
+		shelf.height = height;
+		shelf.x_end = width;
+		shelf.num_allocations = 1;
+		page.shelves.push_back(std::move(shelf));
+		page.shelves_end += height;
+
+		position = Vector2i(0, page.shelves.back().y);
+		return true;
+	}
+
+	return false;
+}
+
+void FontGlyphAtlas::ReleaseInPage(Page& page, Rectanglei padded_rectangle)
+{
+	auto it_shelf = std::find_if(page.shelves.begin(), page.shelves.end(), [&](const Shelf& shelf) { return shelf.y == padded_rectangle.Top(); });
+	RMLUI_ASSERT(it_shelf != page.shelves.end());
+	Shelf& shelf = *it_shelf;
+
+	shelf.num_allocations -= 1;
+	if (shelf.num_allocations == 0)
+	{
+		shelf.x_end = 0;
+		shelf.free_spans.clear();
+	}
+	else if (padded_rectangle.Right() == shelf.x_end)
+	{
+		// Shrink the used area of the shelf, including any free spans now at its end.
+		shelf.x_end = padded_rectangle.Left();
+		while (!shelf.free_spans.empty() && shelf.free_spans.back().x + shelf.free_spans.back().width == shelf.x_end)
+		{
+			shelf.x_end = shelf.free_spans.back().x;
+			shelf.free_spans.pop_back();
+		}
+	}
+	else
+	{
+		// Insert the span sorted by position, and merge it with any adjacent spans.
+		Span span = {padded_rectangle.Left(), padded_rectangle.Width()};
+		auto it = std::lower_bound(shelf.free_spans.begin(), shelf.free_spans.end(), span, [](const Span& a, const Span& b) { return a.x < b.x; });
+		it = shelf.free_spans.insert(it, span);
+
+		if (it + 1 != shelf.free_spans.end() && it->x + it->width == (it + 1)->x)
+		{
+			it->width += (it + 1)->width;
+			shelf.free_spans.erase(it + 1);
+		}
+		if (it != shelf.free_spans.begin() && (it - 1)->x + (it - 1)->width == it->x)
+		{
+			(it - 1)->width += it->width;
+			shelf.free_spans.erase(it);
+		}
+	}
+
+	// Remove unused shelves at the end of the page, so that their space can be used by shelves of any height.
+	while (!page.shelves.empty() && page.shelves.back().num_allocations == 0)
+	{
+		page.shelves_end = page.shelves.back().y;
+		page.shelves.pop_back();
+	}
+}
+
+void FontGlyphAtlas::AddDirtyRegion(Page& page, Rectanglei region)
+{
+	page.dirty_region = (page.dirty_region.Valid() ? page.dirty_region.Join(region) : region);
+}
+
+void FontGlyphAtlas::UpdateTexture(Page& page)
+{
+	const Rectanglei region = page.dirty_region;
+	page.dirty_region = Rectanglei::MakeInvalid();
+
+	// Copy the region into tightly packed rows, so that only the modified part of the texture needs to be uploaded.
+	const int source_stride = page.dimensions.x * 4;
+	const int region_stride = region.Width() * 4;
+	update_data.resize(size_t(region_stride * region.Height()));
+
+	const byte* source = page.data.data() + region.Top() * source_stride + region.Left() * 4;
+	for (int y = 0; y < region.Height(); y++)
+		memcpy(update_data.data() + y * region_stride, source + y * source_stride, region_stride);
+
+	page.texture.Update(update_data, region);
+}
+
+FontGlyphAtlas::Owner* FontGlyphAtlas::FindEvictionCandidate(const Owner* requester) const
+{
+	const double current_time = GetSystemInterface()->GetElapsedTime();
+
+	Owner* candidate = nullptr;
+	for (Owner* owner : owners)
+	{
+		if (owner == requester || owner->last_use_time + min_eviction_idle_time > current_time || owner->IsPinned())
+			continue;
+		if (!candidate || owner->last_use_time < candidate->last_use_time)
+			candidate = owner;
+	}
+
+	return candidate;
+}
+
+} // namespace Rml
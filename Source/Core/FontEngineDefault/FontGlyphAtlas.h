@@ -0,0 +1,146 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+#ifndef RMLUI_CORE_FONTENGINEDEFAULT_FONTGLYPHATLAS_H
+#define RMLUI_CORE_FONTENGINEDEFAULT_FONTGLYPHATLAS_H
+
+#include "../../../Include/RmlUi/Core/CallbackTexture.h"
+#include "../../../Include/RmlUi/Core/Rectangle.h"
+#include "../../../Include/RmlUi/Core/Traits.h"
+#include "../../../Include/RmlUi/Core/Types.h"
+
+namespace Rml {
+
+/**
+    Texture atlas shared by the glyphs of all font face handles and their layers.
+
+    Glyphs are packed into fixed-size pages using shelves of similar heights. Each page keeps a copy of its texture data, so that new glyphs
+    can be inserted without regenerating the glyphs already in the page, and only the modified region of the page needs to be uploaded.
+    When the atlas grows beyond its soft limit of pages, the glyphs of the least recently used owners are evicted to make room for new glyphs.
+    Owners are never evicted while they are pinned, such as by geometry which may still be rendered from their glyphs.
+ */
+class FontGlyphAtlas : NonCopyMoveable {
+public:
+	/// A region of the atlas reserved for a single glyph.
+	struct Allocation {
+		int page_index = -1;
+		Rectanglei rectangle;
+
+		explicit operator bool() const { return page_index >= 0; }
+	};
+
+	/// Users of the atlas, whose allocations may be evicted to make room for other glyphs.
+	class Owner {
+	public:
+		/// Called when the atlas needs the owner to release all of its allocations.
+		virtual void OnAtlasEvicted() = 0;
+
+		/// Returns a pin which protects the owner from eviction for as long as any copy of it is held.
+		SharedPtr<const void> GetPin() const;
+
+	protected:
+		~Owner() = default;
+
+	private:
+		bool IsPinned() const;
+
+		mutable double last_use_time = 0;
+		mutable SharedPtr<const int> pin;
+		int num_allocations = 0;
+		friend class FontGlyphAtlas;
+	};
+
+	FontGlyphAtlas();
+	~FontGlyphAtlas();
+
+	/// Reserves a region of the given dimensions for the owner.
+	/// @return The new allocation, or an invalid allocation if the dimensions are empty.
+	Allocation Allocate(Owner* owner, Vector2i dimensions);
+	/// Releases a region previously allocated by the owner, and clears its texture data.
+	void Release(Owner* owner, const Allocation& allocation);
+
+	/// Marks the owner as being used now, protecting it from eviction for a while.
+	void Touch(const Owner* owner);
+	/// Removes the owner from the atlas, it must not have any allocations left.
+	void RemoveOwner(Owner* owner);
+
+	/// Returns the texture data of the allocation's top-left pixel, in premultiplied RGBA8 format.
+	/// @param[out] stride The number of bytes between each row of the texture data.
+	byte* GetTextureData(const Allocation& allocation, int& stride);
+	/// Marks the texture data of the allocation as modified, so that it is uploaded before the page texture is used again.
+	void MarkDirty(const Allocation& allocation);
+
+	/// Returns the dimensions of the given page.
+	Vector2i GetPageDimensions(int page_index) const;
+	/// Returns the texture of the given page, after uploading any modified regions of the page.
+	Texture GetTexture(RenderManager& render_manager, int page_index);
+	/// Returns the number of pages currently in use.
+	int GetNumPages() const;
+
+	/// Releases all pages which no longer contain any glyphs.
+	void ReleaseUnusedPages();
+
+private:
+	struct Span {
+		int x;
+		int width;
+	};
+	struct Shelf {
+		int y;
+		int height;
+		// The end of the area used by allocations, spans before this point may be freed again.
+		int x_end = 0;
+		Vector<Span> free_spans;
+		int num_allocations = 0;
+	};
+	struct Page {
+		Vector2i dimensions;
+		Vector<byte> data;
+		Vector<Shelf> shelves;
+		int shelves_end = 0;
+		int num_allocations = 0;
+		bool dedicated = false;
+		// The region of the texture data modified since the texture was last updated.
+		Rectanglei dirty_region = Rectanglei::MakeInvalid();
+		CallbackTextureSource texture;
+	};
+
+	int CreatePage(Vector2i dimensions, bool dedicated);
+	static bool AllocateInPage(Page& page, Vector2i padded_dimensions, Vector2i& position);
+	static void ReleaseInPage(Page& page, Rectanglei padded_rectangle);
+	static void AddDirtyRegion(Page& page, Rectanglei region);
+	void UpdateTexture(Page& page);
+	Owner* FindEvictionCandidate(const Owner* requester) const;
+
+	Vector<UniquePtr<Page>> pages;
+	Vector<Owner*> owners;
+	// Scratch buffer for the texture data of dirty regions.
+	Vector<byte> update_data;
+};
+
+} // namespace Rml
+#endif
@@ -31,6 +31,7 @@
 #include "../../../Include/RmlUi/Core/FileInterface.h"
 #include "../../../Include/RmlUi/Core/Log.h"
 #include "../../../Include/RmlUi/Core/Math.h"
+#include "../../../Include/RmlUi/Core/RenderInterface.h"
 #include "../../../Include/RmlUi/Core/StringUtilities.h"
 #include "../ComputeProperty.h"
 #include "FontFace.h"
@@ -42,6 +43,11 @@ namespace Rml {
 
 static FontProvider* g_font_provider = nullptr;
 
+enum class DistanceFieldSupport { Unknown, Supported, Unsupported };
+static bool distance_field_rendering = false;
+static DistanceFieldSupport distance_field_support = DistanceFieldSupport::Unknown;
+static bool parallel_glyph_generation = false;
+
 FontProvider::FontProvider()
 {
 	RMLUI_ASSERT(!g_font_provider);
@@ -108,6 +114,147 @@ void FontProvider::ReleaseFontResources()
 	RMLUI_ASSERT(g_font_provider);
 	for (auto& name_family : g_font_provider->font_families)
 		name_family.second->ReleaseFontResources();
+
+	g_font_provider->glyph_atlas.ReleaseUnusedPages();
+}
+
+FontGlyphAtlas& FontProvider::GetGlyphAtlas()
+{
+	return Get().glyph_atlas;
+}
+
+bool FontProvider::LoadBakedGlyphs(const String& file_name)
+{
+	FileInterface* file_interface = GetFileInterface();
+	FileHandle handle = file_interface->Open(file_name);
+
+	if (!handle)
+	{
+		Log::Message(Log::LT_ERROR, "Failed to load baked font glyphs from %s, could not open file.", file_name.c_str());
+		return false;
+	}
+
+	size_t length = file_interface->Length(handle);
+
+	auto buffer = UniquePtr<byte[]>(new byte[length]);
+	file_interface->Read(buffer.get(), length, handle);
+	file_interface->Close(handle);
+
+	auto baked = MakeUnique<FontBakedGlyphs>();
+	if (!baked->Load(std::move(buffer), length, file_name))
+		return false;
+
+	Get().baked_glyphs.push_back(std::move(baked));
+	return true;
+}
+
+bool FontProvider::LoadBakedGlyphs(Span<const byte> data)
+{
+	auto buffer = UniquePtr<byte[]>(new byte[data.size()]);
+	std::copy(data.begin(), data.end(), buffer.get());
+
+	auto baked = MakeUnique<FontBakedGlyphs>();
+	if (!baked->Load(std::move(buffer), data.size(), "memory"))
+		return false;
+
+	Get().baked_glyphs.push_back(std::move(baked));
+	return true;
+}
+
+void FontProvider::ReleaseBakedGlyphs()
+{
+	// The font face handles may refer to the baked glyphs, release them first.
+	ReleaseFontResources();
+	Get().baked_glyphs.clear();
+}
+
+const FontBakedGlyphs::Handle* FontProvider::FindBakedHandle(const String& family, Style::FontStyle style, Style::FontWeight weight, int size)
+{
+	for (const UniquePtr<FontBakedGlyphs>& baked : Get().baked_glyphs)
+	{
+		if (const FontBakedGlyphs::Handle* handle = baked->Find(family, style, weight, size))
+			return handle;
+	}
+	return nullptr;
+}
+
+void FontProvider::BakeGlyphs(Vector<byte>& out_data)
+{
+	FontFamilyMap& families = Get().font_families;
+
+	// Bake the families in order of their names, so that baking the same handles always produces the same data.
+	Vector<String> family_names;
+	for (const auto& name_family : families)
+		family_names.push_back(name_family.first);
+	std::sort(family_names.begin(), family_names.end());
+
+	Vector<FontBakedGlyphs::Handle> handles;
+	for (const String& family_name : family_names)
+		families[family_name]->Bake(handles);
+
+	// The baked handles refer to the glyphs and atlas data of the handles, which are kept alive while writing them.
+	FontBakedGlyphs::Write(handles, out_data);
+}
+
+bool FontProvider::SetDistanceFieldRendering(bool enable)
+{
+	if (distance_field_rendering == enable)
+		return false;
+
+	distance_field_rendering = enable;
+	distance_field_support = DistanceFieldSupport::Unknown;
+	return true;
+}
+
+static bool SupportsDistanceFieldShader(RenderInterface* render_interface)
+{
+	const Dictionary parameters = {{"edge", Variant(0.5f)}, {"softness", Variant(0.f)}};
+	CompiledShaderHandle shader = render_interface->CompileShader("sdf-text", parameters);
+	if (!shader)
+		return false;
+
+	render_interface->ReleaseShader(shader);
+	return true;
+}
+
+bool FontProvider::UsesDistanceFieldRendering()
+{
+	if (!distance_field_rendering)
+		return false;
+
+	if (distance_field_support == DistanceFieldSupport::Unknown)
+	{
+		// Probe the render interface for support of the distance field shader.
+		RenderInterface* render_interface = ::Rml::GetRenderInterface();
+		const bool supported = (render_interface && SupportsDistanceFieldShader(render_interface));
+		distance_field_support = (supported ? DistanceFieldSupport::Supported : DistanceFieldSupport::Unsupported);
+
+		if (!supported)
+			Log::Message(Log::LT_WARNING, "The render interface does not support the 'sdf-text' shader, falling back to bitmap glyph rendering.");
+	}
+
+	return distance_field_support == DistanceFieldSupport::Supported;
+}
+
+bool FontProvider::VerifyDistanceFieldSupport(RenderInterface* render_interface)
+{
+	if (!UsesDistanceFieldRendering() || SupportsDistanceFieldShader(render_interface))
+		return false;
+
+	// Glyphs are shared between all contexts, thus every render interface must be able to render them.
+	distance_field_support = DistanceFieldSupport::Unsupported;
+	Log::Message(Log::LT_WARNING, "The render interface of a context does not support the 'sdf-text' shader, falling back to bitmap glyph rendering.");
+	return true;
+}
+
+void FontProvider::SetParallelGlyphGeneration(bool enable)
+{
+	parallel_glyph_generation = enable;
+}
+
+bool FontProvider::UsesParallelGlyphGeneration()
+{
+	return parallel_glyph_generation;
 }
 
 bool FontProvider::LoadFontFace(const String& file_name, int face_index, bool fallback_face, Style::FontWeight weight)
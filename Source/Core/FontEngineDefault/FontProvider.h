@@ -31,6 +31,8 @@
 
 #include "../../../Include/RmlUi/Core/StyleTypes.h"
 #include "../../../Include/RmlUi/Core/Types.h"
+#include "FontBakedGlyphs.h"
+#include "FontGlyphAtlas.h"
 #include "FontTypes.h"
 
 namespace Rml {
@@ -38,6 +40,7 @@ namespace Rml {
 class FontFace;
 class FontFamily;
 class FontFaceHandleDefault;
+class RenderInterface;
 
 /**
     The font provider contains all font families currently in use by RmlUi.
@@ -74,6 +77,35 @@ public:
 	/// Releases resources owned by sized font faces, including their textures and rendered glyphs.
 	static void ReleaseFontResources();
 
+	/// Returns the atlas storing the rendered glyphs of all font faces.
+	static FontGlyphAtlas& GetGlyphAtlas();
+
+	/// Loads glyphs baked ahead of time, used by the font face handles created afterward instead of rasterizing their glyphs.
+	static bool LoadBakedGlyphs(const String& file_name);
+	/// Loads baked glyphs from memory, the data is copied.
+	static bool LoadBakedGlyphs(Span<const byte> data);
+	/// Releases all baked glyphs, along with the font resources using them.
+	static void ReleaseBakedGlyphs();
+	/// Returns the baked glyphs of the given font face and size, or nullptr if none have been loaded.
+	static const FontBakedGlyphs::Handle* FindBakedHandle(const String& family, Style::FontStyle style, Style::FontWeight weight, int size);
+	/// Bakes the glyphs and font effect layers of all font face handles currently in use.
+	/// @param[out] out_data The baked glyphs, in the format accepted by LoadBakedGlyphs.
+	static void BakeGlyphs(Vector<byte>& out_data);
+
+	/// Enables or disables rendering glyphs from signed distance fields. Can be called before initialisation.
+	/// @return True if the setting was changed.
+	static bool SetDistanceFieldRendering(bool enable);
+	/// Returns true if glyphs should be rendered from signed distance fields, which requires the render interface to support the 'sdf-text' shader.
+	static bool UsesDistanceFieldRendering();
+	/// Falls back to rendering bitmap glyphs if the given render interface does not support the 'sdf-text' shader.
+	/// @return True if distance field rendering was in use and has now been disabled, in which case all font resources must be released.
+	static bool VerifyDistanceFieldSupport(RenderInterface* render_interface);
+
+	/// Enables or disables rasterizing glyphs and generating their font effects in parallel tasks. Can be called before initialisation.
+	static void SetParallelGlyphGeneration(bool enable);
+	/// Returns true if glyphs should be generated in parallel tasks, distributed using the system interface.
+	static bool UsesParallelGlyphGeneration();
+
 private:
 	FontProvider();
 	~FontProvider();
@@ -89,6 +121,11 @@ private:
 	using FontFaceList = Vector<FontFace*>;
 	using FontFamilyMap = UnorderedMap<String, UniquePtr<FontFamily>>;
 
+	// Declared before the font families, so that it outlives all the glyphs they place in it.
+	FontGlyphAtlas glyph_atlas;
+	// Declared before the font families, so that the baked data outlives the glyphs referring to it.
+	Vector<UniquePtr<FontBakedGlyphs>> baked_glyphs;
+
 	FontFamilyMap font_families;
 	FontFaceList fallback_font_faces;
 
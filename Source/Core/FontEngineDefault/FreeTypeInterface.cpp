@@ -29,7 +29,9 @@
 #include "FreeTypeInterface.h"
 #include "../../../Include/RmlUi/Core/ComputedValues.h"
 #include "../../../Include/RmlUi/Core/FontMetrics.h"
+#include "../../../Include/RmlUi/Core/Core.h"
 #include "../../../Include/RmlUi/Core/Log.h"
+#include "../../../Include/RmlUi/Core/SystemInterface.h"
 #include <algorithm>
 #include <ft2build.h>
 #include <limits.h>
@@ -42,8 +44,11 @@ namespace Rml {
 
 static FT_Library ft_library = nullptr;
 
-static bool BuildGlyph(FT_Face ft_face, Character character, FontGlyphMap& glyphs, float bitmap_scaling_factor);
-static void BuildGlyphMap(FT_Face ft_face, int size, FontGlyphMap& glyphs, float bitmap_scaling_factor, bool load_default_glyphs);
+static bool BuildGlyph(FT_Face ft_face, Character character, FontGlyphMap& glyphs, float bitmap_scaling_factor, bool load_bitmap);
+static void BuildGlyphMap(FT_Face ft_face, int size, FontGlyphMap& glyphs, float bitmap_scaling_factor, bool load_default_glyphs, bool load_bitmaps,
+	bool parallel);
+static void BuildGlyphsParallel(FT_Face ft_face, int size, const Vector<Character>& characters, FontGlyphMap& glyphs, float bitmap_scaling_factor,
+	bool load_bitmaps);
 static void GenerateMetrics(FT_Face ft_face, FontMetrics& metrics, float bitmap_scaling_factor);
 static bool SetFontSize(FT_Face ft_face, int font_size, float& out_bitmap_scaling_factor);
 static void BitmapDownscale(byte* bitmap_new, int new_width, int new_height, const byte* bitmap_source, int width, int height, int pitch,
@@ -189,7 +194,8 @@ void FreeType::GetFaceStyle(FontFaceHandleFreetype in_face, String* font_family,
 	}
 }
 
-bool FreeType::InitialiseFaceHandle(FontFaceHandleFreetype face, int font_size, FontGlyphMap& glyphs, FontMetrics& metrics, bool load_default_glyphs)
+bool FreeType::InitialiseFaceHandle(FontFaceHandleFreetype face, int font_size, FontGlyphMap& glyphs, FontMetrics& metrics, bool load_default_glyphs,
+	bool load_glyph_bitmaps, bool parallel)
 {
 	FT_Face ft_face = (FT_Face)face;
 
@@ -200,7 +206,7 @@ bool FreeType::InitialiseFaceHandle(FontFaceHandleFreetype face, int font_size,
 		return false;
 
 	// Construct the initial list of glyphs.
-	BuildGlyphMap(ft_face, font_size, glyphs, bitmap_scaling_factor, load_default_glyphs);
+	BuildGlyphMap(ft_face, font_size, glyphs, bitmap_scaling_factor, load_default_glyphs, load_glyph_bitmaps, parallel);
 
 	// Generate the metrics for the handle.
 	GenerateMetrics(ft_face, metrics, bitmap_scaling_factor);
@@ -208,7 +214,7 @@ bool FreeType::InitialiseFaceHandle(FontFaceHandleFreetype face, int font_size,
 	return true;
 }
 
-bool FreeType::AppendGlyph(FontFaceHandleFreetype face, int font_size, Character character, FontGlyphMap& glyphs)
+bool FreeType::AppendGlyph(FontFaceHandleFreetype face, int font_size, Character character, FontGlyphMap& glyphs, bool load_glyph_bitmaps)
 {
 	FT_Face ft_face = (FT_Face)face;
 
@@ -220,7 +226,7 @@ bool FreeType::AppendGlyph(FontFaceHandleFreetype face, int font_size, Character
 	if (!SetFontSize(ft_face, font_size, bitmap_scaling_factor))
 		return false;
 
-	if (!BuildGlyph(ft_face, character, glyphs, bitmap_scaling_factor))
+	if (!BuildGlyph(ft_face, character, glyphs, bitmap_scaling_factor, load_glyph_bitmaps))
 		return false;
 
 	return true;
@@ -260,7 +266,15 @@ bool FreeType::HasKerning(FontFaceHandleFreetype face)
 	return FT_HAS_KERNING(ft_face);
 }
 
-static void BuildGlyphMap(FT_Face ft_face, int size, FontGlyphMap& glyphs, const float bitmap_scaling_factor, const bool load_default_glyphs)
+bool FreeType::HasMonochromeOutlines(FontFaceHandleFreetype face)
+{
+	FT_Face ft_face = (FT_Face)face;
+
+	return FT_IS_SCALABLE(ft_face) && !FT_HAS_COLOR(ft_face);
+}
+
+static void BuildGlyphMap(FT_Face ft_face, int size, FontGlyphMap& glyphs, const float bitmap_scaling_factor, const bool load_default_glyphs,
+	const bool load_bitmaps, const bool parallel)
 {
 	if (load_default_glyphs)
 	{
@@ -270,8 +284,20 @@ static void BuildGlyphMap(FT_Face ft_face, int size, FontGlyphMap& glyphs, const
 		FT_ULong code_min = 32;
 		FT_ULong code_max = 126;
 
-		for (FT_ULong character_code = code_min; character_code <= code_max; ++character_code)
-			BuildGlyph(ft_face, (Character)character_code, glyphs, bitmap_scaling_factor);
+		if (parallel)
+		{
+			Vector<Character> characters;
+			characters.reserve(code_max - code_min + 1);
+			for (FT_ULong character_code = code_min; character_code <= code_max; ++character_code)
+				characters.push_back((Character)character_code);
+
+			BuildGlyphsParallel(ft_face, size, characters, glyphs, bitmap_scaling_factor, load_bitmaps);
+		}
+		else
+		{
+			for (FT_ULong character_code = code_min; character_code <= code_max; ++character_code)
+				BuildGlyph(ft_face, (Character)character_code, glyphs, bitmap_scaling_factor, load_bitmaps);
+		}
 	}
 
 	// Add a replacement character for rendering unknown characters.
@@ -302,7 +328,65 @@ static void BuildGlyphMap(FT_Face ft_face, int size, FontGlyphMap& glyphs, const
 	}
 }
 
-static bool BuildGlyph(FT_Face ft_face, const Character character, FontGlyphMap& glyphs, const float bitmap_scaling_factor)
+static void BuildGlyphsParallel(FT_Face ft_face, const int size, const Vector<Character>& characters, FontGlyphMap& glyphs,
+	const float bitmap_scaling_factor, const bool load_bitmaps)
+{
+	constexpr int batch_size = 16;
+	const int num_characters = (int)characters.size();
+	const int num_batches = (num_characters + batch_size - 1) / batch_size;
+
+	// A FreeType face can only be used by a single thread at a time, thus each batch is given its own face loaded from the same data. Faces
+	// share the library, so they must be created and released outside the tasks.
+	const int charmap_index = (ft_face->charmap ? FT_Get_Charmap_Index(ft_face->charmap) : -1);
+	Vector<FT_Face> batch_faces(num_batches, nullptr);
+	for (FT_Face& batch_face : batch_faces)
+	{
+		if (!ft_face->stream || !ft_face->stream->base ||
+			FT_New_Memory_Face(ft_library, ft_face->stream->base, (FT_Long)ft_face->stream->size, ft_face->face_index, &batch_face) != 0)
+		{
+			batch_face = nullptr;
+			continue;
+		}
+
+		float batch_scaling_factor = 1.f;
+		if ((charmap_index >= 0 && FT_Set_Charmap(batch_face, batch_face->charmaps[charmap_index]) != 0) ||
+			!SetFontSize(batch_face, size, batch_scaling_factor))
+		{
+			FT_Done_Face(batch_face);
+			batch_face = nullptr;
+		}
+	}
+
+	Vector<FontGlyphMap> batch_glyphs(num_batches);
+	GetSystemInterface()->ExecuteParallel(num_batches, [&](int batch_index) {
+		FT_Face batch_face = batch_faces[batch_index];
+		if (!batch_face)
+			return;
+
+		const int end = Math::Min((batch_index + 1) * batch_size, num_characters);
+		for (int i = batch_index * batch_size; i < end; i++)
+			BuildGlyph(batch_face, characters[i], batch_glyphs[batch_index], bitmap_scaling_factor, load_bitmaps);
+	});
+
+	for (int batch_index = 0; batch_index < num_batches; batch_index++)
+	{
+		if (FT_Face batch_face = batch_faces[batch_index])
+		{
+			for (auto& pair : batch_glyphs[batch_index])
+				glyphs.emplace(pair.first, std::move(pair.second));
+			FT_Done_Face(batch_face);
+		}
+		else
+		{
+			// Build the glyphs on our own face instead, if a face could not be loaded for the batch.
+			const int end = Math::Min((batch_index + 1) * batch_size, num_characters);
+			for (int i = batch_index * batch_size; i < end; i++)
+				BuildGlyph(ft_face, characters[i], glyphs, bitmap_scaling_factor, load_bitmaps);
+		}
+	}
+}
+
+static bool BuildGlyph(FT_Face ft_face, const Character character, FontGlyphMap& glyphs, const float bitmap_scaling_factor, const bool load_bitmap)
 {
 	FT_UInt index = FT_Get_Char_Index(ft_face, (FT_ULong)character);
 	if (index == 0)
@@ -316,6 +400,23 @@ static bool BuildGlyph(FT_Face ft_face, const Character character, FontGlyphMap&
 		return false;
 	}
 
+	if (!load_bitmap)
+	{
+		// Only determine the glyph metrics from its outline, the bitmap is not rendered.
+		auto result = glyphs.emplace(character, FontGlyph{});
+		if (!result.second)
+			return false;
+
+		const FT_Glyph_Metrics& ft_metrics = ft_face->glyph->metrics;
+		FontGlyph& glyph = result.first->second;
+		glyph.bearing.x = int(ft_metrics.horiBearingX >> 6);
+		glyph.bearing.y = int((ft_metrics.horiBearingY + 63) >> 6);
+		glyph.advance = int(ft_metrics.horiAdvance >> 6);
+		glyph.bitmap_dimensions.x = int((ft_metrics.width + 63) >> 6);
+		glyph.bitmap_dimensions.y = int((ft_metrics.height + 63) >> 6);
+		return true;
+	}
+
 	error = FT_Render_Glyph(ft_face->glyph, FT_RENDER_MODE_NORMAL);
 	if (error != 0)
 	{
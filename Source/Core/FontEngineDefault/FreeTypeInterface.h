@@ -54,10 +54,13 @@ namespace FreeType {
 	void GetFaceStyle(FontFaceHandleFreetype face, String* font_family, Style::FontStyle* style, Style::FontWeight* weight);
 
 	// Initializes a face for a given font size. Glyphs are filled with the ASCII subset, and the font face metrics are set.
-	bool InitialiseFaceHandle(FontFaceHandleFreetype face, int font_size, FontGlyphMap& glyphs, FontMetrics& metrics, bool load_default_glyphs);
+	// If 'load_glyph_bitmaps' is false, only the metrics of the glyphs are loaded, without rendering their bitmaps.
+	// If 'parallel' is true, the glyphs are built in parallel tasks using the system interface.
+	bool InitialiseFaceHandle(FontFaceHandleFreetype face, int font_size, FontGlyphMap& glyphs, FontMetrics& metrics, bool load_default_glyphs,
+		bool load_glyph_bitmaps = true, bool parallel = false);
 
 	// Build a new glyph representing the given code point and append to 'glyphs'.
-	bool AppendGlyph(FontFaceHandleFreetype face, int font_size, Character character, FontGlyphMap& glyphs);
+	bool AppendGlyph(FontFaceHandleFreetype face, int font_size, Character character, FontGlyphMap& glyphs, bool load_glyph_bitmaps = true);
 
 	// Returns the kerning between two characters.
 	// 'font_size' value of zero assumes the font size is already set on the face, and skips this step for performance reasons.
@@ -66,6 +69,9 @@ namespace FreeType {
 	// Returns true if the font face has kerning.
 	bool HasKerning(FontFaceHandleFreetype face);
 
+	// Returns true if the font face consists of scalable outlines without any color glyphs, as required for rendering from distance fields.
+	bool HasMonochromeOutlines(FontFaceHandleFreetype face);
+
 } // namespace FreeType
 } // namespace Rml
 #endif
@@ -359,9 +359,9 @@ void FlexFormattingContext::Format(Vector2f& flex_resulting_content_size, Vector
 			if (initial_box_size.x < 0.f && flex_available_content_size.x >= 0.f)
 				format_box.SetContent(Vector2f(flex_available_content_size.x - item.cross.sum_edges, initial_box_size.y));
 
-			FormattingContext::FormatIndependent(flex_container_box, element, (format_box.GetSize().x >= 0 ? &format_box : nullptr),
-				FormattingContextType::Block);
-			item.inner_flex_base_size = element->GetBox().GetSize().y;
+			const Vector2f measured_size = FormattingContext::MeasureIndependent(flex_container_box, element,
+				(format_box.GetSize().x >= 0 ? &format_box : nullptr), FormattingContextType::Block);
+			item.inner_flex_base_size = measured_size.y;
 
 			// Apply the automatic block size as minimum size (§4.5). Strictly speaking, we should also apply this to
 			// the other branches in column mode (and inline min-content size in row mode). However, the formatting step
@@ -702,8 +702,9 @@ void FlexFormattingContext::Format(Vector2f& flex_resulting_content_size, Vector
 				if (content_size.y < 0.0f)
 				{
 					item.box.SetContent(Vector2f(GetInnerUsedMainSize(item), content_size.y));
-					FormattingContext::FormatIndependent(flex_container_box, item.element, &item.box, FormattingContextType::Block);
-					item.hypothetical_cross_size = item.element->GetBox().GetSize().y + item.cross.sum_edges;
+					const Vector2f measured_size =
+						FormattingContext::MeasureIndependent(flex_container_box, item.element, &item.box, FormattingContextType::Block);
+					item.hypothetical_cross_size = measured_size.y + item.cross.sum_edges;
 				}
 				else
 				{
@@ -33,6 +33,8 @@
 #include "BlockFormattingContext.h"
 #include "FlexFormattingContext.h"
 #include "LayoutBox.h"
+#include "LayoutCache.h"
+#include "LayoutDetails.h"
 #include "ReplacedFormattingContext.h"
 #include "TableFormattingContext.h"
 
@@ -77,4 +79,20 @@ UniquePtr<LayoutBox> FormattingContext::FormatIndependent(ContainerBox* parent_c
 	return nullptr;
 }
 
+Vector2f FormattingContext::MeasureIndependent(ContainerBox* parent_container, Element* element, const Box* override_initial_box,
+	FormattingContextType backup_context)
+{
+	LayoutCache& cache = LayoutCache::Get(element);
+	const Vector2f containing_block = LayoutDetails::GetContainingBlock(parent_container, element->GetPosition()).size;
+
+	if (const Vector2f* cached_size = cache.Find(LayoutCache::Mode::FormattedSize, containing_block, override_initial_box))
+		return *cached_size;
+
+	FormatIndependent(parent_container, element, override_initial_box, backup_context);
+
+	const Vector2f size = element->GetBox().GetSize();
+	cache.Insert(LayoutCache::Mode::FormattedSize, containing_block, override_initial_box, size);
+	return size;
+}
+
 } // namespace Rml
@@ -58,6 +58,12 @@ public:
 	static UniquePtr<LayoutBox> FormatIndependent(ContainerBox* parent_container, Element* element, const Box* override_initial_box,
 		FormattingContextType backup_context);
 
+	/// Format the element in an independent formatting context to determine its size, reusing a cached result when available.
+	/// @note Unlike the above, the element's box is not necessarily updated, this should only be used for measuring the element.
+	/// @return The content size of the formatted element.
+	static Vector2f MeasureIndependent(ContainerBox* parent_container, Element* element, const Box* override_initial_box,
+		FormattingContextType backup_context);
+
 protected:
 	FormattingContext() = default;
 	~FormattingContext() = default;
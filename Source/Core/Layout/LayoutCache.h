@@ -0,0 +1,83 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef RMLUI_CORE_LAYOUT_LAYOUTCACHE_H
+#define RMLUI_CORE_LAYOUT_LAYOUTCACHE_H
+
+#include "../../../Include/RmlUi/Core/Box.h"
+#include "../../../Include/RmlUi/Core/Types.h"
+
+namespace Rml {
+
+/**
+    Stores the results of formatting an element only to measure it, such as during flex and table sizing.
+
+    Entries are keyed by the element's containing block and initial box. The cache is cleared whenever the layout of the element or any of
+    its descendants is dirtied, thus results can be reused both within a single layout pass and across passes.
+ */
+class LayoutCache {
+public:
+	enum class Mode : uint8_t {
+		ShrinkToFitWidth, // The result is the shrink-to-fit width in the x-component.
+		FormattedSize,    // The result is the content size of the formatted box.
+	};
+
+	/// Returns the cached result for the given inputs, or nullptr if there is none.
+	/// @param[in] override_initial_box The box the element was formatted under, or nullptr if it was generated from the containing block.
+	const Vector2f* Find(Mode mode, Vector2f containing_block, const Box* override_initial_box) const;
+	/// Stores a new result, possibly replacing an older entry.
+	void Insert(Mode mode, Vector2f containing_block, const Box* override_initial_box, Vector2f result);
+
+	void Clear()
+	{
+		entries.clear();
+		next_replace_index = 0;
+	}
+	bool IsEmpty() const { return entries.empty(); }
+
+	/// Returns the layout cache of the given element.
+	static LayoutCache& Get(Element* element);
+
+private:
+	struct Entry {
+		Mode mode;
+		bool has_box;
+		Vector2f containing_block;
+		Box box;
+		Vector2f result;
+	};
+
+	// Elements are normally measured under only a few different constraints, keep the cache small and replace the oldest entries.
+	static constexpr size_t max_entries = 4;
+
+	Vector<Entry> entries;
+	size_t next_replace_index = 0;
+};
+
+} // namespace Rml
+#endif
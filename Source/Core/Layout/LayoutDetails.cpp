@@ -35,6 +35,7 @@
 #include "../../../Include/RmlUi/Core/Profiling.h"
 #include "ContainerBox.h"
 #include "FormattingContext.h"
+#include "LayoutCache.h"
 #include "LayoutEngine.h"
 #include <float.h>
 
@@ -170,6 +171,12 @@ void LayoutDetails::GetDefiniteMinMaxHeight(float& min_height, float& max_height
 	}
 }
 
+bool LayoutDetails::IsAbsolutePositioningContainingBlock(const ComputedValues& computed)
+{
+	return computed.position() != Style::Position::Static || computed.has_local_transform() || computed.has_local_perspective() ||
+		computed.has_filter() || computed.has_backdrop_filter() || computed.has_mask_image();
+}
+
 ContainingBlock LayoutDetails::GetContainingBlock(ContainerBox* parent_container, const Style::Position position)
 {
 	RMLUI_ASSERT(parent_container);
@@ -264,6 +271,10 @@ float LayoutDetails::GetShrinkToFitWidth(Element* element, Vector2f containing_b
 		return 0.f;
 	}
 
+	LayoutCache& cache = LayoutCache::Get(element);
+	if (const Vector2f* cached_width = cache.Find(LayoutCache::Mode::ShrinkToFitWidth, containing_block, nullptr))
+		return cached_width->x;
+
 	// Use a large size for the box content width, so that it is practically unconstrained. This makes the formatting
 	// procedure act as if under a maximum content constraint. Children with percentage sizing values may be scaled
 	// based on this width (such as 'width' or 'margin'), if so, the layout is considered undefined like in CSS 2.
@@ -284,6 +295,8 @@ float LayoutDetails::GetShrinkToFitWidth(Element* element, Vector2f containing_b
 			Math::Max(0.f, containing_block.x - box.GetSizeAcross(BoxDirection::Horizontal, BoxArea::Margin, BoxArea::Padding));
 		shrink_to_fit_width = Math::Min(shrink_to_fit_width, available_width);
 	}
+
+	cache.Insert(LayoutCache::Mode::ShrinkToFitWidth, containing_block, nullptr, Vector2f(shrink_to_fit_width, 0.f));
 	return shrink_to_fit_width;
 }
 
@@ -124,6 +124,9 @@ public:
 		return overflow_x != Style::Overflow::Visible || overflow_y != Style::Overflow::Visible;
 	}
 
+	/// Returns true if an element with the given computed values acts as the containing block for absolutely positioned descendants.
+	static bool IsAbsolutePositioningContainingBlock(const ComputedValues& computed);
+
 private:
 	/// Calculates and returns the content size for replaced elements.
 	static Vector2f CalculateSizeForReplacedElement(Vector2f specified_content_size, Vector2f min_size, Vector2f max_size, Vector2f intrinsic_size,
@@ -27,11 +27,13 @@
  */
 
 #include "LayoutEngine.h"
+#include "../../../Include/RmlUi/Core/ComputedValues.h"
 #include "../../../Include/RmlUi/Core/Element.h"
 #include "../../../Include/RmlUi/Core/Log.h"
 #include "../../../Include/RmlUi/Core/Profiling.h"
 #include "ContainerBox.h"
 #include "FormattingContext.h"
+#include "LayoutDetails.h"
 
 namespace Rml {
 
@@ -58,4 +60,90 @@ void LayoutEngine::FormatElement(Element* element, Vector2f containing_block)
 	}
 }
 
+bool LayoutEngine::IsLayoutBoundary(Element* element)
+{
+	using namespace Style;
+	RMLUI_ASSERT(element);
+
+	Element* parent = element->GetParentNode();
+	if (!parent || element->IsReplaced())
+		return false;
+
+	const ComputedValues& computed = element->GetComputedValues();
+
+	const Display display = computed.display();
+	if ((display != Display::Block && display != Display::FlowRoot && display != Display::Flex) || computed.float_() != Float::None)
+		return false;
+
+	// The outer size must be fully determined by the element's own properties.
+	if (computed.width().type != Width::Length || computed.height().type != Height::Length || computed.min_width().type != MinWidth::Length ||
+		computed.max_width().type != MaxWidth::Length || computed.min_height().type != MinHeight::Length ||
+		computed.max_height().type != MaxHeight::Length)
+		return false;
+
+	// Absolutely positioned boxes are taken out of flow, and do not contribute to the overflow of their containing block. Other boxes must be
+	// placed in a block container, and catch their own overflow so that it is not propagated to any ancestors.
+	const Position position = computed.position();
+	if (position == Position::Absolute || position == Position::Fixed)
+		return true;
+
+	// Documents are formatted as block containers regardless of their inner display type, unless they are flex or table containers.
+	const Display parent_display = parent->GetDisplay();
+	const bool parent_is_document = (parent == element->GetOwnerDocument());
+	const bool parent_block_container = parent_is_document
+		? (parent_display != Display::Flex && parent_display != Display::InlineFlex && parent_display != Display::Table &&
+			  parent_display != Display::InlineTable)
+		: (parent_display == Display::Block || parent_display == Display::FlowRoot || parent_display == Display::InlineBlock);
+	if (!parent_block_container)
+		return false;
+
+	return LayoutDetails::IsScrollContainer(computed.overflow_x(), computed.overflow_y());
+}
+
+// Returns true if any absolutely positioned descendants have their containing block outside the given element.
+static bool HasEscapingAbsoluteDescendants(Element* element)
+{
+	const int num_children = element->GetNumChildren();
+	for (int i = 0; i < num_children; i++)
+	{
+		Element* child = element->GetChild(i);
+		const ComputedValues& computed = child->GetComputedValues();
+		if (computed.display() == Style::Display::None)
+			continue;
+
+		const Style::Position position = computed.position();
+		if (position == Style::Position::Absolute || position == Style::Position::Fixed)
+			return true;
+
+		if (!LayoutDetails::IsAbsolutePositioningContainingBlock(computed) && HasEscapingAbsoluteDescendants(child))
+			return true;
+	}
+	return false;
+}
+
+bool LayoutEngine::FormatLayoutBoundary(Element* element)
+{
+	RMLUI_ASSERT(element && element->GetParentNode());
+	RMLUI_ZoneScoped;
+
+	// Absolutely positioned descendants are laid out by their containing block, which must then be formatted as well.
+	if (!LayoutDetails::IsAbsolutePositioningContainingBlock(element->GetComputedValues()) && HasEscapingAbsoluteDescendants(element))
+		return false;
+
+	// Reuse the previously generated box, it is independent of our contents. The containing block only acts as a placeholder, as the
+	// element's box is already resolved and its size properties do not depend on it.
+	const Box box = element->GetBox();
+	RootBox root(element->GetParentNode()->GetBox().GetSize());
+
+	auto layout_box = FormattingContext::FormatIndependent(&root, element, &box, FormattingContextType::Block);
+	if (!layout_box)
+	{
+		Log::Message(Log::LT_ERROR, "Error while formatting element: %s", element->GetAddress().c_str());
+	}
+
+	element->ClampScrollOffsetRecursive();
+
+	return true;
+}
+
 } // namespace Rml
@@ -47,6 +47,16 @@ public:
 	/// @param[in] element The element to lay out.
 	/// @param[in] containing_block The size of the containing block.
 	static void FormatElement(Element* element, Vector2f containing_block);
+
+	/// Determines whether the element is a layout boundary, whose outer box can not depend on its contents. Such an element
+	/// can be formatted on its own when only its contents change, without affecting any of its ancestors or siblings.
+	/// @param[in] element The element to test, assumed to have been formatted previously as part of its document.
+	static bool IsLayoutBoundary(Element* element);
+
+	/// Formats the contents of a layout boundary, keeping its current box and position.
+	/// @param[in] element The layout boundary to format.
+	/// @return False if the element could not be formatted on its own, in which case nothing is done.
+	static bool FormatLayoutBoundary(Element* element);
 };
 
 } // namespace Rml
@@ -88,7 +88,8 @@ namespace Detail {
 
 	BasicStackAllocator& GetGlobalBasicStackAllocator()
 	{
-		static BasicStackAllocator stack_allocator(10 * 1024);
+		// Each thread has its own allocator, so that it can be used by tasks running in parallel.
+		static thread_local BasicStackAllocator stack_allocator(10 * 1024);
 		return stack_allocator;
 	}
 
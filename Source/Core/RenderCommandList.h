@@ -0,0 +1,128 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef RMLUI_CORE_RENDERCOMMANDLIST_H
+#define RMLUI_CORE_RENDERCOMMANDLIST_H
+
+#include "../../Include/RmlUi/Core/RenderManager.h"
+#include "../../Include/RmlUi/Core/Texture.h"
+#include "../../Include/RmlUi/Core/Types.h"
+
+namespace Rml {
+
+/**
+    A list of render commands recorded through the render manager, which can be replayed on later frames.
+
+    Used for retained rendering of stacking contexts, see Context::EnableRetainedRendering(). Resources are referenced
+    by index, and validated against the render manager before being replayed. All other state, such as the referenced
+    clip mask geometry and transforms, must be kept alive by the owner for as long as the list is considered valid.
+ */
+class RenderCommandList : NonCopyMoveable {
+public:
+	RenderCommandList() = default;
+
+	// Returns true if the list contains a complete recording which may be replayed.
+	bool IsValid() const { return valid; }
+
+	// The render pass during which the list was recorded.
+	uint32_t GetRecordStamp() const { return record_stamp; }
+	void SetRecordStamp(uint32_t stamp) { record_stamp = stamp; }
+
+	void Clear()
+	{
+		commands.clear();
+		render_commands.clear();
+		scissor_regions.clear();
+		clip_masks.clear();
+		transforms.clear();
+		composite_commands.clear();
+		filters.clear();
+		sublists.clear();
+		layer_depth = 0;
+		validated_release_count = 0;
+		valid = false;
+		discard = false;
+	}
+
+private:
+	enum class CommandType : uint8_t {
+		Render,
+		SetScissorRegion,
+		SetClipMask,
+		SetTransform,
+		PushLayer,
+		CompositeLayers,
+		PopLayer,
+		Replay,
+	};
+	struct Command {
+		CommandType type;
+		uint32_t index;
+	};
+	struct RenderGeometryCommand {
+		StableVectorIndex geometry;
+		uint32_t geometry_generation;
+		Vector2f translation;
+		Texture texture;
+		uint32_t texture_generation;
+		CompiledShaderHandle shader;
+	};
+	struct CompositeLayersCommand {
+		int source_layer;
+		int destination_layer;
+		BlendMode blend_mode;
+		uint32_t filters_begin;
+		uint32_t filters_count;
+	};
+
+	static constexpr uint32_t NullTransform = uint32_t(-1);
+
+	Vector<Command> commands;
+	Vector<RenderGeometryCommand> render_commands;
+	Vector<Rectanglei> scissor_regions;
+	Vector<ClipMaskGeometryList> clip_masks;
+	Vector<Matrix4f> transforms;
+	Vector<CompositeLayersCommand> composite_commands;
+	Vector<CompiledFilterHandle> filters;
+	Vector<RenderCommandList*> sublists;
+
+	// The size of the render manager's layer stack when recording started.
+	size_t layer_depth = 0;
+	// The render manager's resource release counter at the time the resources were last validated.
+	uint32_t validated_release_count = 0;
+	uint32_t record_stamp = 0;
+
+	bool valid = false;
+	// Set when a command which cannot be replayed was submitted during recording.
+	bool discard = false;
+
+	friend class RenderManager;
+};
+
+} // namespace Rml
+#endif
@@ -32,6 +32,8 @@
 #include "../../Include/RmlUi/Core/Profiling.h"
 #include "../../Include/RmlUi/Core/RenderInterface.h"
 #include "../../Include/RmlUi/Core/SystemInterface.h"
+#include "../../Include/RmlUi/Core/Utilities.h"
+#include "RenderCommandList.h"
 #include "TextureDatabase.h"
 
 namespace Rml {
@@ -66,6 +68,7 @@ RenderManager::~RenderManager()
 		}
 	}
 
+	ReleaseGeometryBatches(true);
 	ReleaseAllTextures();
 }
 
@@ -77,8 +80,13 @@ void RenderManager::PrepareRender(Vector2i dimensions)
 	RMLUI_ASSERT(state.scissor_region == default_state.scissor_region);
 	RMLUI_ASSERT(state.transform == default_state.transform);
 	RMLUI_ASSERTMSG(render_stack.empty(), "Unbalanced render stack detected, ensure every PushLayer call has a corresponding call to PopLayer.");
+	RMLUI_ASSERTMSG(recording_stack.empty(), "Unbalanced recording stack detected, ensure every BeginRecording has a matching EndRecording.");
 #endif
 
+	FlushGeometryBatch();
+	render_pass_count += 1;
+	ReleaseGeometryBatches(false);
+
 	SetViewport(dimensions);
 }
 
@@ -120,18 +128,30 @@ void RenderManager::DisableScissorRegion()
 
 void RenderManager::SetScissorRegion(Rectanglei new_region)
 {
+	if (RenderCommandList* recording = GetActiveRecording())
+	{
+		recording->commands.push_back({RenderCommandList::CommandType::SetScissorRegion, (uint32_t)recording->scissor_regions.size()});
+		recording->scissor_regions.push_back(new_region);
+	}
+
 	const bool old_scissor_enable = state.scissor_region.Valid();
 	const bool new_scissor_enable = new_region.Valid();
 
 	if (new_scissor_enable != old_scissor_enable)
+	{
+		FlushGeometryBatch();
 		render_interface->EnableScissorRegion(new_scissor_enable);
+	}
 
 	if (new_scissor_enable)
 	{
 		new_region = new_region.Intersect(Rectanglei::FromSize(viewport_dimensions));
 
 		if (new_region != state.scissor_region)
+		{
+			FlushGeometryBatch();
 			render_interface->SetScissorRegion(new_region);
+		}
 	}
 
 	state.scissor_region = new_region;
@@ -144,11 +164,7 @@ Rectanglei RenderManager::GetScissorRegion() const
 
 void RenderManager::DisableClipMask()
 {
-	if (!state.clip_mask_list.empty())
-	{
-		state.clip_mask_list.clear();
-		ApplyClipMask(state.clip_mask_list);
-	}
+	SetClipMask(ClipMaskGeometryList());
 }
 
 void RenderManager::SetClipMask(ClipMaskOperation operation, Geometry* geometry, Vector2f translation)
@@ -156,10 +172,22 @@ void RenderManager::SetClipMask(ClipMaskOperation operation, Geometry* geometry,
 	RMLUI_ASSERT(geometry && geometry->render_manager == this);
 	state.clip_mask_list = {ClipMaskGeometry{operation, geometry, translation, nullptr}};
 	ApplyClipMask(state.clip_mask_list);
+
+	if (RenderCommandList* recording = GetActiveRecording())
+	{
+		recording->commands.push_back({RenderCommandList::CommandType::SetClipMask, (uint32_t)recording->clip_masks.size()});
+		recording->clip_masks.push_back(state.clip_mask_list);
+	}
 }
 
 void RenderManager::SetClipMask(ClipMaskGeometryList in_clip_elements)
 {
+	if (RenderCommandList* recording = GetActiveRecording())
+	{
+		recording->commands.push_back({RenderCommandList::CommandType::SetClipMask, (uint32_t)recording->clip_masks.size()});
+		recording->clip_masks.push_back(in_clip_elements);
+	}
+
 	if (state.clip_mask_list != in_clip_elements)
 	{
 		state.clip_mask_list = std::move(in_clip_elements);
@@ -169,11 +197,23 @@ void RenderManager::SetClipMask(ClipMaskGeometryList in_clip_elements)
 
 void RenderManager::SetTransform(const Matrix4f* p_new_transform)
 {
+	if (RenderCommandList* recording = GetActiveRecording())
+	{
+		uint32_t index = RenderCommandList::NullTransform;
+		if (p_new_transform)
+		{
+			index = (uint32_t)recording->transforms.size();
+			recording->transforms.push_back(*p_new_transform);
+		}
+		recording->commands.push_back({RenderCommandList::CommandType::SetTransform, index});
+	}
+
 	static const Matrix4f identity_transform = Matrix4f::Identity();
 	const Matrix4f& new_transform = (p_new_transform ? *p_new_transform : identity_transform);
 
 	if (state.transform != new_transform)
 	{
+		FlushGeometryBatch();
 		render_interface->SetTransform(p_new_transform);
 		state.transform = new_transform;
 	}
@@ -181,11 +221,15 @@ void RenderManager::SetTransform(const Matrix4f* p_new_transform)
 
 void RenderManager::ApplyClipMask(const ClipMaskGeometryList& clip_elements)
 {
+	FlushGeometryBatch();
+
 	const bool clip_mask_enabled = !clip_elements.empty();
 	render_interface->EnableClipMask(clip_mask_enabled);
 
 	if (clip_mask_enabled)
 	{
+		// The transforms applied here are part of the clip mask command, don't record them separately.
+		recording_suspended += 1;
 		const Matrix4f initial_transform = state.transform;
 
 		for (const ClipMaskGeometry& element_clip : clip_elements)
@@ -198,6 +242,7 @@ void RenderManager::ApplyClipMask(const ClipMaskGeometryList& clip_elements)
 
 		// Apply the initially set transform in case it was changed.
 		SetTransform(&initial_transform);
+		recording_suspended -= 1;
 	}
 }
 
@@ -212,12 +257,14 @@ void RenderManager::SetState(const RenderState& next)
 
 void RenderManager::ResetState()
 {
+	FlushGeometryBatch();
 	SetState(RenderState{});
 }
 
 StableVectorIndex RenderManager::InsertGeometry(Mesh&& mesh)
 {
-	return geometry_list.insert(GeometryData{std::move(mesh), CompiledGeometryHandle{}});
+	geometry_generation += 1;
+	return geometry_list.insert(GeometryData{std::move(mesh), CompiledGeometryHandle{}, geometry_generation});
 }
 
 CompiledGeometryHandle RenderManager::GetCompiledGeometryHandle(StableVectorIndex index)
@@ -248,22 +295,318 @@ void RenderManager::Render(const Geometry& geometry, Vector2f translation, Textu
 		return;
 	}
 
-	if (CompiledGeometryHandle geometry_handle = GetCompiledGeometryHandle(geometry.resource_handle))
+	if (RenderCommandList* recording = GetActiveRecording())
+	{
+		const uint32_t geometry_generation_recorded = geometry_list[geometry.resource_handle].generation;
+		recording->commands.push_back({RenderCommandList::CommandType::Render, (uint32_t)recording->render_commands.size()});
+		recording->render_commands.push_back(RenderCommandList::RenderGeometryCommand{geometry.resource_handle, geometry_generation_recorded,
+			translation, texture, GetTextureGeneration(texture), shader.resource_handle});
+	}
+
+	RenderGeometry(geometry.resource_handle, translation, texture, shader.resource_handle);
+}
+
+void RenderManager::RenderGeometry(StableVectorIndex geometry_index, Vector2f translation, Texture texture, CompiledShaderHandle shader)
+{
+	// Geometry to be batched is compiled as part of the merged batch, thus only compile geometry that is submitted directly.
+	const bool batch_geometry = (enable_geometry_batching && !shader);
+	CompiledGeometryHandle geometry_handle = {};
+	if (batch_geometry)
+	{
+		if (geometry_list[geometry_index].mesh.indices.empty())
+			return;
+	}
+	else if (!(geometry_handle = GetCompiledGeometryHandle(geometry_index)))
+	{
+		return;
+	}
+
+	TextureHandle texture_handle = {};
+	if (texture.file_index != TextureFileIndex::Invalid)
+	{
+		texture_handle = texture_database->file_database.GetHandle(render_interface, texture.file_index);
+	}
+	else if (texture.callback_index != StableVectorIndex::Invalid)
 	{
-		TextureHandle texture_handle = {};
-		if (texture.file_index != TextureFileIndex::Invalid)
-			texture_handle = texture_database->file_database.GetHandle(render_interface, texture.file_index);
-		else if (texture.callback_index != StableVectorIndex::Invalid)
-			texture_handle = texture_database->callback_database.GetHandle(this, render_interface, texture.callback_index);
-
-		RMLUI_ZoneScopedNC("RenderGeometry", 0x3E60B2);
-		if (shader)
-			render_interface->RenderShader(shader.resource_handle, geometry_handle, translation, texture_handle);
+		// Callback textures may render to generate their texture, which is not part of any active recording.
+		recording_suspended += 1;
+		texture_handle = texture_database->callback_database.GetHandle(this, render_interface, texture.callback_index);
+		recording_suspended -= 1;
+	}
+
+	if (batch_geometry)
+	{
+		if (!pending_batch.empty() && pending_batch_texture != texture_handle)
+			FlushGeometryBatch();
+
+		if (pending_batch.empty())
+		{
+			pending_batch_translation = translation;
+			pending_batch_texture = texture_handle;
+		}
+
+		pending_batch.push_back(GeometryBatchEntry{geometry_index, geometry_list[geometry_index].generation, translation - pending_batch_translation});
+		return;
+	}
+
+	FlushGeometryBatch();
+
+	RMLUI_ZoneScopedNC("RenderGeometry", 0x3E60B2);
+	if (shader)
+		render_interface->RenderShader(shader, geometry_handle, translation, texture_handle);
+	else
+		render_interface->RenderGeometry(geometry_handle, translation, texture_handle);
+}
+
+void RenderManager::FlushGeometryBatch()
+{
+	if (pending_batch.empty())
+		return;
+
+	if (pending_batch.size() == 1)
+	{
+		if (CompiledGeometryHandle geometry_handle = GetCompiledGeometryHandle(pending_batch[0].geometry))
+		{
+			RMLUI_ZoneScopedNC("RenderGeometry", 0x3E60B2);
+			render_interface->RenderGeometry(geometry_handle, pending_batch_translation, pending_batch_texture);
+		}
+		pending_batch.clear();
+		return;
+	}
+
+	RMLUI_ZoneScopedNC("RenderGeometryBatch", 0x3E60B2);
+
+	size_t hash = 0;
+	Utilities::HashCombine(hash, pending_batch_texture);
+	for (const GeometryBatchEntry& entry : pending_batch)
+	{
+		Utilities::HashCombine(hash, static_cast<uint32_t>(entry.geometry));
+		Utilities::HashCombine(hash, entry.generation);
+		Utilities::HashCombine(hash, entry.offset.x);
+		Utilities::HashCombine(hash, entry.offset.y);
+	}
+
+	auto EntriesEqual = [](const Vector<GeometryBatchEntry>& a, const Vector<GeometryBatchEntry>& b) {
+		return std::equal(a.begin(), a.end(), b.begin(), b.end(), [](const GeometryBatchEntry& entry_a, const GeometryBatchEntry& entry_b) {
+			return entry_a.geometry == entry_b.geometry && entry_a.generation == entry_b.generation && entry_a.offset == entry_b.offset;
+		});
+	};
+
+	// Reuse the merged geometry from previous passes when possible, such that static content doesn't need to be recompiled every frame.
+	GeometryBatch& batch = geometry_batches[hash];
+	if (!batch.handle || batch.texture != pending_batch_texture || !EntriesEqual(batch.entries, pending_batch))
+	{
+		if (batch.handle)
+			render_interface->ReleaseGeometry(batch.handle);
+
+		Mesh mesh;
+		for (const GeometryBatchEntry& entry : pending_batch)
+		{
+			const Mesh& entry_mesh = geometry_list[entry.geometry].mesh;
+			const int index_offset = (int)mesh.vertices.size();
+
+			for (Vertex vertex : entry_mesh.vertices)
+			{
+				vertex.position += entry.offset;
+				mesh.vertices.push_back(vertex);
+			}
+			for (int index : entry_mesh.indices)
+				mesh.indices.push_back(index + index_offset);
+		}
+
+		RMLUI_ZoneScopedNC("CompileGeometry", 0x1E60D2);
+		batch.handle = render_interface->CompileGeometry(mesh.vertices, mesh.indices);
+		batch.entries = pending_batch;
+		batch.texture = pending_batch_texture;
+
+		if (!batch.handle)
+			Log::Message(Log::LT_ERROR, "Got empty compiled geometry.");
+	}
+
+	batch.last_used_pass = render_pass_count;
+	pending_batch.clear();
+
+	if (batch.handle)
+		render_interface->RenderGeometry(batch.handle, pending_batch_translation, pending_batch_texture);
+}
+
+void RenderManager::ReleaseGeometryBatches(bool release_all)
+{
+	// Keep batches around for a few passes after their last use, so that they can be reused by several contexts sharing this render manager.
+	constexpr uint32_t num_retained_passes = 4;
+
+	for (auto it = geometry_batches.begin(); it != geometry_batches.end();)
+	{
+		if (release_all || render_pass_count - it->second.last_used_pass > num_retained_passes)
+		{
+			if (it->second.handle)
+				render_interface->ReleaseGeometry(it->second.handle);
+			it = geometry_batches.erase(it);
+		}
 		else
-			render_interface->RenderGeometry(geometry_handle, translation, texture_handle);
+		{
+			++it;
+		}
 	}
 }
 
+void RenderManager::EnableGeometryBatching(bool enable)
+{
+	if (enable == enable_geometry_batching)
+		return;
+
+	FlushGeometryBatch();
+	enable_geometry_batching = enable;
+
+	if (!enable)
+		ReleaseGeometryBatches(true);
+}
+
+bool RenderManager::IsGeometryBatchingEnabled() const
+{
+	return enable_geometry_batching;
+}
+
+void RenderManager::BeginRecording(RenderCommandList& list)
+{
+	list.Clear();
+	list.layer_depth = render_stack.size();
+	list.validated_release_count = resource_release_count;
+	recording_stack.push_back(&list);
+}
+
+void RenderManager::EndRecording()
+{
+	RMLUI_ASSERT(!recording_stack.empty());
+	RenderCommandList* list = recording_stack.back();
+	recording_stack.pop_back();
+
+	list->valid = !list->discard;
+
+	if (RenderCommandList* parent = GetActiveRecording())
+	{
+		if (list->valid)
+		{
+			parent->commands.push_back({RenderCommandList::CommandType::Replay, (uint32_t)parent->sublists.size()});
+			parent->sublists.push_back(list);
+		}
+		else
+		{
+			parent->discard = true;
+		}
+	}
+}
+
+bool RenderManager::ReplayRecording(RenderCommandList& list)
+{
+	if (!list.valid || list.layer_depth != render_stack.size() || !ValidateRecordingResources(list))
+		return false;
+
+	RMLUI_ZoneScopedNC("ReplayRecording", 0x3E60B2);
+
+	RenderCommandList* parent = GetActiveRecording();
+
+	recording_suspended += 1;
+	ExecuteRecording(list);
+	recording_suspended -= 1;
+
+	if (parent)
+	{
+		parent->commands.push_back({RenderCommandList::CommandType::Replay, (uint32_t)parent->sublists.size()});
+		parent->sublists.push_back(&list);
+	}
+
+	return true;
+}
+
+RenderCommandList* RenderManager::GetActiveRecording()
+{
+	if (recording_stack.empty() || recording_suspended > 0)
+		return nullptr;
+	return recording_stack.back();
+}
+
+void RenderManager::DiscardActiveRecording()
+{
+	if (RenderCommandList* recording = GetActiveRecording())
+		recording->discard = true;
+}
+
+bool RenderManager::ValidateRecordingResources(RenderCommandList& list) const
+{
+	// Resources can only have been invalidated if any of them have been released since the last validation.
+	if (list.validated_release_count == resource_release_count)
+		return true;
+
+	for (const RenderCommandList::RenderGeometryCommand& command : list.render_commands)
+	{
+		const GeometryData* geometry = geometry_list.get_slot(command.geometry);
+		if (!geometry || geometry->generation != command.geometry_generation)
+			return false;
+		if (GetTextureGeneration(command.texture) != command.texture_generation)
+			return false;
+	}
+
+	for (RenderCommandList* sublist : list.sublists)
+	{
+		if (!ValidateRecordingResources(*sublist))
+			return false;
+	}
+
+	list.validated_release_count = resource_release_count;
+	return true;
+}
+
+void RenderManager::ExecuteRecording(const RenderCommandList& list)
+{
+	using CommandType = RenderCommandList::CommandType;
+
+	for (const RenderCommandList::Command& command : list.commands)
+	{
+		switch (command.type)
+		{
+		case CommandType::Render:
+		{
+			const RenderCommandList::RenderGeometryCommand& render = list.render_commands[command.index];
+			RenderGeometry(render.geometry, render.translation, render.texture, render.shader);
+		}
+		break;
+		case CommandType::SetScissorRegion: SetScissorRegion(list.scissor_regions[command.index]); break;
+		case CommandType::SetClipMask: SetClipMask(list.clip_masks[command.index]); break;
+		case CommandType::SetTransform:
+			SetTransform(command.index == RenderCommandList::NullTransform ? nullptr : &list.transforms[command.index]);
+			break;
+		case CommandType::PushLayer: PushLayer(); break;
+		case CommandType::CompositeLayers:
+		{
+			const RenderCommandList::CompositeLayersCommand& composite = list.composite_commands[command.index];
+			const LayerHandle source = (composite.source_layer < 0 ? LayerHandle{} : render_stack[composite.source_layer]);
+			const LayerHandle destination = (composite.destination_layer < 0 ? LayerHandle{} : render_stack[composite.destination_layer]);
+			CompositeLayers(source, destination, composite.blend_mode,
+				Span<const CompiledFilterHandle>(list.filters.data() + composite.filters_begin, composite.filters_count));
+		}
+		break;
+		case CommandType::PopLayer: PopLayer(); break;
+		case CommandType::Replay: ExecuteRecording(*list.sublists[command.index]); break;
+		}
+	}
+}
+
+int RenderManager::GetLayerIndex(LayerHandle layer) const
+{
+	auto it = std::find(render_stack.begin(), render_stack.end(), layer);
+	if (it == render_stack.end())
+		return -1;
+	return int(it - render_stack.begin());
+}
+
+uint32_t RenderManager::GetTextureGeneration(Texture texture) const
+{
+	if (texture.callback_index != StableVectorIndex::Invalid)
+		return texture_database->callback_database.GetGeneration(texture.callback_index);
+	return 0;
+}
+
 void RenderManager::GetTextureSourceList(StringList& source_list) const
 {
 	texture_database->file_database.GetSourceList(source_list);
@@ -277,17 +620,22 @@ const Mesh& RenderManager::GetMesh(const Geometry& geometry) const
 
 bool RenderManager::ReleaseTexture(const String& texture_source)
 {
+	FlushGeometryBatch();
 	return texture_database->file_database.ReleaseTexture(render_interface, texture_source);
 }
 
 void RenderManager::ReleaseAllTextures()
 {
+	FlushGeometryBatch();
 	texture_database->callback_database.ReleaseAllTextures(render_interface);
 	texture_database->file_database.ReleaseAllTextures(render_interface);
 }
 
 void RenderManager::ReleaseAllCompiledGeometry()
 {
+	pending_batch.clear();
+	ReleaseGeometryBatches(true);
+
 	geometry_list.for_each([this](GeometryData& data) {
 		if (data.handle)
 		{
@@ -321,6 +669,10 @@ CompiledShader RenderManager::CompileShader(const String& name, const Dictionary
 
 LayerHandle RenderManager::PushLayer()
 {
+	if (RenderCommandList* recording = GetActiveRecording())
+		recording->commands.push_back({RenderCommandList::CommandType::PushLayer, 0});
+
+	FlushGeometryBatch();
 	const LayerHandle layer = render_interface->PushLayer();
 	render_stack.push_back(layer);
 	return layer;
@@ -330,12 +682,27 @@ void RenderManager::CompositeLayers(LayerHandle source, LayerHandle destination,
 {
 	RMLUI_ASSERT(source == 0 || std::find(render_stack.begin(), render_stack.end(), source) != render_stack.end());
 	RMLUI_ASSERT(destination == 0 || std::find(render_stack.begin(), render_stack.end(), destination) != render_stack.end());
+
+	if (RenderCommandList* recording = GetActiveRecording())
+	{
+		recording->commands.push_back({RenderCommandList::CommandType::CompositeLayers, (uint32_t)recording->composite_commands.size()});
+		recording->composite_commands.push_back(RenderCommandList::CompositeLayersCommand{GetLayerIndex(source), GetLayerIndex(destination), blend_mode,
+			(uint32_t)recording->filters.size(), (uint32_t)filters.size()});
+		recording->filters.insert(recording->filters.end(), filters.begin(), filters.end());
+	}
+
+	FlushGeometryBatch();
 	render_interface->CompositeLayers(source, destination, blend_mode, filters);
 }
 
 void RenderManager::PopLayer()
 {
 	RMLUI_ASSERT(!render_stack.empty());
+
+	if (RenderCommandList* recording = GetActiveRecording())
+		recording->commands.push_back({RenderCommandList::CommandType::PopLayer, 0});
+
+	FlushGeometryBatch();
 	render_interface->PopLayer();
 	render_stack.pop_back();
 }
@@ -353,6 +720,10 @@ LayerHandle RenderManager::GetNextLayer() const
 
 CompiledFilter RenderManager::SaveLayerAsMaskImage()
 {
+	// The mask image is only valid for the current frame, thus any active recording cannot be replayed.
+	DiscardActiveRecording();
+	FlushGeometryBatch();
+
 	if (CompiledFilterHandle handle = render_interface->SaveLayerAsMaskImage())
 	{
 		compiled_filter_count += 1;
@@ -361,11 +732,33 @@ CompiledFilter RenderManager::SaveLayerAsMaskImage()
 	return CompiledFilter();
 }
 
+void RenderManager::RegenerateTexture(const CallbackTexture& texture)
+{
+	RMLUI_ASSERT(texture.render_manager == this && texture.resource_handle != texture.InvalidHandle());
+
+	// Pending geometry may refer to the current texture handle.
+	FlushGeometryBatch();
+	texture_database->callback_database.RegenerateTexture(render_interface, texture.resource_handle);
+}
+
+void RenderManager::UpdateTexture(const CallbackTexture& texture, Span<const byte> source, Rectanglei region)
+{
+	RMLUI_ASSERT(texture.render_manager == this && texture.resource_handle != texture.InvalidHandle());
+
+	// Pending geometry should be rendered with the texture contents at the time it was submitted.
+	FlushGeometryBatch();
+	texture_database->callback_database.UpdateTexture(render_interface, texture.resource_handle, source, region);
+	// Recordings rendered with the previous contents must be validated again.
+	resource_release_count += 1;
+}
+
 void RenderManager::ReleaseResource(const CallbackTexture& texture)
 {
 	RMLUI_ASSERT(texture.render_manager == this && texture.resource_handle != texture.InvalidHandle());
 
+	FlushGeometryBatch();
 	texture_database->callback_database.ReleaseTexture(render_interface, texture.resource_handle);
+	resource_release_count += 1;
 }
 
 Mesh RenderManager::ReleaseResource(const Geometry& geometry)
@@ -373,9 +766,11 @@ Mesh RenderManager::ReleaseResource(const Geometry& geometry)
 	RMLUI_ASSERT(geometry.render_manager == this && geometry.resource_handle != geometry.InvalidHandle());
 	RMLUI_ZoneScopedNC("ReleaseGeometry", 0x1E60D2);
 
+	FlushGeometryBatch();
 	GeometryData data = geometry_list.erase(geometry.resource_handle);
 	if (data.handle)
 		render_interface->ReleaseGeometry(data.handle);
+	resource_release_count += 1;
 	return std::move(data.mesh);
 }
 
@@ -39,7 +39,12 @@ Vector2i RenderManagerAccess::GetDimensions(RenderManager* render_manager, Textu
 
 Vector2i RenderManagerAccess::GetDimensions(RenderManager* render_manager, StableVectorIndex callback_texture)
 {
-	return render_manager->texture_database->callback_database.GetDimensions(render_manager, render_manager->render_interface, callback_texture);
+	// Callback textures may render to generate their texture, which is not part of any active recording.
+	render_manager->recording_suspended += 1;
+	const Vector2i dimensions =
+		render_manager->texture_database->callback_database.GetDimensions(render_manager, render_manager->render_interface, callback_texture);
+	render_manager->recording_suspended -= 1;
+	return dimensions;
 }
 
 void RenderManagerAccess::Render(RenderManager* render_manager, const Geometry& geometry, Vector2f translation, Texture texture,
@@ -48,6 +53,36 @@ void RenderManagerAccess::Render(RenderManager* render_manager, const Geometry&
 	render_manager->Render(geometry, translation, texture, shader);
 }
 
+void RenderManagerAccess::BeginRecording(RenderManager* render_manager, RenderCommandList& list)
+{
+	render_manager->BeginRecording(list);
+}
+
+void RenderManagerAccess::EndRecording(RenderManager* render_manager)
+{
+	render_manager->EndRecording();
+}
+
+bool RenderManagerAccess::ReplayRecording(RenderManager* render_manager, RenderCommandList& list)
+{
+	return render_manager->ReplayRecording(list);
+}
+
+void RenderManagerAccess::FlushGeometryBatch(RenderManager* render_manager)
+{
+	render_manager->FlushGeometryBatch();
+}
+
+void RenderManagerAccess::RegenerateTexture(RenderManager* render_manager, const CallbackTexture& texture)
+{
+	render_manager->RegenerateTexture(texture);
+}
+
+void RenderManagerAccess::UpdateTexture(RenderManager* render_manager, const CallbackTexture& texture, Span<const byte> source, Rectanglei region)
+{
+	render_manager->UpdateTexture(texture, source, region);
+}
+
 void RenderManagerAccess::GetTextureSourceList(RenderManager* render_manager, StringList& source_list)
 {
 	render_manager->GetTextureSourceList(source_list);
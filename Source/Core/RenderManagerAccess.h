@@ -40,6 +40,8 @@ class CompiledShader;
 class CallbackTexture;
 class Geometry;
 class Texture;
+class RenderCommandList;
+class Element;
 
 class RenderManagerAccess {
 private:
@@ -54,6 +56,14 @@ private:
 
 	static void Render(RenderManager* render_manager, const Geometry& geometry, Vector2f translation, Texture texture, const CompiledShader& shader);
 
+	static void BeginRecording(RenderManager* render_manager, RenderCommandList& list);
+	static void EndRecording(RenderManager* render_manager);
+	static bool ReplayRecording(RenderManager* render_manager, RenderCommandList& list);
+
+	static void FlushGeometryBatch(RenderManager* render_manager);
+	static void RegenerateTexture(RenderManager* render_manager, const CallbackTexture& texture);
+	static void UpdateTexture(RenderManager* render_manager, const CallbackTexture& texture, Span<const byte> source, Rectanglei region);
+
 	static void GetTextureSourceList(RenderManager* render_manager, StringList& source_list);
 	static const Mesh& GetMesh(RenderManager* render_manager, const Geometry& geometry);
 
@@ -64,8 +74,10 @@ private:
 	friend class CompiledFilter;
 	friend class CompiledShader;
 	friend class CallbackTexture;
+	friend class CallbackTextureInterface;
 	friend class Geometry;
 	friend class Texture;
+	friend class Element;
 
 	friend StringList Rml::GetTextureSourceList();
 	friend bool Rml::ReleaseTexture(const String&, RenderInterface*);
@@ -95,6 +95,7 @@ void StyleSheet::BuildNodeIndex()
 	RMLUI_ZoneScoped;
 	styled_node_index = {};
 	root->BuildIndex(styled_node_index);
+	root->BuildInvalidationIndex(styled_node_index);
 }
 
 const NamedDecorator* StyleSheet::GetNamedDecorator(const String& name) const
@@ -196,9 +197,16 @@ SharedPtr<const ElementDefinition> StyleSheet::GetElementDefinition(const Elemen
 
 	// Using static to avoid allocations. Make sure we don't call this function recursively.
 	static Vector<const StyleSheetNode*> applicable_nodes;
+	GetApplicableNodes(element, applicable_nodes);
+
+	return GetElementDefinition(applicable_nodes);
+}
+
+void StyleSheet::GetApplicableNodes(const Element* element, StyleSheetIndex::NodeList& applicable_nodes) const
+{
 	applicable_nodes.clear();
 
-	auto AddApplicableNodes = [element](const StyleSheetIndex::NodeIndex& node_index, const String& key) {
+	auto AddApplicableNodes = [element, &applicable_nodes](const StyleSheetIndex::NodeIndex& node_index, const String& key) {
 		auto it_nodes = node_index.find(Hash<String>()(key));
 		if (it_nodes != node_index.end())
 		{
@@ -222,7 +230,7 @@ SharedPtr<const ElementDefinition> StyleSheet::GetElementDefinition(const Elemen
 
 	// Text elements are never matched.
 	if (tag == "#text")
-		return nullptr;
+		return;
 
 	// First, look up the indexed requirements.
 	if (!id.empty())
@@ -240,10 +248,6 @@ SharedPtr<const ElementDefinition> StyleSheet::GetElementDefinition(const Elemen
 			applicable_nodes.push_back(node);
 	}
 
-	// If this element definition won't actually store any information, don't bother with it.
-	if (applicable_nodes.empty())
-		return nullptr;
-
 	// Sort the applicable nodes by specificity first, then by pointer value in case we have duplicate specificities.
 	std::sort(applicable_nodes.begin(), applicable_nodes.end(), [](const StyleSheetNode* a, const StyleSheetNode* b) {
 		const int a_specificity = a->GetSpecificity();
@@ -252,6 +256,13 @@ SharedPtr<const ElementDefinition> StyleSheet::GetElementDefinition(const Elemen
 			return a < b;
 		return a_specificity < b_specificity;
 	});
+}
+
+SharedPtr<const ElementDefinition> StyleSheet::GetElementDefinition(const StyleSheetIndex::NodeList& applicable_nodes) const
+{
+	// If this element definition won't actually store any information, don't bother with it.
+	if (applicable_nodes.empty())
+		return nullptr;
 
 	// Check if this puppy has already been cached in the node index.
 	SharedPtr<const ElementDefinition>& definition = node_cache[applicable_nodes];
@@ -264,4 +275,54 @@ SharedPtr<const ElementDefinition> StyleSheet::GetElementDefinition(const Elemen
 	return definition;
 }
 
+bool StyleSheet::IsElementDefinitionShareable(const Element* element) const
+{
+	if (styled_node_index.unshareable_other)
+		return false;
+
+	auto IsUnshareable = [](const UnorderedSet<size_t>& unshareable_keys, const String& key) {
+		return !unshareable_keys.empty() && unshareable_keys.count(Hash<String>()(key)) == 1;
+	};
+
+	const String& id = element->GetId();
+	if (!id.empty() && IsUnshareable(styled_node_index.unshareable_ids, id))
+		return false;
+
+	for (const String& name : element->GetStyle()->GetClassNameList())
+	{
+		if (IsUnshareable(styled_node_index.unshareable_classes, name))
+			return false;
+	}
+
+	return !IsUnshareable(styled_node_index.unshareable_tags, element->GetTagName());
+}
+
+static InvalidationScope GetInvalidationScope(const StyleSheetIndex::InvalidationIndex& index, const String& name)
+{
+	if (index.empty())
+		return InvalidationScope::None;
+	auto it = index.find(Hash<String>()(name));
+	return it == index.end() ? InvalidationScope::None : it->second;
+}
+
+InvalidationScope StyleSheet::GetIdInvalidationScope(const String& id) const
+{
+	return GetInvalidationScope(styled_node_index.invalidation_ids, id);
+}
+
+InvalidationScope StyleSheet::GetClassInvalidationScope(const String& class_name) const
+{
+	return GetInvalidationScope(styled_node_index.invalidation_classes, class_name);
+}
+
+InvalidationScope StyleSheet::GetPseudoClassInvalidationScope(const String& pseudo_class) const
+{
+	return GetInvalidationScope(styled_node_index.invalidation_pseudo_classes, pseudo_class);
+}
+
+InvalidationScope StyleSheet::GetAttributeInvalidationScope(const String& attribute) const
+{
+	return GetInvalidationScope(styled_node_index.invalidation_attributes, attribute);
+}
+
 } // namespace Rml
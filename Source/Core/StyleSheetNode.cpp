@@ -50,11 +50,13 @@ StyleSheetNode::StyleSheetNode()
 StyleSheetNode::StyleSheetNode(StyleSheetNode* parent, const CompoundSelector& selector) : parent(parent), selector(selector)
 {
 	CalculateAndSetSpecificity();
+	CalculateAndSetAncestorRequirements();
 }
 
 StyleSheetNode::StyleSheetNode(StyleSheetNode* parent, CompoundSelector&& selector) : parent(parent), selector(std::move(selector))
 {
 	CalculateAndSetSpecificity();
+	CalculateAndSetAncestorRequirements();
 }
 
 StyleSheetNode* StyleSheetNode::GetOrCreateChildNode(const CompoundSelector& other)
@@ -129,32 +131,38 @@ void StyleSheetNode::BuildIndex(StyleSheetIndex& styled_node_index) const
 	// If this has properties defined, then we insert it into the styled node index.
 	if (properties.GetNumProperties() > 0)
 	{
-		auto IndexInsertNode = [](StyleSheetIndex::NodeIndex& node_index, const String& key, const StyleSheetNode* node) {
-			StyleSheetIndex::NodeList& nodes = node_index[Hash<String>()(key)];
+		auto IndexInsertNode = [](StyleSheetIndex::NodeIndex& node_index, UnorderedSet<size_t>& unshareable_keys, const String& key,
+								   const StyleSheetNode* node) {
+			const size_t key_hash = Hash<String>()(key);
+			StyleSheetIndex::NodeList& nodes = node_index[key_hash];
 			auto it = std::find(nodes.begin(), nodes.end(), node);
 			if (it == nodes.end())
 				nodes.push_back(node);
+			if (node->IsSiblingOrAttributeDependent())
+				unshareable_keys.insert(key_hash);
 		};
 
 		// Add this node to the appropriate index for looking up applicable nodes later. Prioritize the most unique requirement first and the most
 		// general requirement last. This way we are able to rule out as many nodes as possible as quickly as possible.
 		if (!selector.id.empty())
 		{
-			IndexInsertNode(styled_node_index.ids, selector.id, this);
+			IndexInsertNode(styled_node_index.ids, styled_node_index.unshareable_ids, selector.id, this);
 		}
 		else if (!selector.class_names.empty())
 		{
 			// @performance Right now we just use the first class for simplicity. Later we may want to devise a better strategy to try to add the
 			// class with the most unique name. For example by adding the class from this node's list that has the fewest existing matches.
-			IndexInsertNode(styled_node_index.classes, selector.class_names.front(), this);
+			IndexInsertNode(styled_node_index.classes, styled_node_index.unshareable_classes, selector.class_names.front(), this);
 		}
 		else if (!selector.tag.empty())
 		{
-			IndexInsertNode(styled_node_index.tags, selector.tag, this);
+			IndexInsertNode(styled_node_index.tags, styled_node_index.unshareable_tags, selector.tag, this);
 		}
 		else
 		{
 			styled_node_index.other.push_back(this);
+			if (IsSiblingOrAttributeDependent())
+				styled_node_index.unshareable_other = true;
 		}
 	}
 
@@ -162,6 +170,72 @@ void StyleSheetNode::BuildIndex(StyleSheetIndex& styled_node_index) const
 		child->BuildIndex(styled_node_index);
 }
 
+InvalidationScope StyleSheetNode::BuildInvalidationIndex(StyleSheetIndex& styled_node_index) const
+{
+	// Determine which elements may change their definition depending on whether an element matches this node, relative to that element.
+	InvalidationScope scope = (properties.GetNumProperties() > 0 ? InvalidationScope::Self : InvalidationScope::None);
+
+	for (const auto& child : children)
+	{
+		const InvalidationScope child_scope = child->BuildInvalidationIndex(styled_node_index);
+		if (child_scope == InvalidationScope::None)
+			continue;
+
+		switch (child->selector.combinator)
+		{
+		case SelectorCombinator::Descendant: scope = scope | InvalidationScope::Descendants; break;
+		case SelectorCombinator::Child:
+		{
+			// The child node is matched against children of the element. The sibling scope also covers the siblings' descendants, thus
+			// anything beyond the children themselves is a descendant.
+			if ((child_scope & InvalidationScope::Self) != InvalidationScope::None)
+				scope = scope | InvalidationScope::Children;
+			if ((child_scope & (InvalidationScope::Children | InvalidationScope::Descendants | InvalidationScope::Siblings)) != InvalidationScope::None)
+				scope = scope | InvalidationScope::Descendants;
+		}
+		break;
+		case SelectorCombinator::NextSibling:
+		case SelectorCombinator::SubsequentSibling: scope = scope | InvalidationScope::Siblings; break;
+		}
+	}
+
+	if (scope != InvalidationScope::None)
+		InsertInvalidationNames(styled_node_index, scope, false);
+
+	return scope;
+}
+
+void StyleSheetNode::InsertInvalidationNames(StyleSheetIndex& styled_node_index, InvalidationScope scope, bool recursive) const
+{
+	auto IndexInsertName = [scope](StyleSheetIndex::InvalidationIndex& index, const String& name) {
+		InvalidationScope& index_scope = index[Hash<String>()(name)];
+		index_scope = index_scope | scope;
+	};
+
+	if (!selector.id.empty())
+		IndexInsertName(styled_node_index.invalidation_ids, selector.id);
+	for (const String& name : selector.class_names)
+		IndexInsertName(styled_node_index.invalidation_classes, name);
+	for (const String& name : selector.pseudo_class_names)
+		IndexInsertName(styled_node_index.invalidation_pseudo_classes, name);
+	for (const AttributeSelector& attribute : selector.attributes)
+		IndexInsertName(styled_node_index.invalidation_attributes, attribute.name);
+
+	// Selectors such as :not() may match their inner selectors against any element related to this one, thus be conservative about them.
+	const InvalidationScope inner_scope = (InvalidationScope::Self | InvalidationScope::Descendants | InvalidationScope::Siblings);
+	for (const StructuralSelector& structural_selector : selector.structural_selectors)
+	{
+		if (structural_selector.selector_tree)
+			structural_selector.selector_tree->root->InsertInvalidationNames(styled_node_index, inner_scope, true);
+	}
+
+	if (recursive)
+	{
+		for (const auto& child : children)
+			child->InsertInvalidationNames(styled_node_index, scope, true);
+	}
+}
+
 int StyleSheetNode::GetSpecificity() const
 {
 	return specificity;
@@ -172,6 +246,12 @@ void StyleSheetNode::ImportProperties(const PropertyDictionary& _properties, int
 	properties.Import(_properties, specificity + rule_specificity);
 }
 
+bool StyleSheetNode::IsSiblingOrAttributeDependent() const
+{
+	return !selector.attributes.empty() || !selector.structural_selectors.empty() || selector.combinator == SelectorCombinator::NextSibling ||
+		selector.combinator == SelectorCombinator::SubsequentSibling;
+}
+
 const PropertyDictionary& StyleSheetNode::GetProperties() const
 {
 	return properties;
@@ -383,6 +463,10 @@ bool StyleSheetNode::IsApplicable(const Element* element, const Element* scope)
 	if (!selector.attributes.empty() && !MatchAttributes(element))
 		return false;
 
+	// Rule out any elements which are definitely missing some of the ancestors required by our parent nodes.
+	if (!ancestor_requirements.IsEmpty() && !AncestorFilter::Get(element).MayContain(ancestor_requirements))
+		return false;
+
 	// Check the structural selector requirements last as they can be quite slow.
 	if (!selector.structural_selectors.empty() && !MatchStructuralSelector(element, scope))
 		return false;
@@ -417,4 +501,25 @@ void StyleSheetNode::CalculateAndSetSpecificity()
 		specificity += parent->specificity;
 }
 
+void StyleSheetNode::CalculateAndSetAncestorRequirements()
+{
+	if (!parent || !parent->parent)
+		return;
+
+	// The element matched by our parent node shares all of its ancestors with the element matched by this node. Further, with a descendant or
+	// child combinator the parent's element is itself an ancestor, while with sibling combinators it is not.
+	ancestor_requirements = parent->ancestor_requirements;
+
+	if (selector.combinator == SelectorCombinator::Descendant || selector.combinator == SelectorCombinator::Child)
+	{
+		const CompoundSelector& parent_selector = parent->selector;
+		if (!parent_selector.tag.empty())
+			ancestor_requirements.Add(parent_selector.tag);
+		if (!parent_selector.id.empty())
+			ancestor_requirements.Add(parent_selector.id);
+		for (const String& class_name : parent_selector.class_names)
+			ancestor_requirements.Add(class_name);
+	}
+}
+
 } // namespace Rml
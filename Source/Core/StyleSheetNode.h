@@ -30,12 +30,13 @@
 #define RMLUI_CORE_STYLESHEETNODE_H
 
 #include "../../Include/RmlUi/Core/PropertyDictionary.h"
+#include "../../Include/RmlUi/Core/StyleSheetTypes.h"
 #include "../../Include/RmlUi/Core/Types.h"
+#include "AncestorFilter.h"
 #include "StyleSheetSelector.h"
 
 namespace Rml {
 
-struct StyleSheetIndex;
 class StyleSheetNode;
 using StyleSheetNodeList = Vector<UniquePtr<StyleSheetNode>>;
 
@@ -62,6 +63,9 @@ public:
 	UniquePtr<StyleSheetNode> DeepCopy(StyleSheetNode* parent = nullptr) const;
 	/// Builds up a style sheet's index recursively.
 	void BuildIndex(StyleSheetIndex& styled_node_index) const;
+	/// Builds up the invalidation sets of a style sheet's index recursively.
+	/// @return The elements whose definition may change depending on whether an element matches this node, relative to that element.
+	InvalidationScope BuildInvalidationIndex(StyleSheetIndex& styled_node_index) const;
 
 	/// Imports properties from a single rule definition into the node's properties and sets the appropriate specificity on them. Any existing
 	/// attributes sharing a key with a new attribute will be overwritten if they are of a lower specificity.
@@ -79,8 +83,16 @@ public:
 	/// Returns the specificity of this node.
 	int GetSpecificity() const;
 
+	/// Returns true if this node can only match an element based on its attributes or siblings, in addition to its tag, id, classes, pseudo
+	/// classes, and ancestors.
+	bool IsSiblingOrAttributeDependent() const;
+
 private:
 	void CalculateAndSetSpecificity();
+	void CalculateAndSetAncestorRequirements();
+
+	// Add the names used by this node, and optionally its descendant nodes, to the invalidation index using the given scope.
+	void InsertInvalidationNames(StyleSheetIndex& styled_node_index, InvalidationScope scope, bool recursive) const;
 
 	// Match an element to the local node requirements.
 	inline bool Match(const Element* element, const Element* scope) const;
@@ -99,6 +111,9 @@ private:
 	// A measure of specificity of this node; the attribute in a node with a higher value will override those of a node with a lower value.
 	int specificity = 0;
 
+	// The names of all ancestors required by this node and its parent nodes, used to reject elements before walking their hierarchy.
+	AncestorFilter ancestor_requirements;
+
 	PropertyDictionary properties;
 
 	StyleSheetNodeList children;
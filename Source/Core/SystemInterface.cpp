@@ -115,4 +115,10 @@ void SystemInterface::ActivateKeyboard(Rml::Vector2f /*caret_position*/, float /
 
 void SystemInterface::DeactivateKeyboard() {}
 
+void SystemInterface::ExecuteParallel(int count, const Function<void(int)>& task)
+{
+	for (int i = 0; i < count; i++)
+		task(i);
+}
+
 } // namespace Rml
@@ -0,0 +1,59 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "TextGeometry.h"
+#include "../../Include/RmlUi/Core/Core.h"
+#include "../../Include/RmlUi/Core/FontEngineInterface.h"
+
+#ifdef RMLUI_FONT_ENGINE_FREETYPE
+	#include "FontEngineDefault/FontEngineInterfaceDefault.h"
+#endif
+
+namespace Rml {
+
+int TextGeometry::GenerateString(RenderManager& render_manager, FontFaceHandle face_handle, FontEffectsHandle effects_handle, StringView string,
+	Vector2f position, ColourbPremultiplied colour, float opacity, const TextShapingContext& text_shaping_context, TexturedMeshList& mesh_list,
+	Vector<const CompiledShader*>& mesh_shaders, Vector<SharedPtr<const void>>& glyph_pins)
+{
+	FontEngineInterface* font_engine_interface = GetFontEngineInterface();
+
+#ifdef RMLUI_FONT_ENGINE_FREETYPE
+	FontEngineInterfaceDefault* default_font_engine = FontEngineInterfaceDefault::GetActive();
+	if (default_font_engine && default_font_engine == font_engine_interface)
+		return default_font_engine->GenerateString(render_manager, face_handle, effects_handle, string, position, colour, opacity,
+			text_shaping_context, mesh_list, mesh_shaders, glyph_pins);
+#endif
+
+	const int width = font_engine_interface->GenerateString(render_manager, face_handle, effects_handle, string, position, colour, opacity,
+		text_shaping_context, mesh_list);
+	mesh_shaders.assign(mesh_list.size(), nullptr);
+	glyph_pins.clear();
+	return width;
+}
+
+} // namespace Rml
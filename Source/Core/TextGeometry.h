@@ -0,0 +1,62 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef RMLUI_CORE_TEXTGEOMETRY_H
+#define RMLUI_CORE_TEXTGEOMETRY_H
+
+#include "../../Include/RmlUi/Core/Mesh.h"
+#include "../../Include/RmlUi/Core/TextShapingContext.h"
+#include "../../Include/RmlUi/Core/Types.h"
+
+namespace Rml {
+
+class CompiledShader;
+class RenderManager;
+
+/**
+    Generates text geometry along with the resources of the default font engine needed to render it.
+
+    The default font engine renders glyphs from distance fields with its own internal shaders, and may evict glyphs from its atlas unless they
+    are pinned. Neither are part of the generated meshes, and are instead retrieved here for the text elements and decorators. Other font
+    engines never use any shaders or pins.
+ */
+namespace TextGeometry {
+
+	/// Generates the geometry of a single line of text through the font engine in use, see FontEngineInterface::GenerateString().
+	/// @param[out] mesh_list The generated meshes.
+	/// @param[out] mesh_shaders The shader to render each of the meshes with, or nullptr for meshes rendered without one.
+	/// @param[out] glyph_pins Protects the glyphs used by the meshes from being evicted, must be held for as long as the meshes may be rendered.
+	/// @return The width, in pixels, of the string geometry.
+	int GenerateString(RenderManager& render_manager, FontFaceHandle face_handle, FontEffectsHandle effects_handle, StringView string,
+		Vector2f position, ColourbPremultiplied colour, float opacity, const TextShapingContext& text_shaping_context, TexturedMeshList& mesh_list,
+		Vector<const CompiledShader*>& mesh_shaders, Vector<SharedPtr<const void>>& glyph_pins);
+
+} // namespace TextGeometry
+
+} // namespace Rml
+#endif
@@ -0,0 +1,132 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "TextWidthCache.h"
+#include "../../Include/RmlUi/Core/FontEngineInterface.h"
+#include "../../Include/RmlUi/Core/Utilities.h"
+#include "ControlledLifetimeResource.h"
+
+namespace Rml {
+
+// The maximum number of entries kept for each font face handle.
+static constexpr size_t max_entries_per_handle = 2048;
+
+namespace {
+	struct Entry {
+		size_t hash;
+		String string;
+		String language;
+		Style::Direction text_direction;
+		float letter_spacing;
+		Character prior_character;
+		int width;
+	};
+
+	// Entries are ordered by their most recent use, with the most recently used entry at the front.
+	struct HandleEntries {
+		// The version of the font face handle the widths were measured with.
+		int version = 0;
+		List<Entry> entries;
+		UnorderedMap<size_t, List<Entry>::iterator> index;
+	};
+} // namespace
+
+struct TextWidthCacheData {
+	UnorderedMap<FontFaceHandle, HandleEntries> handles;
+};
+
+static ControlledLifetimeResource<TextWidthCacheData> text_width_cache_data;
+
+void TextWidthCache::Initialize()
+{
+	text_width_cache_data.Initialize();
+}
+
+void TextWidthCache::Shutdown()
+{
+	text_width_cache_data.Shutdown();
+}
+
+int TextWidthCache::GetStringWidth(FontEngineInterface* font_engine_interface, FontFaceHandle handle, const String& string,
+	const TextShapingContext& text_shaping_context, Character prior_character)
+{
+	size_t hash = Hash<String>()(string);
+	Utilities::HashCombine(hash, text_shaping_context.language);
+	Utilities::HashCombine(hash, (int)text_shaping_context.text_direction);
+	Utilities::HashCombine(hash, text_shaping_context.letter_spacing);
+	Utilities::HashCombine(hash, prior_character);
+
+	HandleEntries& handle_entries = text_width_cache_data->handles[handle];
+
+	// The font engine may change the metrics of the handle, such as when adding fallback fonts, thereby invalidating all its widths.
+	const int version = font_engine_interface->GetVersion(handle);
+	if (version != handle_entries.version)
+	{
+		handle_entries.entries.clear();
+		handle_entries.index.clear();
+		handle_entries.version = version;
+	}
+
+	auto it_index = handle_entries.index.find(hash);
+	if (it_index != handle_entries.index.end())
+	{
+		List<Entry>::iterator it_entry = it_index->second;
+		const Entry& entry = *it_entry;
+		if (entry.string == string && entry.language == text_shaping_context.language && entry.text_direction == text_shaping_context.text_direction &&
+			entry.letter_spacing == text_shaping_context.letter_spacing && entry.prior_character == prior_character)
+		{
+			handle_entries.entries.splice(handle_entries.entries.begin(), handle_entries.entries, it_entry);
+			return entry.width;
+		}
+
+		// Hash collision, replace the existing entry.
+		handle_entries.entries.erase(it_entry);
+		handle_entries.index.erase(it_index);
+	}
+
+	const int width = font_engine_interface->GetStringWidth(handle, string, text_shaping_context, prior_character);
+
+	if (handle_entries.entries.size() >= max_entries_per_handle)
+	{
+		handle_entries.index.erase(handle_entries.entries.back().hash);
+		handle_entries.entries.pop_back();
+	}
+
+	handle_entries.entries.push_front(Entry{hash, string, text_shaping_context.language, text_shaping_context.text_direction,
+		text_shaping_context.letter_spacing, prior_character, width});
+	handle_entries.index[hash] = handle_entries.entries.begin();
+
+	return width;
+}
+
+void TextWidthCache::Clear()
+{
+	text_width_cache_data->handles.clear();
+}
+
+} // namespace Rml
@@ -0,0 +1,66 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef RMLUI_CORE_TEXTWIDTHCACHE_H
+#define RMLUI_CORE_TEXTWIDTHCACHE_H
+
+#include "../../Include/RmlUi/Core/TextShapingContext.h"
+#include "../../Include/RmlUi/Core/Types.h"
+
+namespace Rml {
+
+class FontEngineInterface;
+
+/**
+    A cache of measured string widths, used to avoid measuring the same words again whenever text is reformatted.
+
+    Each font face handle keeps its own set of entries, evicting the least recently used entries when it grows beyond its capacity. The
+    entries are keyed by the string and all the parameters affecting its width, and must be cleared whenever font face handles are released.
+    The entries of a handle are discarded whenever the font engine reports a new version of it.
+ */
+namespace TextWidthCache {
+
+	void Initialize();
+	void Shutdown();
+
+	/// Returns the width of the string, as measured by the font engine with the given parameters.
+	/// @param[in] font_engine_interface The font engine to measure the string with on cache misses.
+	/// @param[in] handle The font face to measure the string in.
+	/// @param[in] string The string to measure.
+	/// @param[in] text_shaping_context Extra parameters that provide context for text shaping.
+	/// @param[in] prior_character The optionally-specified character that immediately precedes the string, used for kerning.
+	int GetStringWidth(FontEngineInterface* font_engine_interface, FontFaceHandle handle, const String& string,
+		const TextShapingContext& text_shaping_context, Character prior_character);
+
+	/// Removes all cached widths.
+	void Clear();
+
+} // namespace TextWidthCache
+
+} // namespace Rml
+#endif
@@ -50,7 +50,8 @@ CallbackTextureDatabase::~CallbackTextureDatabase()
 StableVectorIndex CallbackTextureDatabase::CreateTexture(CallbackTextureFunction&& callback)
 {
 	RMLUI_ASSERT(callback);
-	return texture_list.insert(CallbackTextureEntry{std::move(callback), TextureHandle(), Vector2i()});
+	generation_counter += 1;
+	return texture_list.insert(CallbackTextureEntry{std::move(callback), TextureHandle(), Vector2i(), false, generation_counter});
 }
 
 void CallbackTextureDatabase::ReleaseTexture(RenderInterface* render_interface, StableVectorIndex callback_index)
@@ -61,6 +62,37 @@ void CallbackTextureDatabase::ReleaseTexture(RenderInterface* render_interface,
 	texture_list.erase(callback_index);
 }
 
+void CallbackTextureDatabase::RegenerateTexture(RenderInterface* render_interface, StableVectorIndex callback_index)
+{
+	CallbackTextureEntry& data = texture_list[callback_index];
+	if (data.texture_handle)
+		render_interface->ReleaseTexture(data.texture_handle);
+	data.texture_handle = {};
+	data.dimensions = {};
+	data.load_failed = false;
+}
+
+void CallbackTextureDatabase::UpdateTexture(RenderInterface* render_interface, StableVectorIndex callback_index, Span<const byte> source,
+	Rectanglei region)
+{
+	CallbackTextureEntry& data = texture_list[callback_index];
+
+	// Anything rendered with the previous contents may no longer look the same, such as glyphs evicted from an atlas, thus treat the updated
+	// texture as a new one.
+	generation_counter += 1;
+	data.generation = generation_counter;
+
+	// Textures not yet generated will get the new contents once they are generated.
+	if (!data.texture_handle)
+		return;
+
+	RMLUI_ASSERT(source.size() == size_t(region.Width() * region.Height() * 4));
+	RMLUI_ASSERT(region.Left() >= 0 && region.Top() >= 0 && region.Right() <= data.dimensions.x && region.Bottom() <= data.dimensions.y);
+
+	if (!render_interface->UpdateTexture(data.texture_handle, source, region))
+		RegenerateTexture(render_interface, callback_index);
+}
+
 Vector2i CallbackTextureDatabase::GetDimensions(RenderManager* render_manager, RenderInterface* render_interface, StableVectorIndex callback_index)
 {
 	return EnsureLoaded(render_manager, render_interface, callback_index).dimensions;
@@ -87,6 +119,12 @@ auto CallbackTextureDatabase::EnsureLoaded(RenderManager* render_manager, Render
 	return data;
 }
 
+uint32_t CallbackTextureDatabase::GetGeneration(StableVectorIndex callback_index) const
+{
+	const CallbackTextureEntry* data = texture_list.get_slot(callback_index);
+	return data ? data->generation : 0;
+}
+
 size_t CallbackTextureDatabase::size() const
 {
 	return texture_list.size();
@@ -44,10 +44,18 @@ public:
 
 	StableVectorIndex CreateTexture(CallbackTextureFunction&& callback);
 	void ReleaseTexture(RenderInterface* render_interface, StableVectorIndex callback_index);
+	// Releases the generated texture while keeping the entry, so that it is generated again from its callback the next time it is used.
+	void RegenerateTexture(RenderInterface* render_interface, StableVectorIndex callback_index);
+	// Updates a region of the generated texture, or regenerates it if the render interface does not support partial updates. The texture is
+	// given a new generation.
+	void UpdateTexture(RenderInterface* render_interface, StableVectorIndex callback_index, Span<const byte> source, Rectanglei region);
 
 	Vector2i GetDimensions(RenderManager* render_manager, RenderInterface* render_interface, StableVectorIndex callback_index);
 	TextureHandle GetHandle(RenderManager* render_manager, RenderInterface* render_interface, StableVectorIndex callback_index);
 
+	// Returns a number uniquely identifying the texture at the given index, or zero if the index is not in use.
+	uint32_t GetGeneration(StableVectorIndex callback_index) const;
+
 	size_t size() const;
 
 	void ReleaseAllTextures(RenderInterface* render_interface);
@@ -58,11 +66,13 @@ private:
 		TextureHandle texture_handle = {};
 		Vector2i dimensions;
 		bool load_failed = false;
+		uint32_t generation = 0;
 	};
 
 	CallbackTextureEntry& EnsureLoaded(RenderManager* render_manager, RenderInterface* render_interface, StableVectorIndex callback_index);
 
 	StableVector<CallbackTextureEntry> texture_list;
+	uint32_t generation_counter = 0;
 };
 
 class FileTextureDatabase : NonCopyMoveable {
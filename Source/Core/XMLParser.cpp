@@ -126,8 +126,10 @@ const XMLParser::ParseFrame* XMLParser::GetParseFrame() const
 
 const URL& XMLParser::GetSourceURL() const
 {
-	RMLUI_ASSERT(GetSourceURLPtr());
-	return *GetSourceURLPtr();
+	// Handlers may be called without parsing a stream, such as when instancing a recording, in which case there is no source.
+	static const URL empty_url;
+	const URL* source_url = GetSourceURLPtr();
+	return source_url ? *source_url : empty_url;
 }
 
 void XMLParser::HandleElementStart(const String& _name, const XMLAttributes& attributes)
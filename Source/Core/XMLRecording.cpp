@@ -0,0 +1,156 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "XMLRecording.h"
+#include "../../Include/RmlUi/Core/Core.h"
+#include "../../Include/RmlUi/Core/Factory.h"
+#include "../../Include/RmlUi/Core/Profiling.h"
+#include "../../Include/RmlUi/Core/StreamMemory.h"
+#include "../../Include/RmlUi/Core/StringUtilities.h"
+#include "../../Include/RmlUi/Core/SystemInterface.h"
+#include "../../Include/RmlUi/Core/XMLParser.h"
+#include "XMLParseTools.h"
+#include <algorithm>
+
+namespace Rml {
+
+class XMLRecording::Recorder : public BaseXMLParser {
+public:
+	Recorder(Vector<ParseEvent>& events) : events(events)
+	{
+		// Must match the configuration of the XMLParser.
+		RegisterCDATATag("script");
+		RegisterCDATATag("style");
+
+		for (const String& name : Factory::GetStructuralDataViewAttributeNames())
+			RegisterInnerXMLAttribute(name);
+	}
+
+	void HandleElementStart(const String& name, const XMLAttributes& attributes) override
+	{
+		events.push_back(ParseEvent{EventType::ElementStart, name, attributes, XMLDataType::Text});
+	}
+	void HandleElementEnd(const String& name) override { events.push_back(ParseEvent{EventType::ElementEnd, name, {}, XMLDataType::Text}); }
+	void HandleData(const String& data, XMLDataType type) override { events.push_back(ParseEvent{EventType::Data, data, {}, type}); }
+
+private:
+	Vector<ParseEvent>& events;
+};
+
+static String TranslateRml(const String& rml)
+{
+	String text;
+	if (SystemInterface* system_interface = GetSystemInterface())
+		system_interface->TranslateString(text, rml);
+	else
+		text = rml;
+	return text;
+}
+
+XMLRecording::XMLRecording(const String& in_rml, const String& documents_base_tag) : rml(in_rml), documents_base_tag(documents_base_tag)
+{
+	Record(TranslateRml(rml));
+}
+
+XMLRecording::~XMLRecording() {}
+
+void XMLRecording::Record(String text)
+{
+	RMLUI_ZoneScoped;
+
+	translated_rml = std::move(text);
+	events.clear();
+	is_recorded = false;
+
+	// Only RML markup is recorded, plain text and data expressions are instanced as usual. See Factory::InstanceElementText().
+	if (std::all_of(translated_rml.begin(), translated_rml.end(), &StringUtilities::IsWhitespace))
+		return;
+
+	bool parse_as_rml = false;
+	bool inside_brackets = false;
+	bool inside_string = false;
+	char previous = 0;
+	for (const char c : translated_rml)
+	{
+		if (XMLParseTools::ParseDataBrackets(inside_brackets, inside_string, c, previous))
+			return;
+
+		if (!inside_brackets && c == '<')
+			parse_as_rml = true;
+
+		previous = c;
+	}
+
+	if (!parse_as_rml)
+		return;
+
+	const String open_tag = "<" + documents_base_tag + ">";
+	const String close_tag = "</" + documents_base_tag + ">";
+	StreamMemory stream(translated_rml.size() + open_tag.size() + close_tag.size());
+	stream.Write(open_tag);
+	stream.Write(translated_rml);
+	stream.Write(close_tag);
+	stream.Seek(0, SEEK_SET);
+
+	Recorder recorder(events);
+	recorder.Parse(&stream);
+	is_recorded = true;
+}
+
+void XMLRecording::Instance(Element* parent)
+{
+	RMLUI_ZoneScoped;
+
+	// The translations may have changed since the RML was recorded, in which case the recording is outdated.
+	String text = TranslateRml(rml);
+	if (text != translated_rml)
+		Record(std::move(text));
+
+	if (!is_recorded)
+	{
+		Factory::InstanceElementText(parent, rml);
+		return;
+	}
+
+	// Like with Element::SetInnerRML(), the instanced elements have no source URL.
+	XMLParser parser(parent);
+
+	// The handlers are protected in the XMLParser, but public in its base class.
+	BaseXMLParser& handler = parser;
+	for (const ParseEvent& event : events)
+	{
+		switch (event.type)
+		{
+		case EventType::ElementStart: handler.HandleElementStart(event.value, event.attributes); break;
+		case EventType::ElementEnd: handler.HandleElementEnd(event.value); break;
+		case EventType::Data: handler.HandleData(event.value, event.data_type); break;
+		}
+	}
+}
+
+} // namespace Rml
@@ -26,49 +26,51 @@
  *
  */
 
-#ifndef TEXTURELAYOUTTEXTURE_H
-#define TEXTURELAYOUTTEXTURE_H
+#ifndef RMLUI_CORE_XMLRECORDING_H
+#define RMLUI_CORE_XMLRECORDING_H
 
-#include "../../Include/RmlUi/Core/Texture.h"
-#include "TextureLayoutRow.h"
+#include "../../Include/RmlUi/Core/BaseXMLParser.h"
+#include "../../Include/RmlUi/Core/Traits.h"
+#include "../../Include/RmlUi/Core/Types.h"
 
 namespace Rml {
 
-class TextureLayout;
+class Element;
 
 /**
-    A texture layout texture is a single rectangular area which sub-rectangles are placed on within
-    a complete texture layout.
-
-    @author Peter
+    Parses an RML string once, so that it can be instanced repeatedly as the inner RML of different elements without
+    re-parsing it. Instancing a recording is equivalent to calling Element::SetInnerRML() with the same string on an
+    empty element. The string is recorded again whenever its translation changes.
  */
 
-class TextureLayoutTexture {
+class XMLRecording : NonCopyMoveable {
 public:
-	TextureLayoutTexture();
-	~TextureLayoutTexture();
+	/// Records the parse of the given RML, as instanced into a context using the given documents base tag.
+	XMLRecording(const String& rml, const String& documents_base_tag);
+	~XMLRecording();
 
-	/// Returns the texture's dimensions. This is only valid after the texture has been generated.
-	/// @return The texture's dimensions.
-	Vector2i GetDimensions() const;
+	/// Instances the recorded RML as children of the given parent.
+	void Instance(Element* parent);
 
-	/// Attempts to position unplaced rectangles from the layout into this texture. The size of
-	/// this texture will be determined by its contents.
-	/// @param[in] layout The layout to position rectangles from.
-	/// @param[in] maximum_dimensions The maximum dimensions of this texture. If this is not big enough to place all the rectangles, then as many will
-	/// be placed as possible.
-	/// @return The number of placed rectangles.
-	int Generate(TextureLayout& layout, int maximum_dimensions);
+private:
+	class Recorder;
 
-	/// Allocates the texture.
-	/// @return The allocated texture data.
-	Vector<byte> AllocateTexture();
+	// Records the parse of the given translated RML.
+	void Record(String text);
 
-private:
-	using RowList = Vector<TextureLayoutRow>;
+	enum class EventType { ElementStart, ElementEnd, Data };
+	struct ParseEvent {
+		EventType type;
+		String value; // Tag name or data.
+		XMLAttributes attributes;
+		XMLDataType data_type;
+	};
 
-	Vector2i dimensions;
-	RowList rows;
+	String rml;
+	String documents_base_tag;
+	String translated_rml;
+	bool is_recorded = false;
+	Vector<ParseEvent> events;
 };
 
 } // namespace Rml
@@ -46,6 +46,12 @@ void ElementContextHook::Initialise(DebuggerPlugin* _debugger)
 	debugger = _debugger;
 }
 
+void ElementContextHook::OnUpdate()
+{
+	// The debugging overlays are generated while rendering, so they must never be replayed from retained render commands.
+	DirtyRender();
+}
+
 void ElementContextHook::OnRender()
 {
 	// Make sure we're in the front of the render queue for this context (at least next frame).
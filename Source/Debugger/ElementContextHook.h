@@ -52,6 +52,7 @@ public:
 
 	void Initialise(DebuggerPlugin* debugger);
 
+	void OnUpdate() override;
 	void OnRender() override;
 
 private:
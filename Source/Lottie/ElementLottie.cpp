@@ -74,6 +74,9 @@ void ElementLottie::OnUpdate()
 	if (time_animation_start < 0.0)
 		time_animation_start = t;
 
+	// The animation frame is advanced during rendering, so any retained render commands must be regenerated.
+	DirtyRender();
+
 	double _unused;
 	const double frame_duration = 1.0 / animation->frameRate();
 	const double delay = std::modf((t - time_animation_start) / frame_duration, &_unused) * frame_duration;
@@ -31,6 +31,8 @@
 #include <RmlUi/Core/DataModelHandle.h>
 #include <RmlUi/Core/Element.h>
 #include <RmlUi/Core/ElementDocument.h>
+#include <RmlUi/Core/StringUtilities.h>
+#include <algorithm>
 #include <doctest.h>
 #include <nanobench.h>
 
@@ -245,3 +247,189 @@ TEST_CASE("data_binding")
 
 	TestsShell::ShutdownShell();
 }
+
+static const String rows_document_rml = R"(
+<rml>
+<head>
+	<title>Test</title>
+	<link type="text/rcss" href="/assets/rml.rcss"/>
+	<link type="text/template" href="/assets/window.rml"/>
+	<style>
+		body.window
+		{
+			left: 50px;
+			right: 50px;
+			top: 30px;
+			bottom: 30px;
+			max-width: -1px;
+			max-height: -1px;
+		}
+	</style>
+</head>
+
+<body template="window">
+<div data-model="rows">
+<div class="row" data-for="row, i : rows" data-class-first="i == 0">
+	<span class="name">{{ row.name }}</span>
+	<span class="value" data-style-color="row.value > 50 ? 'red' : 'black'">{{ row.value | format(2) }}</span>
+	<button data-event-click="row.value = 0">Reset</button>
+</div>
+</div>
+</body>
+</rml>
+)";
+
+struct Row {
+	String name;
+	float value;
+};
+
+TEST_CASE("data_binding.for_rows")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	Vector<Row> rows;
+
+	DataModelHandle model_handle;
+	{
+		DataModelConstructor constructor = context->CreateDataModel("rows");
+		REQUIRE(constructor);
+		if (auto handle = constructor.RegisterStruct<Row>())
+		{
+			handle.RegisterMember("name", &Row::name);
+			handle.RegisterMember("value", &Row::value);
+		}
+		constructor.RegisterArray<Vector<Row>>();
+		constructor.Bind("rows", &rows);
+		model_handle = constructor.GetModelHandle();
+	}
+
+	ElementDocument* document = context->LoadDocumentFromMemory(rows_document_rml);
+	REQUIRE(document);
+	document->Show();
+	context->Update();
+
+	Vector<Row> rows_source(1000);
+	for (int i = 0; i < (int)rows_source.size(); i++)
+		rows_source[i] = Row{"Row " + ToString(i), float(i % 100)};
+
+	nanobench::Bench bench;
+	bench.title("Data bindings: For rows");
+	bench.timeUnit(std::chrono::milliseconds(1), "ms");
+	bench.relative(true);
+
+	bench.run("Add and remove 1000 rows", [&] {
+		rows = rows_source;
+		model_handle.DirtyVariable("rows");
+		context->Update();
+		rows.clear();
+		model_handle.DirtyVariable("rows");
+		context->Update();
+	});
+
+	rows = rows_source;
+	model_handle.DirtyVariable("rows");
+	context->Update();
+
+	bench.title("Data bindings: Update one of 1000 rows");
+	bench.timeUnit(std::chrono::microseconds(1), "us");
+
+	bench.run("Dirty variable", [&] {
+		rows[317].value += 1.f;
+		model_handle.DirtyVariable("rows");
+		context->Update();
+	});
+
+	bench.run("Dirty address", [&] {
+		rows[317].value += 1.f;
+		model_handle.DirtyVariable("rows", 317, "value");
+		context->Update();
+	});
+
+	model_handle.EnableChangeDetection(10000);
+	bench.run("Change detection", [&] {
+		rows[317].value += 1.f;
+		context->Update();
+	});
+	model_handle.DisableChangeDetection();
+
+	document->Close();
+	context->RemoveDataModel("rows");
+
+	TestsShell::ShutdownShell();
+}
+
+TEST_CASE("data_binding.for_key")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	Vector<Row> rows_source(2000);
+	for (int i = 0; i < (int)rows_source.size(); i++)
+		rows_source[i] = Row{"Row " + ToString(i), float(i % 100)};
+
+	nanobench::Bench bench;
+	bench.title("Data bindings: Reorder 2000 rows");
+	bench.timeUnit(std::chrono::milliseconds(1), "ms");
+	bench.relative(true);
+
+	const String keyed_rows_document_rml = StringUtilities::Replace(rows_document_rml, R"(data-for="row, i : rows")",
+		R"(data-for="row, i : rows" data-key="row.name")");
+
+	for (bool keyed : {false, true})
+	{
+		Vector<Row> rows = rows_source;
+
+		DataModelHandle model_handle;
+		{
+			DataModelConstructor constructor = context->CreateDataModel("rows");
+			REQUIRE(constructor);
+			if (auto handle = constructor.RegisterStruct<Row>())
+			{
+				handle.RegisterMember("name", &Row::name);
+				handle.RegisterMember("value", &Row::value);
+			}
+			constructor.RegisterArray<Vector<Row>>();
+			constructor.Bind("rows", &rows);
+			model_handle = constructor.GetModelHandle();
+		}
+
+		ElementDocument* document = context->LoadDocumentFromMemory(keyed ? keyed_rows_document_rml : rows_document_rml);
+		REQUIRE(document);
+		document->Show();
+		context->Update();
+		context->Render();
+
+		bench.run(keyed ? "Reverse (keyed)" : "Reverse", [&] {
+			std::reverse(rows.begin(), rows.end());
+			model_handle.DirtyVariable("rows");
+			context->Update();
+			context->Render();
+		});
+
+		// Without a key, all rows are bound to new entries and must be updated. With a key, dirtying the changed entry is sufficient.
+		bench.run(keyed ? "Insert and remove at front (keyed)" : "Insert and remove at front", [&] {
+			rows.insert(rows.begin(), Row{"New row", 0.f});
+			if (keyed)
+				model_handle.DirtyVariable("rows", 0);
+			else
+				model_handle.DirtyVariable("rows");
+			context->Update();
+			context->Render();
+			rows.erase(rows.begin());
+			if (keyed)
+				model_handle.DirtyVariable("rows", 0);
+			else
+				model_handle.DirtyVariable("rows");
+			context->Update();
+			context->Render();
+		});
+
+		document->Close();
+		context->Update();
+		context->RemoveDataModel("rows");
+	}
+
+	TestsShell::ShutdownShell();
+}
@@ -53,17 +53,32 @@ TEST_CASE("data_expressions")
 	bench.title("Data expression");
 	bench.relative(true);
 
+	auto ResolveAddresses = [](const DataExpressionProgram& program) {
+		AddressList addresses;
+		for (const DataExpressionProgram::Variable& variable : program.variables)
+			addresses.push_back(interface.ParseAddress(variable.name));
+		return addresses;
+	};
+
+	auto CompileAddresses = [](const AddressList& addresses) {
+		AccessorList accessors;
+		for (const DataAddress& address : addresses)
+			accessors.push_back(interface.CompileAddress(address));
+		return accessors;
+	};
+
 	auto bench_expression = [&](const String& expression, const char* parse_name, const char* execute_name) {
-		DataParser parser(expression, interface);
+		DataParser parser(expression);
 
 		bool result = true;
 		bench.run(parse_name, [&] { result &= parser.Parse(false); });
 
 		REQUIRE(result);
 
-		Program program = parser.ReleaseProgram();
-		AddressList addresses = parser.ReleaseAddresses();
-		DataInterpreter interpreter(program, addresses, interface);
+		SharedPtr<const DataExpressionProgram> program = parser.ReleaseProgram();
+		AddressList addresses = ResolveAddresses(*program);
+		AccessorList accessors = CompileAddresses(addresses);
+		DataInterpreter interpreter(program->program, addresses, accessors, interface);
 
 		bench.run(execute_name, [&] { result &= interpreter.Run(); });
 
@@ -75,16 +90,17 @@ TEST_CASE("data_expressions")
 	bench_expression("true || false ? true && radius==1+2 ? 'Absolutely!' : color_value : 'no'", "Complex (parse)", "Complex (execute)");
 
 	auto bench_assignment = [&](const String& expression, const char* parse_name, const char* execute_name) {
-		DataParser parser(expression, interface);
+		DataParser parser(expression);
 
 		bool result = true;
 		bench.run(parse_name, [&] { result &= parser.Parse(true); });
 
 		REQUIRE(result);
 
-		Program program = parser.ReleaseProgram();
-		AddressList addresses = parser.ReleaseAddresses();
-		DataInterpreter interpreter(program, addresses, interface);
+		SharedPtr<const DataExpressionProgram> program = parser.ReleaseProgram();
+		AddressList addresses = ResolveAddresses(*program);
+		AccessorList accessors = CompileAddresses(addresses);
+		DataInterpreter interpreter(program->program, addresses, accessors, interface);
 
 		bench.run(execute_name, [&] { result &= interpreter.Run(); });
 
@@ -95,3 +111,117 @@ TEST_CASE("data_expressions")
 
 	bench_assignment("radius = radius*radius*3.14; color_name = 'image-color'", "Complex assign (parse)", "Complex assign (execute)");
 }
+
+TEST_CASE("data_expressions.variables")
+{
+	struct Stats {
+		int score;
+		float ratio;
+	};
+	struct Player {
+		String name;
+		int level;
+		Stats stats;
+	};
+	Vector<Player> players(100, Player{"player", 10, Stats{50, 0.5f}});
+
+	DataModelConstructor constructor(&model);
+	if (auto stats_handle = constructor.RegisterStruct<Stats>())
+	{
+		stats_handle.RegisterMember("score", &Stats::score);
+		stats_handle.RegisterMember("ratio", &Stats::ratio);
+	}
+	if (auto player_handle = constructor.RegisterStruct<Player>())
+	{
+		player_handle.RegisterMember("name", &Player::name);
+		player_handle.RegisterMember("level", &Player::level);
+		player_handle.RegisterMember("stats", &Player::stats);
+	}
+	constructor.RegisterArray<Vector<Player>>();
+	constructor.Bind("players", &players);
+
+	nanobench::Bench bench;
+	bench.title("Data expression variables");
+	bench.relative(true);
+
+	auto ResolveAddresses = [](const DataExpressionProgram& program) {
+		AddressList addresses;
+		for (const DataExpressionProgram::Variable& variable : program.variables)
+			addresses.push_back(interface.ParseAddress(variable.name));
+		return addresses;
+	};
+
+	auto bench_expression = [&](const String& expression, const char* address_name, const char* compiled_name) {
+		DataParser parser(expression);
+		REQUIRE(parser.Parse(false));
+
+		SharedPtr<const DataExpressionProgram> program = parser.ReleaseProgram();
+		AddressList addresses = ResolveAddresses(*program);
+
+		// Empty accessors make the interpreter look up each variable by its address.
+		AccessorList empty_accessors(addresses.size());
+		AccessorList compiled_accessors;
+		for (const DataAddress& address : addresses)
+			compiled_accessors.push_back(interface.CompileAddress(address));
+
+		bool result = true;
+		DataInterpreter address_interpreter(program->program, addresses, empty_accessors, interface);
+		bench.run(address_name, [&] { result &= address_interpreter.Run(); });
+
+		DataInterpreter compiled_interpreter(program->program, addresses, compiled_accessors, interface);
+		bench.run(compiled_name, [&] { result &= compiled_interpreter.Run(); });
+
+		REQUIRE(result);
+	};
+
+	bench_expression("players[42].level", "Member (address)", "Member (compiled)");
+	bench_expression("players[42].stats.score", "Nested member (address)", "Nested member (compiled)");
+	bench_expression("players[42].level > 5 && players[42].stats.ratio < 0.8 ? players[42].name : 'none'", "Several members (address)",
+		"Several members (compiled)");
+}
+
+TEST_CASE("data_expressions.operands")
+{
+	int level = 12;
+	int max_level = 20;
+	float ratio = 0.5f;
+	double distance = 2.5;
+
+	DataModelConstructor constructor(&model);
+	constructor.Bind("level", &level);
+	constructor.Bind("max_level", &max_level);
+	constructor.Bind("ratio", &ratio);
+	constructor.Bind("distance", &distance);
+
+	nanobench::Bench bench;
+	bench.title("Data expression operands");
+	bench.relative(true);
+
+	// Expressions on variables, as typically found in data-if and data-class attributes.
+	auto bench_expression = [&](const String& expression, const char* name) {
+		DataParser parser(expression);
+		REQUIRE(parser.Parse(false));
+
+		SharedPtr<const DataExpressionProgram> program = parser.ReleaseProgram();
+		AddressList addresses;
+		AccessorList accessors;
+		for (const DataExpressionProgram::Variable& variable : program->variables)
+		{
+			addresses.push_back(interface.ParseAddress(variable.name));
+			accessors.push_back(interface.CompileAddress(addresses.back()));
+		}
+
+		bool result = true;
+		DataInterpreter interpreter(program->program, addresses, accessors, interface);
+		bench.run(name, [&] { result &= interpreter.Run(); });
+
+		REQUIRE(result);
+	};
+
+	bench_expression("level < max_level", "Compare int, int");
+	bench_expression("level == 12", "Compare int, literal");
+	bench_expression("distance >= 1.5", "Compare double, literal");
+	bench_expression("ratio < 0.8", "Compare float, literal");
+	bench_expression("level * 2 + max_level", "Arithmetic int");
+	bench_expression("level > 5 && level < max_level && distance * 2 > 3", "Condition");
+}
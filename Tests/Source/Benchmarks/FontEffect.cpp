@@ -85,3 +85,52 @@ TEST_CASE("font_effect")
 
 	TestsShell::ShutdownShell();
 }
+
+static const String rml_font_effect_heading_document = R"(
+<rml>
+<head>
+    <title>Heading</title>
+    <link type="text/rcss" href="/../Tests/Data/style.rcss"/>
+	<style>
+		body {
+			font-size: 72px;
+			font-effect: %s(%dpx #ff6);
+		}
+	</style>
+</head>
+<body>
+The quick brown fox
+</body>
+</rml>
+)";
+
+TEST_CASE("font_effect.heading")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	nanobench::Bench bench;
+	bench.title("Font effect heading");
+	bench.relative(true);
+
+	for (const char* effect_name : {"shadow", "blur", "outline", "glow"})
+	{
+		constexpr int effect_size = 12;
+
+		const String rml_document = CreateString(rml_font_effect_heading_document.c_str(), effect_name, effect_size);
+
+		ElementDocument* document = context->LoadDocumentFromMemory(rml_document);
+		document->Show();
+		context->Update();
+		context->Render();
+
+		bench.run(effect_name, [&]() {
+			Rml::ReleaseFontResources();
+			context->Render();
+		});
+
+		document->Close();
+	}
+
+	TestsShell::ShutdownShell();
+}
@@ -0,0 +1,80 @@
+﻿/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "../Common/TestsShell.h"
+#include <RmlUi/Core/Context.h>
+#include <RmlUi/Core/Core.h>
+#include <RmlUi/Core/FontEngineInterface.h>
+#include <RmlUi/Core/TextShapingContext.h>
+#include <RmlUi/Core/Types.h>
+#include <doctest.h>
+#include <nanobench.h>
+
+using namespace ankerl;
+using namespace Rml;
+
+TEST_CASE("font_engine.string_width")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	FontEngineInterface* font_interface = GetFontEngineInterface();
+	const FontFaceHandle handle = font_interface->GetFontFaceHandle("latolatin", Style::FontStyle::Normal, Style::FontWeight::Normal, 16);
+	REQUIRE(handle);
+
+	const String language;
+	const TextShapingContext text_shaping_context{language};
+
+	// Text with characters outside the ASCII range, whose kerning pairs are not part of the pre-filled kerning cache.
+	const struct {
+		const char* name;
+		String text;
+	} texts[] = {
+		{"English", "The quick brown fox jumps over the lazy dog. We went to Vienna and saw AVATAR at the Theatre."},
+		{"French", "Où êtes-vous allés cet été ? À l'hôtel près de la forêt, où l'on dîne à côté du théâtre."},
+		{"German", "Größere Übungen für Ärzte: Fünf Bücher über Österreichs Flüsse, Wälder und Gebäude."},
+		{"Polish", "Zażółć gęślą jaźń. Łódź, Świętokrzyskie, Żółw, Źródło, Ćwiczenie, Ósemka i Śnieżka."},
+	};
+
+	nanobench::Bench bench;
+	bench.title("String width");
+	bench.relative(true);
+
+	for (const auto& text : texts)
+	{
+		// Warm up the glyphs and kerning of the text.
+		font_interface->GetStringWidth(handle, text.text, text_shaping_context);
+
+		bench.run(text.name, [&]() {
+			const int width = font_interface->GetStringWidth(handle, text.text, text_shaping_context);
+			nanobench::doNotOptimizeAway(width);
+		});
+	}
+
+	TestsShell::ShutdownShell();
+}
@@ -30,7 +30,9 @@
 #include "TypesToString.h"
 #include <RmlUi/Core/Log.h>
 #include <RmlUi/Core/StringUtilities.h>
+#include <atomic>
 #include <doctest.h>
+#include <thread>
 
 TestsSystemInterface::~TestsSystemInterface()
 {
@@ -91,6 +93,48 @@ void TestsSystemInterface::SetTime(double t)
 	elapsed_time = t;
 }
 
+int TestsSystemInterface::TranslateString(Rml::String& translated, const Rml::String& input)
+{
+	translated = input;
+	for (const auto& translation : translations)
+		translated = Rml::StringUtilities::Replace(translated, translation.first, translation.second);
+	return translated == input ? 0 : 1;
+}
+
+void TestsSystemInterface::SetTranslations(Rml::UnorderedMap<Rml::String, Rml::String> in_translations)
+{
+	translations = std::move(in_translations);
+}
+
+void TestsSystemInterface::ExecuteParallel(int count, const Rml::Function<void(int)>& task)
+{
+	if (num_parallel_threads <= 1)
+	{
+		Rml::SystemInterface::ExecuteParallel(count, task);
+		return;
+	}
+
+	std::atomic<int> next_index{0};
+	auto worker = [&]() {
+		for (int i = next_index++; i < count; i = next_index++)
+			task(i);
+	};
+
+	Rml::Vector<std::thread> threads;
+	for (int i = 1; i < num_parallel_threads; i++)
+		threads.emplace_back(worker);
+
+	worker();
+
+	for (std::thread& thread : threads)
+		thread.join();
+}
+
+void TestsSystemInterface::SetNumParallelThreads(int num_threads)
+{
+	num_parallel_threads = num_threads;
+}
+
 Rml::CompiledGeometryHandle TestsRenderInterface::CompileGeometry(Rml::Span<const Rml::Vertex> vertices, Rml::Span<const int> indices)
 {
 	counters.compile_geometry += 1;
@@ -177,6 +221,14 @@ void TestsRenderInterface::ReleaseTexture(Rml::TextureHandle /*texture_handle*/)
 	counters.release_texture += 1;
 }
 
+bool TestsRenderInterface::UpdateTexture(Rml::TextureHandle /*texture_handle*/, Rml::Span<const Rml::byte> /*source_data*/, Rml::Rectanglei /*region*/)
+{
+	if (!texture_updates_supported)
+		return false;
+	counters.update_texture += 1;
+	return true;
+}
+
 void TestsRenderInterface::SetTransform(const Rml::Matrix4f* /*transform*/)
 {
 	counters.set_transform += 1;
@@ -225,6 +277,7 @@ void TestsRenderInterface::Reset()
 {
 	VerifyMeshes();
 	meshes_set = false;
+	texture_updates_supported = true;
 	ResetCounters();
 }
 void TestsRenderInterface::VerifyMeshes()
@@ -48,8 +48,20 @@ public:
 
 	void SetTime(double t);
 
+	int TranslateString(Rml::String& translated, const Rml::String& input) override;
+
+	// Sets the translations applied to strings, replacing each occurrence of the keys by their values. Clear to disable translation.
+	void SetTranslations(Rml::UnorderedMap<Rml::String, Rml::String> translations);
+
+	void ExecuteParallel(int count, const Rml::Function<void(int)>& task) override;
+
+	// Sets the number of threads used to execute parallel tasks, a value of one executes them on the calling thread.
+	void SetNumParallelThreads(int num_threads);
+
 private:
 	double elapsed_time = 0.0;
+	int num_parallel_threads = 1;
+	Rml::UnorderedMap<Rml::String, Rml::String> translations;
 
 	int num_logged_warnings = 0;
 	int num_expected_warnings = 0;
@@ -66,6 +78,7 @@ public:
 		size_t load_texture;
 		size_t generate_texture;
 		size_t release_texture;
+		size_t update_texture;
 		size_t enable_scissor;
 		size_t set_scissor;
 		size_t enable_clip_mask;
@@ -85,6 +98,7 @@ public:
 	Rml::TextureHandle LoadTexture(Rml::Vector2i& texture_dimensions, const Rml::String& source) override;
 	Rml::TextureHandle GenerateTexture(Rml::Span<const Rml::byte> source_data, Rml::Vector2i source_dimensions) override;
 	void ReleaseTexture(Rml::TextureHandle texture_handle) override;
+	bool UpdateTexture(Rml::TextureHandle texture_handle, Rml::Span<const Rml::byte> source_data, Rml::Rectanglei region) override;
 
 	void EnableScissorRegion(bool enable) override;
 	void SetScissorRegion(Rml::Rectanglei region) override;
@@ -107,6 +121,8 @@ public:
 	const Counters& GetCountersFromPreviousReset() const { return counters_from_previous_reset; }
 
 	void ExpectCompileGeometry(Rml::Vector<Rml::Mesh> meshes);
+	// Set whether to accept partial texture updates, otherwise the library should fall back to regenerating the texture.
+	void SetTextureUpdatesSupported(bool supported) { texture_updates_supported = supported; }
 
 	void Reset();
 
@@ -117,6 +133,7 @@ private:
 	Counters counters_from_previous_reset = {};
 	Rml::Vector<Rml::Mesh> meshes;
 	bool meshes_set = false;
+	bool texture_updates_supported = true;
 };
 
 #endif
@@ -32,6 +32,10 @@
 #include <RmlUi/Core/Core.h>
 #include <RmlUi/Core/Element.h>
 #include <RmlUi/Core/ElementDocument.h>
+#include <RmlUi/Core/FontEngineInterface.h>
+#include <RmlUi/Core/RenderManager.h>
+#include <RmlUi/Core/StringUtilities.h>
+#include <RmlUi/Core/TextShapingContext.h>
 #include <Shell.h>
 #include <algorithm>
 #include <doctest.h>
@@ -249,6 +253,357 @@ TEST_CASE("core.warn_missing_texture_once_when_visible")
 	TestsShell::ShutdownShell();
 }
 
+static const String document_glyph_atlas_rml = R"(
+<rml>
+<head>
+	<link type="text/rcss" href="/assets/rml.rcss"/>
+	<style>
+		body { font-family: LatoLatin; color: #fff; }
+		.shadow { font-effect: shadow(2px 2px #000); }
+	</style>
+</head>
+<body>
+	<p style="font-size: 12px">Small text</p>
+	<p style="font-size: 16px">Medium text</p>
+	<p style="font-size: 24px" class="shadow">Large text with a shadow</p>
+	<p style="font-size: 32px">Huge text</p>
+</body>
+</rml>
+)";
+
+TEST_CASE("core.shared_glyph_atlas")
+{
+	TestsRenderInterface* render_interface = TestsShell::GetTestsRenderInterface();
+	// This test only works with the dummy renderer.
+	if (!render_interface)
+		return;
+
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	const auto& counters = render_interface->GetCounters();
+	REQUIRE(counters.generate_texture == 0);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_glyph_atlas_rml);
+	document->Show();
+	TestsShell::RenderLoop();
+
+	// All font sizes and font effect layers should be packed into a single atlas page.
+	CHECK(counters.generate_texture == 1);
+	CHECK(counters.release_texture == 0);
+
+	// Glyphs outside the preloaded ASCII range are appended to the existing page.
+	const String new_glyphs_rml = "&#xC5;&#xC4;&#xD6; &#xE5;&#xE4;&#xF6;";
+
+	SUBCASE("Partial update")
+	{
+		// Only the modified region of the page is uploaded.
+		document->GetFirstChild()->SetInnerRML(new_glyphs_rml);
+		TestsShell::RenderLoop();
+		CHECK(counters.generate_texture == 1);
+		CHECK(counters.release_texture == 0);
+		CHECK(counters.update_texture == 1);
+	}
+
+	SUBCASE("Fallback to regeneration")
+	{
+		// Without support for partial updates, the page is regenerated in full.
+		render_interface->SetTextureUpdatesSupported(false);
+		document->GetFirstChild()->SetInnerRML(new_glyphs_rml);
+		TestsShell::RenderLoop();
+		CHECK(counters.generate_texture == 2);
+		CHECK(counters.release_texture == 1);
+		CHECK(counters.update_texture == 0);
+	}
+
+	// Rendering again without any new glyphs should not touch the atlas.
+	const auto counters_before = counters;
+	TestsShell::RenderLoop();
+	CHECK(counters.generate_texture == counters_before.generate_texture);
+	CHECK(counters.release_texture == counters_before.release_texture);
+	CHECK(counters.update_texture == counters_before.update_texture);
+
+	document->Close();
+	TestsShell::ShutdownShell();
+}
+
+static String GlyphAtlasFillerRml(int first_font_size, int last_font_size)
+{
+	String rml = "<rml><head><style>body { font-family: LatoLatin; color: #fff; }</style></head><body>";
+	for (int font_size = first_font_size; font_size <= last_font_size; font_size += 10)
+		rml += CreateString("<p style=\"font-size: %dpx\">Large text</p>", font_size);
+	rml += "</body></rml>";
+	return rml;
+}
+
+TEST_CASE("core.glyph_atlas_pinned_owners")
+{
+	TestsRenderInterface* render_interface = TestsShell::GetTestsRenderInterface();
+	// This test only works with the dummy renderer.
+	if (!render_interface)
+		return;
+
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+	TestsSystemInterface* system_interface = TestsShell::GetTestsSystemInterface();
+	FontEngineInterface* font_interface = GetFontEngineInterface();
+	const auto& counters = render_interface->GetCounters();
+
+	ElementDocument* static_document = context->LoadDocumentFromMemory(GlyphAtlasFillerRml(100, 110));
+	static_document->Show();
+	TestsShell::RenderLoop();
+
+	Vector<FontFaceHandle> static_handles;
+	Vector<int> static_versions;
+	for (int i = 0; i < static_document->GetNumChildren(); i++)
+	{
+		const FontFaceHandle handle = static_document->GetChild(i)->GetFontFaceHandle();
+		static_handles.push_back(handle);
+		static_versions.push_back(font_interface->GetVersion(handle));
+	}
+
+	// The static text stays on screen while it idles, then many more font sizes are requested.
+	system_interface->SetTime(2.0);
+	ElementDocument* filler_document = context->LoadDocumentFromMemory(GlyphAtlasFillerRml(120, 200));
+	filler_document->Show();
+	TestsShell::RenderLoop();
+	REQUIRE(counters.generate_texture > 8);
+
+	// The glyphs of text with live geometry must never be evicted from the atlas.
+	for (size_t i = 0; i < static_handles.size(); i++)
+		CHECK(font_interface->GetVersion(static_handles[i]) == static_versions[i]);
+
+	// Once the geometry is released, the idle glyphs can be evicted to make room for new ones.
+	static_document->Close();
+	filler_document->Close();
+	TestsShell::RenderLoop();
+	system_interface->SetTime(4.0);
+	ElementDocument* new_document = context->LoadDocumentFromMemory(GlyphAtlasFillerRml(210, 260));
+	new_document->Show();
+	TestsShell::RenderLoop();
+
+	bool any_evicted = false;
+	for (size_t i = 0; i < static_handles.size(); i++)
+		any_evicted |= (font_interface->GetVersion(static_handles[i]) != static_versions[i]);
+	CHECK(any_evicted);
+
+	new_document->Close();
+	system_interface->SetTime(0.0);
+	TestsShell::ShutdownShell();
+}
+
+TEST_CASE("core.distance_field_text")
+{
+	TestsRenderInterface* render_interface = TestsShell::GetTestsRenderInterface();
+	// This test only works with the dummy renderer.
+	if (!render_interface)
+		return;
+
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	Rml::SetDistanceFieldTextRendering(true);
+
+	const auto& counters = render_interface->GetCounters();
+	ElementDocument* document = context->LoadDocumentFromMemory(document_glyph_atlas_rml);
+	document->Show();
+	TestsShell::RenderLoop();
+
+	// All text, including the font effect, is rendered from the distance fields using the shader.
+	CHECK(counters.generate_texture > 0);
+	CHECK(counters.compile_shader > 0);
+	CHECK(counters.render_shader > 0);
+
+	// Glyphs are shared between all font sizes, so new sizes do not need any new glyphs.
+	const auto counters_before = counters;
+	document->GetFirstChild()->SetProperty(PropertyId::FontSize, Property(20.f, Unit::PX));
+	TestsShell::RenderLoop();
+	CHECK(counters.generate_texture == counters_before.generate_texture);
+	CHECK(counters.update_texture == counters_before.update_texture);
+	CHECK(counters.render_shader > counters_before.render_shader);
+
+	// Glyphs are shared between all contexts, a context whose render interface can not compile the shader makes all text fall back to bitmaps.
+	struct RenderInterfaceWithoutShaders : TestsRenderInterface {
+		CompiledShaderHandle CompileShader(const String& /*name*/, const Dictionary& /*parameters*/) override { return {}; }
+	};
+	RenderInterfaceWithoutShaders render_interface_without_shaders;
+
+	TestsShell::SetNumExpectedWarnings(1);
+	Context* context_without_shaders = Rml::CreateContext("without_shaders", Vector2i(500, 500), &render_interface_without_shaders);
+	REQUIRE(context_without_shaders);
+
+	const auto counters_fallback = counters;
+	TestsShell::RenderLoop();
+	CHECK(counters.generate_texture > counters_fallback.generate_texture);
+	CHECK(counters.render_shader == counters_fallback.render_shader);
+
+	Rml::RemoveContext("without_shaders");
+	document->Close();
+	Rml::SetDistanceFieldTextRendering(false);
+	TestsShell::ShutdownShell();
+}
+
+TEST_CASE("core.parallel_glyph_generation")
+{
+	TestsRenderInterface* render_interface = TestsShell::GetTestsRenderInterface();
+	// This test only works with the dummy renderer.
+	if (!render_interface)
+		return;
+
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+	TestsSystemInterface* system_interface = TestsShell::GetTestsSystemInterface();
+	REQUIRE(system_interface);
+
+	const auto& counters = render_interface->GetCounters();
+	ElementDocument* document = context->LoadDocumentFromMemory(document_glyph_atlas_rml);
+	document->Show();
+	TestsShell::RenderLoop();
+
+	auto GetTextWidths = [&]() {
+		Vector<float> widths;
+		for (int i = 0; i < document->GetNumChildren(); i++)
+		{
+			Element* text = document->GetChild(i)->GetFirstChild();
+			widths.push_back(text->GetOffsetWidth());
+		}
+		return widths;
+	};
+	const Vector<float> serial_widths = GetTextWidths();
+	const auto serial_counters = counters;
+
+	// Regenerate all glyphs and effects in parallel, they should produce the same result as when generated serially.
+	system_interface->SetNumParallelThreads(4);
+	Rml::SetParallelGlyphGeneration(true);
+	Rml::ReleaseFontResources();
+	TestsShell::RenderLoop();
+
+	CHECK(GetTextWidths() == serial_widths);
+	CHECK(counters.generate_texture == 2 * serial_counters.generate_texture);
+	CHECK(counters.render_geometry == 2 * serial_counters.render_geometry);
+
+	Rml::SetParallelGlyphGeneration(false);
+	system_interface->SetNumParallelThreads(1);
+
+	document->Close();
+	TestsShell::ShutdownShell();
+}
+
+TEST_CASE("core.baked_font_glyphs")
+{
+	TestsRenderInterface* render_interface = TestsShell::GetTestsRenderInterface();
+	// This test only works with the dummy renderer.
+	if (!render_interface)
+		return;
+
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(R"(
+<rml>
+<head>
+	<link type="text/rcss" href="/assets/rml.rcss"/>
+	<style>
+		body { font-family: LatoLatin; color: #fff; }
+		.outline { font-size: 20px; font-effect: outline(2px #000); }
+		.glow { font-size: 24px; font-effect: glow(2px #f00), shadow(2px 2px #000); }
+	</style>
+</head>
+<body>
+	<p style="font-size: 16px">Plain text</p>
+	<p class="outline">Text with an outline</p>
+	<p class="glow">Text with a glow and a shadow</p>
+</body>
+</rml>
+)");
+	document->Show();
+	TestsShell::RenderLoop();
+
+	auto GetTextWidths = [&]() {
+		Vector<float> widths;
+		for (int i = 0; i < document->GetNumChildren(); i++)
+			widths.push_back(document->GetChild(i)->GetFirstChild()->GetOffsetWidth());
+		return widths;
+	};
+	const Vector<float> generated_widths = GetTextWidths();
+
+	Vector<byte> baked_data;
+	REQUIRE(Rml::BakeFontGlyphs(baked_data));
+	REQUIRE(!baked_data.empty());
+
+	const String invalid_data = "RMLFONTB";
+	TestsShell::SetNumExpectedWarnings(2);
+	CHECK(!Rml::LoadBakedFontGlyphs(Span<const byte>(reinterpret_cast<const byte*>(invalid_data.data()), invalid_data.size())));
+	CHECK(!Rml::LoadBakedFontGlyphs(Span<const byte>(baked_data.data(), baked_data.size() - 1)));
+	TestsShell::SetNumExpectedWarnings(0);
+
+	// A corrupt header claiming more glyphs than the data can hold should be rejected before anything is allocated for them.
+	{
+		const size_t family_offset = 8 + 3 * sizeof(uint32_t);
+		uint32_t family_length = 0;
+		memcpy(&family_length, baked_data.data() + family_offset, sizeof(family_length));
+		const size_t num_glyphs_offset = family_offset + sizeof(uint32_t) + family_length + sizeof(uint8_t) + sizeof(uint16_t) + sizeof(FontMetrics);
+		REQUIRE(num_glyphs_offset + sizeof(uint32_t) <= baked_data.size());
+
+		Vector<byte> corrupt_data(baked_data.begin(), baked_data.begin() + num_glyphs_offset + sizeof(uint32_t));
+		const uint32_t corrupt_num_glyphs = 0xffff'ffff;
+		memcpy(corrupt_data.data() + num_glyphs_offset, &corrupt_num_glyphs, sizeof(corrupt_num_glyphs));
+
+		TestsShell::SetNumExpectedWarnings(1);
+		CHECK(!Rml::LoadBakedFontGlyphs(Span<const byte>(corrupt_data.data(), corrupt_data.size())));
+		TestsShell::SetNumExpectedWarnings(0);
+	}
+
+	// Render the text again from the baked glyphs, it should produce the same result as when the glyphs were generated.
+	REQUIRE(Rml::LoadBakedFontGlyphs(Span<const byte>(baked_data.data(), baked_data.size())));
+	TestsShell::RenderLoop();
+	CHECK(GetTextWidths() == generated_widths);
+
+	// Baking the glyphs again should reproduce the baked data exactly.
+	Vector<byte> rebaked_data;
+	REQUIRE(Rml::BakeFontGlyphs(rebaked_data));
+	CHECK(rebaked_data == baked_data);
+
+	Rml::ReleaseBakedFontGlyphs();
+	TestsShell::RenderLoop();
+	CHECK(GetTextWidths() == generated_widths);
+
+	document->Close();
+	TestsShell::ShutdownShell();
+}
+
+TEST_CASE("core.kerning_cache")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	FontEngineInterface* font_interface = GetFontEngineInterface();
+	const FontFaceHandle handle = font_interface->GetFontFaceHandle("latolatin", Style::FontStyle::Normal, Style::FontWeight::Normal, 24);
+	REQUIRE(handle);
+
+	const String language;
+	const TextShapingContext text_shaping_context{language};
+
+	// Pairs of characters outside the ASCII range, enough of them to make the kerning cache grow several times.
+	Vector<String> pairs;
+	for (char32_t lhs : {U'A', U'T', U'V', U'W', U'Y', U'\u00C0', U'\u00C5', U'\u00DD'})
+	{
+		for (char32_t rhs = 0xC0; rhs <= 0x17F; rhs++)
+			pairs.push_back(StringUtilities::ToUTF8(Character(lhs)) + StringUtilities::ToUTF8(Character(rhs)));
+	}
+
+	// The first measurement of each pair is fetched from the font, later measurements should give the same result from the cache.
+	Vector<int> widths, cached_widths;
+	for (const String& pair : pairs)
+		widths.push_back(font_interface->GetStringWidth(handle, pair, text_shaping_context));
+	for (const String& pair : pairs)
+		cached_widths.push_back(font_interface->GetStringWidth(handle, pair, text_shaping_context));
+
+	CHECK(cached_widths == widths);
+
+	TestsShell::ShutdownShell();
+}
+
 TEST_CASE("core.release_resources")
 {
 	TestsRenderInterface* render_interface = TestsShell::GetTestsRenderInterface();
@@ -329,11 +684,13 @@ TEST_CASE("core.release_resources")
 		TestsShell::RenderLoop();
 		CHECK(counters.generate_texture == counter_generate_before);
 
-		// However, when we display a non-ASCII character not part of the initial cache, the font texture needs to be regenerated.
+		// However, when we display a non-ASCII character not part of the initial cache, the new glyph needs to be uploaded to the font texture.
+		const auto counter_update_before = counters.update_texture;
 		element->SetInnerRML(reinterpret_cast<const char*>(u8"π"));
 		TestsShell::RenderLoop();
-		CHECK(counters.generate_texture == counter_generate_before + 1);
-		CHECK(counters.release_texture == counter_release_before + 1);
+		CHECK(counters.generate_texture == counter_generate_before);
+		CHECK(counters.release_texture == counter_release_before);
+		CHECK(counters.update_texture == counter_update_before + 1);
 	}
 
 	SUBCASE("ReleaseGeometry")
@@ -458,3 +815,175 @@ TEST_CASE("core.RemoveContext")
 
 	Shell::Shutdown();
 }
+
+static const String document_retained_rendering_rml = R"(
+<rml>
+<head>
+	<link type="text/rcss" href="/assets/rml.rcss"/>
+	<style>
+		body {
+			left: 0;
+			top: 0;
+			right: 0;
+			bottom: 0;
+			font-family: LatoLatin;
+		}
+		.context {
+			position: relative;
+			z-index: 1;
+			background: #333;
+			border: 2px #f00;
+		}
+		.layer {
+			opacity: 0.5;
+			background: #0f0;
+			overflow: hidden;
+			height: 50px;
+		}
+		.transform {
+			transform: rotate(10deg);
+			background: #00f;
+		}
+	</style>
+</head>
+
+<body>
+<div class="context" id="context">Some text <span>and a span</span></div>
+<div class="layer">Translucent text<div class="transform">Rotated text</div></div>
+</body>
+</rml>
+)";
+
+TEST_CASE("core.retained_rendering")
+{
+	TestsRenderInterface* render_interface = TestsShell::GetTestsRenderInterface();
+	// This test only works with the dummy renderer.
+	if (!render_interface)
+		return;
+
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_retained_rendering_rml);
+	REQUIRE(document);
+	document->Show();
+
+	const auto& counters = render_interface->GetCounters();
+
+	// Submits a single frame and returns the number of render calls made during the frame.
+	auto RenderFrame = [&]() {
+		const TestsRenderInterface::Counters counters_before = counters;
+		context->Update();
+		context->Render();
+		return Array<size_t, 4>{
+			counters.render_geometry - counters_before.render_geometry,
+			counters.set_scissor - counters_before.set_scissor,
+			counters.set_transform - counters_before.set_transform,
+			counters.compile_geometry - counters_before.compile_geometry,
+		};
+	};
+
+	RenderFrame();
+	const auto immediate = RenderFrame();
+	REQUIRE(immediate[0] > 0);
+	REQUIRE(immediate[3] == 0);
+
+	CHECK(context->IsRetainedRenderingEnabled() == false);
+	context->EnableRetainedRendering(true);
+	CHECK(context->IsRetainedRenderingEnabled() == true);
+
+	// Recording and replaying should submit the exact same commands as immediate rendering, without regenerating any geometry.
+	for (int i = 0; i < 3; i++)
+		CHECK(RenderFrame() == immediate);
+
+	// Changes to elements inside a recorded stacking context must be reflected in the next frame.
+	Element* element = document->GetElementById("context");
+	element->SetInnerRML("Some text <span>and a span</span><div style='background: #fff'>and another element</div>");
+
+	context->EnableRetainedRendering(false);
+	RenderFrame();
+	const auto immediate_changed = RenderFrame();
+	CHECK(immediate_changed[0] > immediate[0]);
+
+	context->EnableRetainedRendering(true);
+	for (int i = 0; i < 3; i++)
+		CHECK(RenderFrame() == immediate_changed);
+
+	element->SetInnerRML("Some text <span>and a span</span>");
+	RenderFrame();
+	CHECK(RenderFrame() == immediate);
+
+	document->Close();
+
+	TestsShell::ShutdownShell();
+}
+
+TEST_CASE("core.geometry_batching")
+{
+	TestsRenderInterface* render_interface = TestsShell::GetTestsRenderInterface();
+	// This test only works with the dummy renderer.
+	if (!render_interface)
+		return;
+
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+	RenderManager& render_manager = context->GetRenderManager();
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_retained_rendering_rml);
+	REQUIRE(document);
+	document->Show();
+
+	const auto& counters = render_interface->GetCounters();
+
+	// Submits a single frame and returns the number of draw and compile calls made during the frame.
+	auto RenderFrame = [&]() {
+		const TestsRenderInterface::Counters counters_before = counters;
+		context->Update();
+		context->Render();
+		return std::make_pair(counters.render_geometry - counters_before.render_geometry, counters.compile_geometry - counters_before.compile_geometry);
+	};
+
+	RenderFrame();
+	const auto immediate = RenderFrame();
+	REQUIRE(immediate.first > 0);
+	REQUIRE(immediate.second == 0);
+
+	CHECK(render_manager.IsGeometryBatchingEnabled() == false);
+	render_manager.EnableGeometryBatching(true);
+	CHECK(render_manager.IsGeometryBatchingEnabled() == true);
+
+	// Merged geometry is compiled on first use, and reused on later frames.
+	const auto batched_first = RenderFrame();
+	CHECK(batched_first.first < immediate.first);
+	CHECK(batched_first.second > 0);
+
+	const auto batched = RenderFrame();
+	CHECK(batched.first == batched_first.first);
+	CHECK(batched.second == 0);
+
+	SUBCASE("Retained")
+	{
+		context->EnableRetainedRendering(true);
+		for (int i = 0; i < 3; i++)
+			CHECK(RenderFrame() == batched);
+		context->EnableRetainedRendering(false);
+	}
+
+	SUBCASE("Changed")
+	{
+		document->GetElementById("context")->SetInnerRML("Changed text <span>and a span</span>");
+		const auto batched_changed = RenderFrame();
+		CHECK(batched_changed.first == batched.first);
+		CHECK(batched_changed.second > 0);
+		CHECK(RenderFrame() == batched);
+	}
+
+	// Geometry which has only been rendered as part of a batch is compiled when rendered individually.
+	render_manager.EnableGeometryBatching(false);
+	CHECK(RenderFrame().first == immediate.first);
+	CHECK(RenderFrame() == immediate);
+
+	document->Close();
+
+	TestsShell::ShutdownShell();
+}
@@ -26,11 +26,14 @@
  *
  */
 
+#include "../../../Source/Core/DataModel.h"
+#include "../Common/TestsInterface.h"
 #include "../Common/TestsShell.h"
 #include <RmlUi/Core/Context.h>
 #include <RmlUi/Core/DataModelHandle.h>
 #include <RmlUi/Core/Element.h>
 #include <RmlUi/Core/ElementDocument.h>
+#include <algorithm>
 #include <cmath>
 #include <doctest.h>
 
@@ -710,3 +713,602 @@ TEST_CASE("data_binding.set_enum")
 	document->Close();
 	TestsShell::ShutdownShell();
 }
+
+static const String for_virtual_rml = R"(
+<rml>
+<head>
+	<title>Test</title>
+	<link type="text/template" href="/assets/window.rml"/>
+	<style>
+		body.window {
+			width: 500px;
+			height: 400px;
+		}
+		#list {
+			overflow-y: scroll;
+			height: 200px;
+		}
+		.row {
+			display: block;
+			height: 20px;
+		}
+	</style>
+</head>
+<body template="window">
+<div data-model="virtual-test">
+<div id="list">
+	<div class="row" data-for-virtual="value, i : values" data-event-click="value = -1">{{ i }}: {{ value }}</div>
+</div>
+<p id="outside">{{ values[50] }}</p>
+</div>
+</body>
+</rml>
+)";
+
+TEST_CASE("data_binding.for_virtual")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	Vector<int> values(1000);
+	for (int i = 0; i < (int)values.size(); i++)
+		values[i] = i;
+
+	DataModelConstructor constructor = context->CreateDataModel("virtual-test");
+	constructor.RegisterArray<Vector<int>>();
+	constructor.Bind("values", &values);
+	DataModelHandle handle = constructor.GetModelHandle();
+
+	ElementDocument* document = context->LoadDocumentFromMemory(for_virtual_rml);
+	REQUIRE(document);
+	document->Show();
+
+	Element* list = document->GetElementById("list");
+	REQUIRE(list);
+
+	auto GetRows = [document]() {
+		ElementList rows;
+		document->QuerySelectorAll(rows, ".row");
+		// The last match is the hidden element declaring the data-for view.
+		rows.pop_back();
+		return rows;
+	};
+
+	// The rows are measured after the first layout, and then only the rows in view (plus two on each side) are instanced.
+	context->Update();
+	context->Update();
+	TestsShell::RenderLoop();
+
+	ElementList rows = GetRows();
+	REQUIRE(rows.size() == 12);
+	CHECK(rows[0]->GetInnerRML() == "0: 0");
+	CHECK(rows[11]->GetInnerRML() == "11: 11");
+	CHECK(list->GetScrollHeight() == doctest::Approx(20.f * values.size()));
+
+	// Scrolling recycles the existing row elements by binding them to the entries now in view.
+	Element* first_row = rows[0];
+	list->SetScrollTop(1000.f);
+	context->Update();
+	TestsShell::RenderLoop();
+
+	rows = GetRows();
+	REQUIRE(rows.size() == 14);
+	CHECK(rows[0] == first_row);
+	CHECK(rows[0]->GetInnerRML() == "48: 48");
+	CHECK(rows[13]->GetInnerRML() == "61: 61");
+	CHECK(list->GetScrollHeight() == doctest::Approx(20.f * values.size()));
+
+	// Assignments through recycled rows are reflected in other views of the container.
+	CHECK(document->GetElementById("outside")->GetInnerRML() == "50");
+	rows[2]->DispatchEvent(EventId::Click, Dictionary());
+	TestsShell::RenderLoop();
+	CHECK(values[50] == -1);
+	CHECK(rows[2]->GetInnerRML() == "50: -1");
+	CHECK(document->GetElementById("outside")->GetInnerRML() == "-1");
+
+	// Changes to the container are reflected in the instanced rows.
+	values[48] = 4800;
+	handle.DirtyVariable("values");
+	TestsShell::RenderLoop();
+	CHECK(rows[0]->GetInnerRML() == "48: 4800");
+
+	values.resize(55);
+	handle.DirtyVariable("values");
+	context->Update();
+	TestsShell::RenderLoop();
+	rows = GetRows();
+	CHECK(rows.back()->GetInnerRML() == "54: 54");
+	CHECK(list->GetScrollHeight() == doctest::Approx(20.f * values.size()));
+
+	document->Close();
+	TestsShell::ShutdownShell();
+}
+
+static const String for_template_rml = R"(
+<rml>
+<head>
+	<title>Test</title>
+	<link type="text/template" href="/assets/window.rml"/>
+</head>
+<body template="window">
+<div data-model="template-test">
+<div id="list">
+	<p data-for="item, i : items"><span data-class-first="i == 0">{{ item.name }}</span><em data-if="item.tags.size > 0">: <b data-for="tag : item.tags">{{ tag }}</b></em></p>
+</div>
+<div id="text"><span data-for="item : items">{{ item.name }}</span></div>
+</div>
+</body>
+</rml>
+)";
+
+TEST_CASE("data_binding.for_template")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	struct Item {
+		String name;
+		Vector<String> tags;
+	};
+	Vector<Item> items = {{"a", {}}, {"b", {"x", "y"}}};
+
+	DataModelConstructor constructor = context->CreateDataModel("template-test");
+	constructor.RegisterArray<Vector<String>>();
+	if (auto item_handle = constructor.RegisterStruct<Item>())
+	{
+		item_handle.RegisterMember("name", &Item::name);
+		item_handle.RegisterMember("tags", &Item::tags);
+	}
+	constructor.RegisterArray<Vector<Item>>();
+	constructor.Bind("items", &items);
+	DataModelHandle handle = constructor.GetModelHandle();
+
+	ElementDocument* document = context->LoadDocumentFromMemory(for_template_rml);
+	REQUIRE(document);
+	document->Show();
+	TestsShell::RenderLoop();
+
+	// Every row is instanced from the same parsed contents, including nested data views.
+	Element* list = document->GetElementById("list");
+	REQUIRE(list->GetNumChildren() == 3);
+	CHECK(list->GetChild(0)->GetChild(0)->IsClassSet("first"));
+	CHECK(!list->GetChild(1)->GetChild(0)->IsClassSet("first"));
+	CHECK(list->GetChild(0)->GetInnerRML() ==
+		R"(<span data-class-first="i == 0">a</span><em data-if="item.tags.size > 0" style="display: none;">: <b data-for="tag : item.tags" style="display: none;" /></em>)");
+	CHECK(list->GetChild(1)->GetInnerRML() ==
+		R"(<span data-class-first="i == 0">b</span><em data-if="item.tags.size > 0">: <b>x</b><b>y</b><b data-for="tag : item.tags" style="display: none;" /></em>)");
+	CHECK(document->GetElementById("text")->GetInnerRML() == R"(<span>a</span><span>b</span><span data-for="item : items" style="display: none;" />)");
+
+	items.push_back({"c", {"z"}});
+	handle.DirtyVariable("items");
+	TestsShell::RenderLoop();
+
+	REQUIRE(list->GetNumChildren() == 4);
+	CHECK(list->GetChild(2)->GetInnerRML() ==
+		R"(<span data-class-first="i == 0">c</span><em data-if="item.tags.size > 0">: <b>z</b><b data-for="tag : item.tags" style="display: none;" /></em>)");
+	CHECK(document->GetElementById("text")->GetInnerRML() ==
+		R"(<span>a</span><span>b</span><span>c</span><span data-for="item : items" style="display: none;" />)");
+
+	document->Close();
+	TestsShell::ShutdownShell();
+}
+
+static const String for_template_translation_rml = R"(
+<rml>
+<head>
+	<title>Test</title>
+	<link type="text/template" href="/assets/window.rml"/>
+</head>
+<body template="window">
+<div data-model="template-translation-test" id="list">
+	<p data-for="item : items"><em>greeting</em> {{ item }}</p>
+</div>
+</body>
+</rml>
+)";
+
+TEST_CASE("data_binding.for_template_translation")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+	TestsSystemInterface* system_interface = TestsShell::GetTestsSystemInterface();
+	system_interface->SetTranslations({{"greeting", "Hello"}});
+
+	Vector<String> items = {"a"};
+
+	DataModelConstructor constructor = context->CreateDataModel("template-translation-test");
+	constructor.RegisterArray<Vector<String>>();
+	constructor.Bind("items", &items);
+	DataModelHandle handle = constructor.GetModelHandle();
+
+	ElementDocument* document = context->LoadDocumentFromMemory(for_template_translation_rml);
+	REQUIRE(document);
+	document->Show();
+	TestsShell::RenderLoop();
+
+	Element* list = document->GetElementById("list");
+	REQUIRE(list->GetNumChildren() == 2);
+	CHECK(list->GetChild(0)->GetInnerRML() == "<em>Hello</em> a");
+
+	// Rows instanced after the translations change use the new translations.
+	system_interface->SetTranslations({{"greeting", "Hallo"}});
+	items.push_back("b");
+	handle.DirtyVariable("items");
+	TestsShell::RenderLoop();
+
+	REQUIRE(list->GetNumChildren() == 3);
+	CHECK(list->GetChild(1)->GetInnerRML() == "<em>Hallo</em> b");
+
+	system_interface->SetTranslations({});
+	document->Close();
+	TestsShell::ShutdownShell();
+}
+
+static const String for_key_rml = R"(
+<rml>
+<head>
+	<title>Test</title>
+	<link type="text/template" href="/assets/window.rml"/>
+</head>
+<body template="window">
+<div data-model="key-test">
+<div id="list">
+	<p data-for="item, i : items" data-key="item.id" data-event-click="item.name = 'clicked'">{{ i }}: {{ item.name }}</p>
+</div>
+<div id="outside">{{ items[0].name }}</div>
+</div>
+</body>
+</rml>
+)";
+
+TEST_CASE("data_binding.for_key")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	struct Item {
+		int id;
+		String name;
+	};
+	Vector<Item> items = {{1, "a"}, {2, "b"}, {3, "c"}};
+
+	DataModelConstructor constructor = context->CreateDataModel("key-test");
+	if (auto item_handle = constructor.RegisterStruct<Item>())
+	{
+		item_handle.RegisterMember("id", &Item::id);
+		item_handle.RegisterMember("name", &Item::name);
+	}
+	constructor.RegisterArray<Vector<Item>>();
+	constructor.Bind("items", &items);
+	DataModelHandle handle = constructor.GetModelHandle();
+
+	ElementDocument* document = context->LoadDocumentFromMemory(for_key_rml);
+	REQUIRE(document);
+	document->Show();
+	TestsShell::RenderLoop();
+
+	Element* list = document->GetElementById("list");
+	auto GetRows = [list]() {
+		ElementList rows;
+		for (int i = 0; i < list->GetNumChildren() - 1; i++)
+			rows.push_back(list->GetChild(i));
+		return rows;
+	};
+
+	const ElementList initial_rows = GetRows();
+	REQUIRE(initial_rows.size() == 3);
+	CHECK(initial_rows[0]->GetInnerRML() == "0: a");
+	CHECK(initial_rows[2]->GetInnerRML() == "2: c");
+
+	// Rows follow their entries when the container is reordered.
+	std::reverse(items.begin(), items.end());
+	handle.DirtyVariable("items");
+	TestsShell::RenderLoop();
+
+	ElementList rows = GetRows();
+	REQUIRE(rows.size() == 3);
+	CHECK(rows[0] == initial_rows[2]);
+	CHECK(rows[1] == initial_rows[1]);
+	CHECK(rows[2] == initial_rows[0]);
+	CHECK(rows[0]->GetInnerRML() == "0: c");
+	CHECK(rows[2]->GetInnerRML() == "2: a");
+
+	// Only the new entry is instanced when inserting at the front.
+	items.insert(items.begin(), Item{4, "d"});
+	handle.DirtyVariable("items", 0);
+	TestsShell::RenderLoop();
+
+	rows = GetRows();
+	REQUIRE(rows.size() == 4);
+	CHECK(rows[1] == initial_rows[2]);
+	CHECK(rows[3] == initial_rows[0]);
+	CHECK(rows[0]->GetInnerRML() == "0: d");
+	CHECK(rows[1]->GetInnerRML() == "1: c");
+	CHECK(rows[3]->GetInnerRML() == "3: a");
+
+	// Dirty entry addresses are forwarded to the rows bound to them.
+	items[2].name = "e";
+	handle.DirtyVariable("items", 2, "name");
+	TestsShell::RenderLoop();
+	CHECK(rows[2]->GetInnerRML() == "2: e");
+	CHECK(rows[1]->GetInnerRML() == "1: c");
+
+	items.erase(items.begin());
+	handle.DirtyVariable("items");
+	TestsShell::RenderLoop();
+
+	rows = GetRows();
+	REQUIRE(rows.size() == 3);
+	CHECK(rows[0] == initial_rows[2]);
+	CHECK(rows[0]->GetInnerRML() == "0: c");
+	CHECK(rows[2]->GetInnerRML() == "2: a");
+
+	// Assignments through the rows are reflected in other views of the container.
+	CHECK(document->GetElementById("outside")->GetInnerRML() == "c");
+	rows[0]->DispatchEvent(EventId::Click, Dictionary());
+	TestsShell::RenderLoop();
+	CHECK(items[0].name == "clicked");
+	CHECK(rows[0]->GetInnerRML() == "0: clicked");
+	CHECK(document->GetElementById("outside")->GetInnerRML() == "clicked");
+
+	// Changing a key replaces its row.
+	rows[1]->SetClass("replaced", true);
+	items[1].id = 10;
+	handle.DirtyVariable("items", 1, "id");
+	TestsShell::RenderLoop();
+
+	rows = GetRows();
+	REQUIRE(rows.size() == 3);
+	CHECK(rows[0] == initial_rows[2]);
+	CHECK(!rows[1]->IsClassSet("replaced"));
+	CHECK(rows[2] == initial_rows[0]);
+	CHECK(rows[1]->GetInnerRML() == "1: e");
+
+
+	document->Close();
+	TestsShell::ShutdownShell();
+}
+
+static const String for_key_nested_rml = R"(
+<rml>
+<head>
+	<title>Test</title>
+	<link type="text/template" href="/assets/window.rml"/>
+</head>
+<body template="window">
+<div data-model="key-nested-test" id="list">
+	<p data-for="group : groups"><span data-for="item : group" data-key="item">{{ item }}</span></p>
+</div>
+</body>
+</rml>
+)";
+
+TEST_CASE("data_binding.for_key_nested")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	using Group = Vector<int>;
+	const Vector<Group> initial_groups = {{1, 2}, {3}};
+	Vector<Group> groups = initial_groups;
+
+	DataModelConstructor constructor = context->CreateDataModel("key-nested-test");
+	constructor.RegisterArray<Group>();
+	constructor.RegisterArray<Vector<Group>>();
+	constructor.Bind("groups", &groups);
+	DataModelHandle handle = constructor.GetModelHandle();
+	handle.EnableChangeDetection();
+
+	ElementDocument* document = context->LoadDocumentFromMemory(for_key_nested_rml);
+	REQUIRE(document);
+	document->Show();
+	TestsShell::RenderLoop();
+
+	Element* list = document->GetElementById("list");
+	DataModel* model = list->GetDataModel();
+	REQUIRE(model);
+	REQUIRE(list->GetNumChildren() == 3);
+	CHECK(list->GetChild(0)->GetInnerRML() == R"(<span>1</span><span>2</span><span data-for="item : group" data-key="item" style="display: none;" />)");
+
+	// Each keyed view binds its own internal variable. Their addresses are removed along with the views, together with any snapshots of
+	// them, thus recreating the views should not grow the address tree.
+	const size_t num_address_nodes = model->GetNumViewAddressNodes();
+	for (int iteration = 0; iteration < 10; iteration++)
+	{
+		groups.clear();
+		handle.DirtyVariable("groups");
+		TestsShell::RenderLoop();
+		CHECK(list->GetNumChildren() == 1);
+
+		groups = initial_groups;
+		handle.DirtyVariable("groups");
+		TestsShell::RenderLoop();
+		CHECK(model->GetNumViewAddressNodes() == num_address_nodes);
+	}
+
+	REQUIRE(list->GetNumChildren() == 3);
+	CHECK(list->GetChild(1)->GetInnerRML() == R"(<span>3</span><span data-for="item : group" data-key="item" style="display: none;" />)");
+
+	document->Close();
+	TestsShell::ShutdownShell();
+}
+
+static const String dirty_address_rml = R"(
+<rml>
+<head>
+	<title>Test</title>
+	<link type="text/template" href="/assets/window.rml"/>
+</head>
+<body template="window">
+<div data-model="dirty-address-test">
+<p data-for="player : players" data-event-click="player.score = 0">{{ player.name }}: {{ player.score }}</p>
+</div>
+</body>
+</rml>
+)";
+
+TEST_CASE("data_binding.dirty_address")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	struct Player {
+		String name;
+		int score;
+	};
+	Vector<Player> players = {{"a", 1}, {"b", 2}, {"c", 3}};
+
+	DataModelConstructor constructor = context->CreateDataModel("dirty-address-test");
+	if (auto player_handle = constructor.RegisterStruct<Player>())
+	{
+		player_handle.RegisterMember("name", &Player::name);
+		player_handle.RegisterMember("score", &Player::score);
+	}
+	constructor.RegisterArray<Vector<Player>>();
+	constructor.Bind("players", &players);
+	DataModelHandle handle = constructor.GetModelHandle();
+
+	ElementDocument* document = context->LoadDocumentFromMemory(dirty_address_rml);
+	REQUIRE(document);
+	document->Show();
+	TestsShell::RenderLoop();
+
+	ElementList rows;
+	document->GetElementsByTagName(rows, "p");
+	REQUIRE(rows.size() == 4);
+	CHECK(rows[0]->GetInnerRML() == "a: 1");
+	CHECK(rows[1]->GetInnerRML() == "b: 2");
+
+	// Only the views depending on the dirtied address are updated.
+	players[0].score = 10;
+	players[1].score = 20;
+	handle.DirtyVariable("players", 1, "score");
+	CHECK(handle.IsVariableDirty("players"));
+	TestsShell::RenderLoop();
+	CHECK(rows[0]->GetInnerRML() == "a: 1");
+	CHECK(rows[1]->GetInnerRML() == "b: 20");
+
+	handle.DirtyVariable("players");
+	TestsShell::RenderLoop();
+	CHECK(rows[0]->GetInnerRML() == "a: 10");
+
+	// Assignments dirty the address of the assigned value.
+	players[0].score = 100;
+	rows[2]->DispatchEvent(EventId::Click, Dictionary());
+	TestsShell::RenderLoop();
+	CHECK(players[2].score == 0);
+	CHECK(rows[2]->GetInnerRML() == "c: 0");
+	CHECK(rows[0]->GetInnerRML() == "a: 10");
+
+	// Views of the whole container are updated when any part of it is dirtied.
+	players.push_back({"d", 4});
+	handle.DirtyVariable("players", 3);
+	TestsShell::RenderLoop();
+	rows.clear();
+	document->GetElementsByTagName(rows, "p");
+	REQUIRE(rows.size() == 5);
+	CHECK(rows[3]->GetInnerRML() == "d: 4");
+
+	document->Close();
+	TestsShell::ShutdownShell();
+}
+
+static const String change_detection_rml = R"(
+<rml>
+<head>
+	<title>Test</title>
+	<link type="text/template" href="/assets/window.rml"/>
+</head>
+<body template="window">
+<div data-model="change-detection-test">
+<p data-for="player : players">{{ player.name }}: {{ player.score | count_updates }}</p>
+</div>
+</body>
+</rml>
+)";
+
+TEST_CASE("data_binding.change_detection")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	struct Player {
+		String name;
+		int score;
+	};
+	Vector<Player> players = {{"a", 1}, {"b", 2}, {"c", 3}};
+
+	int num_score_updates = 0;
+
+	DataModelConstructor constructor = context->CreateDataModel("change-detection-test");
+	if (auto player_handle = constructor.RegisterStruct<Player>())
+	{
+		player_handle.RegisterMember("name", &Player::name);
+		player_handle.RegisterMember("score", &Player::score);
+	}
+	constructor.RegisterArray<Vector<Player>>();
+	constructor.Bind("players", &players);
+	constructor.RegisterTransformFunc("count_updates", [&num_score_updates](const VariantList& params) {
+		num_score_updates += 1;
+		return params.empty() ? Variant() : params[0];
+	});
+	DataModelHandle handle = constructor.GetModelHandle();
+	handle.EnableChangeDetection();
+
+	ElementDocument* document = context->LoadDocumentFromMemory(change_detection_rml);
+	REQUIRE(document);
+	document->Show();
+	TestsShell::RenderLoop();
+
+	auto GetRows = [document]() {
+		ElementList rows;
+		document->GetElementsByTagName(rows, "p");
+		return rows;
+	};
+
+	ElementList rows = GetRows();
+	REQUIRE(rows.size() == 4);
+	CHECK(rows[1]->GetInnerRML() == "b: 2");
+
+	// Changed values are detected without dirtying any variables.
+	players[1].score = 20;
+	TestsShell::RenderLoop();
+	CHECK(rows[1]->GetInnerRML() == "b: 20");
+
+	players.push_back({"d", 4});
+	TestsShell::RenderLoop();
+	rows = GetRows();
+	REQUIRE(rows.size() == 5);
+	CHECK(rows[3]->GetInnerRML() == "d: 4");
+
+	players.erase(players.begin());
+	TestsShell::RenderLoop();
+	rows = GetRows();
+	REQUIRE(rows.size() == 4);
+	CHECK(rows[0]->GetInnerRML() == "b: 20");
+	CHECK(rows[2]->GetInnerRML() == "d: 4");
+
+	handle.DisableChangeDetection();
+	players[2].name = "e";
+	TestsShell::RenderLoop();
+	CHECK(rows[2]->GetInnerRML() == "d: 4");
+
+	// With a small budget, changes are detected over several updates.
+	handle.EnableChangeDetection(1);
+	players[2].score = 5;
+	for (int i = 0; i < 10; i++)
+		context->Update();
+	CHECK(rows[2]->GetInnerRML() == "e: 5");
+
+	// Dirtying a changed value manually refreshes its snapshot, so that its views are not updated again once the change is detected.
+	players[0].score = 7;
+	handle.DirtyVariable("players", 0, "score");
+	num_score_updates = 0;
+	for (int i = 0; i < 20; i++)
+		context->Update();
+	CHECK(rows[0]->GetInnerRML() == "b: 7");
+	CHECK(num_score_updates == 1);
+
+	document->Close();
+	TestsShell::ShutdownShell();
+}
@@ -37,18 +37,36 @@ static DataTypeRegister type_register;
 static DataModel model(&type_register);
 static DataExpressionInterface interface(&model, nullptr);
 
+static AddressList ResolveAddresses(const DataExpressionProgram& program)
+{
+	AddressList addresses;
+	for (const DataExpressionProgram::Variable& variable : program.variables)
+		addresses.push_back(interface.ParseAddress(variable.name));
+	return addresses;
+}
+
+static AccessorList CompileAddresses(const AddressList& addresses)
+{
+	AccessorList accessors;
+	for (const DataAddress& address : addresses)
+		accessors.push_back(interface.CompileAddress(address));
+	return accessors;
+}
+
 static String TestExpression(const String& expression)
 {
 	String result;
 
-	DataParser parser(expression, interface);
+	DataParser parser(expression);
 
 	if (parser.Parse(false))
 	{
-		Program program = parser.ReleaseProgram();
-		AddressList addresses = parser.ReleaseAddresses();
+		SharedPtr<const DataExpressionProgram> parsed = parser.ReleaseProgram();
+		const Program& program = parsed->program;
+		AddressList addresses = ResolveAddresses(*parsed);
+		AccessorList accessors = CompileAddresses(addresses);
 
-		DataInterpreter interpreter(program, addresses, interface);
+		DataInterpreter interpreter(program, addresses, accessors, interface);
 
 		if (interpreter.Run())
 			result = interpreter.Result().Get<String>();
@@ -57,7 +75,8 @@ static String TestExpression(const String& expression)
 	}
 	else
 	{
-		Program program = parser.ReleaseProgram();
+		SharedPtr<const DataExpressionProgram> parsed = parser.ReleaseProgram();
+		const Program& program = parsed->program;
 		FAIL_CHECK("Could not parse expression: " << expression << "\n\n  Parsed result: \n" << DumpProgram(program));
 	}
 
@@ -67,13 +86,15 @@ static String TestExpression(const String& expression)
 static bool TestAssignment(const String& expression)
 {
 	bool result = false;
-	DataParser parser(expression, interface);
+	DataParser parser(expression);
 	if (parser.Parse(true))
 	{
-		Program program = parser.ReleaseProgram();
-		AddressList addresses = parser.ReleaseAddresses();
+		SharedPtr<const DataExpressionProgram> parsed = parser.ReleaseProgram();
+		const Program& program = parsed->program;
+		AddressList addresses = ResolveAddresses(*parsed);
+		AccessorList accessors = CompileAddresses(addresses);
 
-		DataInterpreter interpreter(program, addresses, interface);
+		DataInterpreter interpreter(program, addresses, accessors, interface);
 		if (interpreter.Run())
 			result = true;
 		else
@@ -81,7 +102,8 @@ static bool TestAssignment(const String& expression)
 	}
 	else
 	{
-		Program program = parser.ReleaseProgram();
+		SharedPtr<const DataExpressionProgram> parsed = parser.ReleaseProgram();
+		const Program& program = parsed->program;
 		FAIL_CHECK("Could not parse assignment expression: " << expression << "\n\n  Parsed result: \n" << DumpProgram(program));
 	}
 	return result;
@@ -94,6 +116,8 @@ TEST_CASE("Data expressions")
 	String color_name = "color";
 	Colourb color_value = Colourb(180, 100, 255);
 	std::vector<String> num_multi = {"left", "right"};
+	int num_goats = 100000;
+	double distance = 2.5;
 
 	DataModelConstructor constructor(&model);
 	constructor.RegisterArray<std::vector<String>>();
@@ -102,6 +126,8 @@ TEST_CASE("Data expressions")
 	constructor.Bind("color_name", &color_name);
 	constructor.Bind("num_trolls", &num_trolls);
 	constructor.Bind("num_multi", &num_multi);
+	constructor.Bind("num_goats", &num_goats);
+	constructor.Bind("distance", &distance);
 	constructor.BindFunc("color_value", [&](Variant& variant) { variant = ToString(color_value); });
 
 	constructor.RegisterTransformFunc("concatenate", [](const VariantList& arguments) -> Variant {
@@ -200,4 +226,65 @@ TEST_CASE("Data expressions")
 	// Test that only one side of ternary is evaluated
 	CHECK(TestExpression("true ? num_multi[0] : num_multi[999]") == "left");
 	CHECK(TestExpression("false ? num_multi[999] : num_multi[1]") == "right");
+
+	// Literals are folded, but never across the branches of a ternary
+	CHECK(TestExpression("(true ? 1 : 2) + 3") == "4");
+	CHECK(TestExpression("(false ? 1 : 2) + 3") == "5");
+	CHECK(TestExpression("!(true ? 0 : 1)") == "1");
+	CHECK(TestExpression("!(false ? 0 : 1)") == "0");
+	CHECK(TestExpression("true ? 1 + 2 : 3 + 4") == "3");
+	CHECK(TestExpression("false ? 1 + 2 : 3 + 4") == "7");
+	CHECK(TestExpression("num_multi[num_trolls - 2] + num_multi[num_trolls - 3]") == "rightleft");
+	CHECK(TestExpression("radius * 2 + 1 * 3") == "11");
+
+	// Integer operands behave as doubles, also when both operands are integers
+	CHECK(TestExpression("num_trolls + num_trolls") == "6");
+	CHECK(TestExpression("num_trolls - num_goats") == "-99997");
+	CHECK(TestExpression("num_goats * num_goats") == "10000000000");
+	CHECK(TestExpression("num_goats / num_trolls") == "33333.333");
+	CHECK(TestExpression("num_trolls < num_goats") == "1");
+	CHECK(TestExpression("num_trolls >= num_goats") == "0");
+	CHECK(TestExpression("num_trolls == num_trolls && num_trolls != num_goats") == "1");
+	CHECK(TestExpression("num_trolls == 3 && num_trolls <= 3.5 && num_trolls > 2.5") == "1");
+	CHECK(TestExpression("num_trolls * distance") == "7.5");
+	CHECK(TestExpression("distance * distance - distance / 2") == "5");
+	CHECK(TestExpression("distance == 2.5 && distance != num_trolls") == "1");
+	CHECK(TestExpression("(num_trolls > 2) + num_trolls") == "4");
+}
+
+TEST_CASE("Data expressions.compiled_addresses")
+{
+	struct Item {
+		String name;
+		int count;
+	};
+	Vector<Item> items = {{"apple", 1}, {"pear", 2}};
+
+	DataModelConstructor constructor(&model);
+	if (auto item_handle = constructor.RegisterStruct<Item>())
+	{
+		item_handle.RegisterMember("name", &Item::name);
+		item_handle.RegisterMember("count", &Item::count);
+	}
+	constructor.RegisterArray<Vector<Item>>();
+	constructor.Bind("items", &items);
+
+	DataExpression expression("items[1].name + ': ' + items[1].count");
+	REQUIRE(expression.Parse(interface, false));
+
+	auto RunExpression = [&]() {
+		Variant result;
+		CHECK(expression.Run(interface, result));
+		return result.Get<String>();
+	};
+
+	CHECK(RunExpression() == "pear: 2");
+
+	// The expression is compiled once, it should still follow the array after it reallocates.
+	items.resize(1000, Item{"banana", 3});
+	items[1].count = 5;
+	CHECK(RunExpression() == "pear: 5");
+
+	items.erase(items.begin());
+	CHECK(RunExpression() == "banana: 3");
 }
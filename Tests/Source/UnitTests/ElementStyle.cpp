@@ -26,10 +26,14 @@
  *
  */
 
+#include "../../../Source/Core/DefinitionPrefetch.h"
+#include "../Common/TestsInterface.h"
 #include "../Common/TestsShell.h"
+#include <RmlUi/Core/ComputedValues.h>
 #include <RmlUi/Core/Context.h>
 #include <RmlUi/Core/Element.h>
 #include <RmlUi/Core/ElementDocument.h>
+#include <RmlUi/Core/StringUtilities.h>
 #include <doctest.h>
 
 using namespace Rml;
@@ -84,3 +88,181 @@ TEST_CASE("elementstyle.inline_decorator_images")
 
 	TestsShell::ShutdownShell();
 }
+
+static const String document_style_sharing_rml = R"(
+<rml>
+<head>
+	<style>
+		.row { drag: drag; }
+		.active .row { drag: drag-drop; }
+		.row:nth-child(3) { drag: none; }
+		.row.selected { drag: block; }
+		.row:hover { drag: clone; }
+		.cell { tab-index: auto; }
+		.cell[disabled] { tab-index: none; }
+	</style>
+</head>
+
+<body>
+<div id="list" class="list">
+	<div class="row"><span class="cell"/></div>
+	<div class="row"><span class="cell"/></div>
+	<div class="row"><span class="cell" disabled/></div>
+	<div class="row"><span class="cell"/></div>
+	<div class="row"><span class="cell"/></div>
+</div>
+</body>
+</rml>
+)";
+
+TEST_CASE("elementstyle.style_sharing")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_style_sharing_rml);
+	REQUIRE(document);
+	document->Show();
+	context->Update();
+
+	Element* list = document->GetElementById("list");
+	REQUIRE(list->GetNumChildren() == 5);
+
+	auto GetDrag = [&](int row) { return list->GetChild(row)->GetComputedValues().drag(); };
+	auto GetTabIndex = [&](int row) { return list->GetChild(row)->GetChild(0)->GetComputedValues().tab_index(); };
+
+	// Siblings with identical selector inputs must still be styled independently when structural or attribute selectors apply.
+	CHECK(GetDrag(1) == Style::Drag::Drag);
+	CHECK(GetDrag(2) == Style::Drag::None);
+	CHECK(GetDrag(3) == Style::Drag::Drag);
+	CHECK(GetTabIndex(1) == Style::TabIndex::Auto);
+	CHECK(GetTabIndex(2) == Style::TabIndex::None);
+	CHECK(GetTabIndex(3) == Style::TabIndex::Auto);
+
+	list->GetChild(1)->SetClass("selected", true);
+	list->GetChild(4)->SetPseudoClass("hover", true);
+	context->Update();
+	CHECK(GetDrag(0) == Style::Drag::Drag);
+	CHECK(GetDrag(1) == Style::Drag::Block);
+	CHECK(GetDrag(3) == Style::Drag::Drag);
+	CHECK(GetDrag(4) == Style::Drag::Clone);
+
+	list->SetClass("active", true);
+	list->GetChild(4)->SetPseudoClass("hover", false);
+	context->Update();
+	CHECK(GetDrag(0) == Style::Drag::DragDrop);
+	CHECK(GetDrag(1) == Style::Drag::Block);
+	CHECK(GetDrag(2) == Style::Drag::None);
+	CHECK(GetDrag(4) == Style::Drag::DragDrop);
+
+	// Newly inserted rows should be able to share the style of their siblings.
+	ElementPtr new_row = document->CreateElement("div");
+	new_row->SetClass("row", true);
+	Element* new_row_ptr = list->InsertBefore(std::move(new_row), list->GetChild(0));
+	context->Update();
+	CHECK(new_row_ptr->GetComputedValues().drag() == Style::Drag::DragDrop);
+	CHECK(GetDrag(1) == Style::Drag::DragDrop);
+	CHECK(GetDrag(2) == Style::Drag::Block);
+	CHECK(GetDrag(3) == Style::Drag::DragDrop);
+	CHECK(GetDrag(5) == Style::Drag::DragDrop);
+
+	document->Close();
+	TestsShell::ShutdownShell();
+}
+
+static const String document_parallel_style_rml = R"(
+<rml>
+<head>
+	<style>
+		.row { drag: drag; }
+		.active .row { drag: drag-drop; }
+		.row:nth-child(3n) { drag: none; }
+		.active > .row:nth-child(3n) { drag: block; }
+		.cell { tab-index: auto; }
+		.cell[disabled] { tab-index: none; }
+		.active .cell[disabled] { tab-index: auto; }
+	</style>
+</head>
+
+<body>
+<div id="list"/>
+</body>
+</rml>
+)";
+
+TEST_CASE("elementstyle.parallel_style_resolution")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	TestsSystemInterface* system_interface = TestsShell::GetTestsSystemInterface();
+	REQUIRE(system_interface);
+	system_interface->SetNumParallelThreads(4);
+	context->EnableParallelStyleResolution(true);
+
+	// Enough elements to be distributed over several tasks.
+	constexpr int num_rows = 400;
+	String rml = document_parallel_style_rml;
+	String rows;
+	for (int i = 0; i < num_rows; i++)
+		rows += (i % 2 == 0 ? "<div class='row'><span class='cell' disabled/></div>" : "<div class='row'><span class='cell'/></div>");
+	rml = StringUtilities::Replace(rml, "<div id=\"list\"/>", "<div id=\"list\">" + rows + "</div>");
+
+	ElementDocument* document = context->LoadDocumentFromMemory(rml);
+	REQUIRE(document);
+	document->Show();
+	context->Update();
+
+	Element* list = document->GetElementById("list");
+	REQUIRE(list->GetNumChildren() == num_rows);
+
+	auto CheckStyles = [&](bool active) {
+		int num_failed = 0;
+		for (int i = 0; i < num_rows; i++)
+		{
+			Element* row = list->GetChild(i);
+			const bool third = ((i + 1) % 3 == 0);
+			const Style::Drag expected_drag =
+				(third ? (active ? Style::Drag::Block : Style::Drag::None) : (active ? Style::Drag::DragDrop : Style::Drag::Drag));
+			const Style::TabIndex expected_tab_index = (i % 2 == 0 && !active ? Style::TabIndex::None : Style::TabIndex::Auto);
+			if (row->GetComputedValues().drag() != expected_drag || row->GetChild(0)->GetComputedValues().tab_index() != expected_tab_index)
+				num_failed += 1;
+		}
+		CHECK(num_failed == 0);
+	};
+
+	CheckStyles(false);
+
+	list->SetClass("active", true);
+	context->Update();
+	CheckStyles(true);
+
+	list->SetClass("active", false);
+	context->Update();
+	CheckStyles(false);
+
+	// Dirtying an element after the definitions were prefetched only invalidates the definitions of the affected elements.
+	{
+		list->SetClass("active", true);
+		DefinitionPrefetch::Prefetch(document);
+
+		Element* row = list->GetChild(10);
+		row->SetClass("row", false);
+
+		SharedPtr<const ElementDefinition> definition;
+		CHECK(!DefinitionPrefetch::TakeDefinition(row, definition));
+		CHECK(DefinitionPrefetch::TakeDefinition(row->GetChild(0), definition));
+		CHECK(DefinitionPrefetch::TakeDefinition(list->GetChild(11), definition));
+		DefinitionPrefetch::Invalidate();
+
+		row->SetClass("row", true);
+		context->Update();
+		CheckStyles(true);
+	}
+
+	context->EnableParallelStyleResolution(false);
+	system_interface->SetNumParallelThreads(1);
+
+	document->Close();
+	TestsShell::ShutdownShell();
+}
@@ -0,0 +1,97 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "../Common/TestsInterface.h"
+#include "../Common/TestsShell.h"
+#include <RmlUi/Core/Context.h>
+#include <RmlUi/Core/Core.h>
+#include <RmlUi/Core/Element.h>
+#include <RmlUi/Core/ElementDocument.h>
+#include <doctest.h>
+
+using namespace Rml;
+
+static const String document_text_rml = R"(
+<rml>
+<head>
+	<link type="text/rcss" href="/assets/rml.rcss"/>
+	<style>
+		body { font-family: LatoLatin; font-size: 20px; }
+		p { width: 150px; color: #f00; font-effect: shadow(2px 2px #0f0); }
+		p.glow { font-effect: glow(2px #00f); }
+	</style>
+</head>
+<body>
+	<p id="p">The quick brown fox jumps over the lazy dog.</p>
+</body>
+</rml>
+)";
+
+TEST_CASE("element_text.colour_change")
+{
+	TestsRenderInterface* render_interface = TestsShell::GetTestsRenderInterface();
+	// This test only works with the dummy renderer.
+	if (!render_interface)
+		return;
+
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	const auto& counters = render_interface->GetCounters();
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_text_rml);
+	document->Show();
+	TestsShell::RenderLoop();
+
+	Element* p = document->GetElementById("p");
+	REQUIRE(p->GetClientHeight() > 40.f);
+
+	// Colour changes are applied to the existing text meshes. Generating the text again should then give identical meshes, which are reused
+	// without compiling any new geometry.
+	auto ChangeColour = [&](const String& property, const String& value, bool glow) {
+		p->SetProperty(property, value);
+		p->SetClass("glow", glow);
+		size_t num_compiled = counters.compile_geometry;
+		TestsShell::RenderLoop();
+		CHECK(counters.compile_geometry > num_compiled);
+
+		Rml::ReleaseFontResources();
+		num_compiled = counters.compile_geometry;
+		TestsShell::RenderLoop();
+		CHECK(counters.compile_geometry == num_compiled);
+	};
+
+	ChangeColour("color", "#00f", false);
+	ChangeColour("color", "#0f08", false);
+	ChangeColour("opacity", "0.5", false);
+	ChangeColour("opacity", "0.25", true);
+	ChangeColour("color", "#ff0", true);
+
+	document->Close();
+	TestsShell::ShutdownShell();
+}
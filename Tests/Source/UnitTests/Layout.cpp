@@ -26,11 +26,13 @@
  *
  */
 
+#include "../../../Source/Core/TextWidthCache.h"
 #include "../Common/TestsShell.h"
 #include <RmlUi/Core/Context.h>
 #include <RmlUi/Core/Core.h>
 #include <RmlUi/Core/Element.h>
 #include <RmlUi/Core/ElementDocument.h>
+#include <RmlUi/Core/FontEngineInterface.h>
 #include <doctest.h>
 
 using namespace Rml;
@@ -138,3 +140,297 @@ TEST_CASE("Layout.Position.Relative")
 
 	TestsShell::ShutdownShell();
 }
+
+static const String document_layout_boundary_rml = R"(
+<rml>
+<head>
+	<link type="text/rcss" href="/assets/rml.rcss"/>
+	<style>
+		body {
+			width: 500px;
+			height: 300px;
+			font-family: LatoLatin;
+			font-size: 16px;
+		}
+		#list {
+			position: relative;
+			width: 200px;
+			height: 100px;
+			overflow: auto;
+		}
+		#scroller {
+			width: 200px;
+			height: 100px;
+			overflow: auto;
+		}
+		#absolute {
+			position: absolute;
+			top: 0;
+		}
+	</style>
+</head>
+
+<body>
+<div id="list"><p id="item">Item</p><p>Item</p></div>
+<div id="scroller"><p id="scroller_item">Item</p><div id="absolute">Absolute</div></div>
+<p id="after">After</p>
+</body>
+</rml>
+)";
+
+TEST_CASE("Layout.Boundary")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_layout_boundary_rml);
+	REQUIRE(document);
+	document->Show();
+	TestsShell::RenderLoop();
+
+	Element* list = document->GetElementById("list");
+	Element* scroller = document->GetElementById("scroller");
+	Element* after = document->GetElementById("after");
+	const float after_top = after->GetAbsoluteTop();
+	const float item_height = document->GetElementById("item")->GetBox().GetSize().y;
+
+	auto GetLayout = [](Element* element) {
+		Vector<Vector2f> layout;
+		for (int i = 0; i < element->GetNumChildren(); i++)
+		{
+			layout.push_back(element->GetChild(i)->GetRelativeOffset());
+			layout.push_back(element->GetChild(i)->GetBox().GetSize());
+		}
+		layout.push_back(Vector2f(element->GetScrollWidth(), element->GetScrollHeight()));
+		return layout;
+	};
+
+	SUBCASE("Contents")
+	{
+		// The list has a fixed size and catches its own overflow, thus changes to its contents are formatted on their own.
+		Element* item = document->GetElementById("item");
+		item->SetInnerRML("A much longer item which will wrap over several lines in the list");
+		list->AppendChild(document->CreateElement("p"))->SetInnerRML("New item");
+
+		context->Update();
+		CHECK(item->GetBox().GetSize().y > item_height);
+		CHECK(after->GetAbsoluteTop() == after_top);
+
+		// The result should be identical to formatting the whole document.
+		const Vector<Vector2f> list_layout = GetLayout(list);
+		document->SetProperty("width", "501px");
+		context->Update();
+		document->SetProperty("width", "500px");
+		context->Update();
+		CHECK(GetLayout(list) == list_layout);
+	}
+
+	SUBCASE("Escaping absolute")
+	{
+		// The absolutely positioned element is formatted relative to the body, thus the whole document must be formatted.
+		Element* item = document->GetElementById("scroller_item");
+		item->SetInnerRML("A much longer item which will wrap over several lines in the scroller");
+		document->GetElementById("absolute")->SetInnerRML("Changed absolute");
+		context->Update();
+		CHECK(item->GetBox().GetSize().y > item_height);
+
+		const Vector<Vector2f> scroller_layout = GetLayout(scroller);
+		document->SetProperty("width", "501px");
+		context->Update();
+		document->SetProperty("width", "500px");
+		context->Update();
+		CHECK(GetLayout(scroller) == scroller_layout);
+	}
+
+	SUBCASE("Size")
+	{
+		// Changes to the size of the boundary itself must be propagated to the rest of the document.
+		list->SetProperty("height", "150px");
+		context->Update();
+		CHECK(after->GetAbsoluteTop() == after_top + 50.f);
+	}
+
+	document->Close();
+	TestsShell::ShutdownShell();
+}
+
+static const String document_layout_cache_rml = R"(
+<rml>
+<head>
+	<link type="text/rcss" href="/assets/rml.rcss"/>
+	<style>
+		body {
+			width: 500px;
+			height: 300px;
+			font-family: LatoLatin;
+			font-size: 16px;
+		}
+		.row {
+			display: flex;
+			flex-direction: row;
+			align-items: flex-start;
+		}
+		.column {
+			display: flex;
+			flex-direction: column;
+			width: 200px;
+		}
+	</style>
+</head>
+
+<body>
+<div class="row">
+	<div id="row_item">Item</div>
+	<div class="column">
+		<div id="column_item"><span id="column_text">Item</span></div>
+		<div>Item</div>
+	</div>
+</div>
+</body>
+</rml>
+)";
+
+TEST_CASE("Layout.Cache")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_layout_cache_rml);
+	REQUIRE(document);
+	document->Show();
+	TestsShell::RenderLoop();
+
+	Element* row_item = document->GetElementById("row_item");
+	Element* column_item = document->GetElementById("column_item");
+	const Vector2f row_item_size = row_item->GetBox().GetSize();
+	const Vector2f column_item_size = column_item->GetBox().GetSize();
+
+	// Measured sizes are reused when formatting the document again without any changes.
+	document->SetProperty("height", "301px");
+	context->Update();
+	CHECK(row_item->GetBox().GetSize() == row_item_size);
+	CHECK(column_item->GetBox().GetSize() == column_item_size);
+
+	// Changes to the contents of flex items must invalidate their measured sizes.
+	row_item->SetInnerRML("A longer item");
+	document->GetElementById("column_text")->SetInnerRML("A much longer item which will wrap over several lines in the column");
+	context->Update();
+	CHECK(row_item->GetBox().GetSize().x > row_item_size.x);
+	CHECK(column_item->GetBox().GetSize().y > column_item_size.y);
+
+	// Same for property changes of their descendants.
+	document->GetElementById("column_text")->SetProperty("font-size", "32px");
+	const float column_item_height = column_item->GetBox().GetSize().y;
+	context->Update();
+	CHECK(column_item->GetBox().GetSize().y > column_item_height);
+
+	document->Close();
+	TestsShell::ShutdownShell();
+}
+
+static const String document_text_width_cache_rml = R"(
+<rml>
+<head>
+	<link type="text/rcss" href="/assets/rml.rcss"/>
+	<style>
+		body {
+			width: 500px;
+			height: 300px;
+			font-family: LatoLatin;
+			font-size: 16px;
+		}
+		#word { float: left; }
+		#paragraph { clear: both; width: 120px; }
+	</style>
+</head>
+
+<body>
+<div id="word">Measure</div>
+<p id="paragraph">The quick brown fox jumps over the lazy dog, and the lazy dog jumps over the quick brown fox.</p>
+</body>
+</rml>
+)";
+
+TEST_CASE("Layout.TextWidthCache")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_text_width_cache_rml);
+	REQUIRE(document);
+	document->Show();
+	TestsShell::RenderLoop();
+
+	Element* word = document->GetElementById("word");
+	Element* paragraph = document->GetElementById("paragraph");
+	const float word_width = word->GetBox().GetSize().x;
+	const float paragraph_height = paragraph->GetBox().GetSize().y;
+	REQUIRE(word_width > 0.f);
+
+	// Cached widths must not be reused for text with different letter spacing.
+	word->SetProperty("letter-spacing", "2px");
+	context->Update();
+	CHECK(word->GetBox().GetSize().x > word_width);
+
+	word->RemoveProperty("letter-spacing");
+	context->Update();
+	CHECK(word->GetBox().GetSize().x == word_width);
+
+	// Reformatting the paragraph at a different width and back again should reproduce the original line breaks.
+	paragraph->SetProperty("width", "400px");
+	context->Update();
+	CHECK(paragraph->GetBox().GetSize().y < paragraph_height);
+
+	paragraph->SetProperty("width", "120px");
+	context->Update();
+	CHECK(paragraph->GetBox().GetSize().y == paragraph_height);
+
+	// The cache must also be cleared when the font resources are released.
+	ReleaseFontResources();
+	context->Update();
+	CHECK(word->GetBox().GetSize().x == word_width);
+	CHECK(paragraph->GetBox().GetSize().y == paragraph_height);
+
+	document->Close();
+	TestsShell::ShutdownShell();
+}
+
+TEST_CASE("Layout.TextWidthCache.version")
+{
+	// A font engine which changes the metrics of its handles at runtime, announcing it through their version.
+	class VersionedFontEngine : public FontEngineInterface {
+	public:
+		int GetStringWidth(FontFaceHandle /*handle*/, StringView string, const TextShapingContext& /*text_shaping_context*/,
+			Character /*prior_character*/) override
+		{
+			num_measurements += 1;
+			return int(string.size()) * glyph_width;
+		}
+		int GetVersion(FontFaceHandle /*handle*/) override { return version; }
+
+		int glyph_width = 10;
+		int version = 1;
+		int num_measurements = 0;
+	};
+
+	TestsShell::GetContext();
+
+	VersionedFontEngine font_engine;
+	const FontFaceHandle handle = reinterpret_cast<FontFaceHandle>(&font_engine);
+	const String word = "word";
+	const String language;
+	const TextShapingContext text_shaping_context{language};
+
+	CHECK(TextWidthCache::GetStringWidth(&font_engine, handle, word, text_shaping_context, Character::Null) == 40);
+	CHECK(TextWidthCache::GetStringWidth(&font_engine, handle, word, text_shaping_context, Character::Null) == 40);
+	CHECK(font_engine.num_measurements == 1);
+
+	// Widths measured with a previous version of the handle must not be reused.
+	font_engine.glyph_width = 12;
+	font_engine.version += 1;
+	CHECK(TextWidthCache::GetStringWidth(&font_engine, handle, word, text_shaping_context, Character::Null) == 48);
+	CHECK(font_engine.num_measurements == 2);
+
+	TextWidthCache::Clear();
+	TestsShell::ShutdownShell();
+}
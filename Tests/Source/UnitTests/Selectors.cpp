@@ -72,7 +72,19 @@ static const String doc_end = R"(
 </rml>
 )";
 
-enum class SelectorOp { None, RemoveElementsByIds, InsertElementBefore, RemoveClasses, RemoveId, RemoveChecked, RemoveAttributeUnit, SetHover };
+enum class SelectorOp {
+	None,
+	RemoveElementsByIds,
+	InsertElementBefore,
+	RemoveClasses,
+	RemoveId,
+	RemoveChecked,
+	RemoveAttributeUnit,
+	SetHover,
+	AddClass,
+	SetId,
+	MoveElement,
+};
 
 struct QuerySelector {
 	QuerySelector(String selector, String expected_ids, int expect_num_warnings = 0, int expect_num_query_warnings = 0) :
@@ -222,6 +234,18 @@ static const Vector<QuerySelector> query_selectors =
 	{ "#E + * ~ *",                  "G H" },
 	{ "#B + * ~ #G",                 "G" },
 	{ "body > :nth-child(4) span:first-child",  "D0 F0", SelectorOp::RemoveElementsByIds,  "X",    "" },
+	{ ".hello span",                 "",                SelectorOp::AddClass,             "D hello", "D0 D1" },
+	{ "div.parent .hello > span",    "",                SelectorOp::AddClass,             "F hello", "F0" },
+	{ "#Q > span",                   "",                SelectorOp::SetId,                "D Q",     "D0 D1" },
+	{ "#D span.hello-world",         "",                SelectorOp::MoveElement,          "F0 D",    "F0" },
+	{ ".hello + #P .hello-world",    "F0",              SelectorOp::MoveElement,          "F0 Y",    "" },
+	{ ".active > p",                 "",                SelectorOp::AddClass,             "P active", "B C D F G H" },
+	{ ".active span",                "",                SelectorOp::AddClass,             "P active", "D0 D1 F0" },
+	{ ".active + p",                 "",                SelectorOp::AddClass,             "A active", "B" },
+	{ ".active ~ p > span",          "",                SelectorOp::AddClass,             "C active", "D0 D1 F0" },
+	{ ".active > #C + p span",       "",                SelectorOp::AddClass,             "P active", "D0 D1" },
+	{ "#D > :not(.active)",          "D0 D1",           SelectorOp::AddClass,             "D1 active", "D0" },
+	{ ":not(.active) > #D1",         "D1",              SelectorOp::AddClass,             "D active", "" },
 };
 
 struct ClosestSelector {
@@ -349,6 +373,26 @@ static void RemoveClassesFromAllElements(ElementDocument* document, const String
 			element->SetClass(name, false);
 	}
 }
+static void AddClassToElement(ElementDocument* document, const String& id_and_class)
+{
+	StringList arguments;
+	StringUtilities::ExpandString(arguments, id_and_class, ' ');
+	document->GetElementById(arguments[0])->SetClass(arguments[1], true);
+}
+static void SetElementId(ElementDocument* document, const String& id_and_new_id)
+{
+	StringList arguments;
+	StringUtilities::ExpandString(arguments, id_and_new_id, ' ');
+	document->GetElementById(arguments[0])->SetId(arguments[1]);
+}
+static void MoveElement(ElementDocument* document, const String& id_and_new_parent_id)
+{
+	StringList arguments;
+	StringUtilities::ExpandString(arguments, id_and_new_parent_id, ' ');
+	Element* element = document->GetElementById(arguments[0]);
+	ElementPtr element_ptr = element->GetParentNode()->RemoveChild(element);
+	document->GetElementById(arguments[1])->AppendChild(std::move(element_ptr));
+}
 static void InsertElementBefore(ElementDocument* document, const String& before_id)
 {
 	Element* element = document->GetElementById(before_id);
@@ -411,6 +455,18 @@ TEST_CASE("Selectors")
 					document->GetElementById(selector.operation_argument)->SetPseudoClass("hover", true);
 					operation_str = "SetHover";
 					break;
+				case SelectorOp::AddClass:
+					AddClassToElement(document, selector.operation_argument);
+					operation_str = "AddClass";
+					break;
+				case SelectorOp::SetId:
+					SetElementId(document, selector.operation_argument);
+					operation_str = "SetId";
+					break;
+				case SelectorOp::MoveElement:
+					MoveElement(document, selector.operation_argument);
+					operation_str = "MoveElement";
+					break;
 				case SelectorOp::None: break;
 				}
 				context->Update();